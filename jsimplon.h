@@ -37,21 +37,123 @@ typedef enum {
 	JSIMPLON_VALUE_ARRAY,
 	JSIMPLON_VALUE_STRING,
 	JSIMPLON_VALUE_NUMBER,
+	JSIMPLON_VALUE_INTEGER, // Literals without a fraction or an exponent that fit in int64_t or uint64_t
 	JSIMPLON_VALUE_BOOL,
 	JSIMPLON_VALUE_NULL
 } Jsimplon_ValueType;
 
+typedef enum {
+	JSIMPLON_ENGINE_TOKENS,    // One token at a time
+	JSIMPLON_ENGINE_STRUCTURAL // A vectorised pass indexes every structural character, then the tree is built by walking the index
+} Jsimplon_Engine;
+
+#ifndef JSIMPLON_DEFAULT_MAX_DEPTH
+#define JSIMPLON_DEFAULT_MAX_DEPTH 1024
+#endif // JSIMPLON_DEFAULT_MAX_DEPTH
+
+// Passing NULL wherever options are taken is the same as passing { 0 }
+typedef struct {
+	// Every string, key and container of the document comes out of one arena, nothing is freed
+	// on its own and jsimplon_tree_destroy releases the whole document in a handful of frees
+	bool use_arena;
+	Jsimplon_Engine engine;
+
+	// Input nested deeper than this is an error, 0 means JSIMPLON_DEFAULT_MAX_DEPTH. Parsing never recurses
+	// but destroying and serialising a heap tree still do, so keep it within what the stack can take
+	uint32_t max_depth;
+
+	// Workers for jsimplon_ndjson_parse and split_root_array, 0 means one per online CPU
+	uint32_t thread_count;
+
+	// A root array is cut between its elements and the pieces are parsed side by side on thread_count workers, for
+	// documents that are one huge array. Anything else is parsed as usual, so is a document with an error in it so that
+	// the error is reported where it is, which is also why in-place parsing never splits. Elements use the token engine
+	bool split_root_array;
+
+	// Only the root's own members or elements are parsed up front, containers in it are skipped over and parsed a level
+	// at a time the first time they're looked into, so src has to outlive the tree. An error in a container only comes
+	// up once it's parsed, getters then fail on it. Nesting past max_depth is the exception, skipping over a container
+	// measures it so the parse fails as it would eagerly. The token engine is used and streams are never lazy. Looking
+	// into a container writes to it, so threads can't share a lazy tree unlocked
+	bool lazy;
+
+	// Keys and strings of up to JSIMPLON_INTERN_MAX_LENGTH bytes are stored once per document and shared by everything
+	// that has them, for records that all repeat the same keys and a handful of values. The setters and builders of
+	// the tree intern as well. In-place parsing doesn't copy strings to begin with, so it never interns
+	bool intern_strings;
+
+	// String literals that aren't well-formed UTF-8 are an error, and so is a \u escape for half a surrogate pair that
+	// would otherwise become U+FFFD. Nothing else in JSON can hold a byte above 0x7F, so this covers the whole input.
+	// Runs of ASCII are skipped over a block at a time
+	bool validate_utf8;
+} Jsimplon_Options;
+
 /* API Functions */
 
 // error is opt-out so you can pass in NULL if you don't care about the message
 // it also needs to be freed
 JSIMPLON_DEF Jsimplon_Value *jsimplon_tree_root_create(void);
+JSIMPLON_DEF Jsimplon_Value *jsimplon_tree_root_create_ex(const Jsimplon_Options *options);
 JSIMPLON_DEF Jsimplon_Value *jsimplon_tree_from_str(char **error, const char *src);
+JSIMPLON_DEF Jsimplon_Value *jsimplon_tree_from_str_ex(char **error, const char *src, size_t src_len, const Jsimplon_Options *options);
 JSIMPLON_DEF Jsimplon_Value *jsimplon_tree_from_file(char **error, const char *file_name);
+// Files are mapped rather than read where the platform allows it. A lazy tree keeps its file until it's destroyed
+JSIMPLON_DEF Jsimplon_Value *jsimplon_tree_from_file_ex(char **error, const char *file_name, const Jsimplon_Options *options);
+// Parses a private copy-on-write mapping of the file in place, so only the pages strings get unescaped and
+// NUL-terminated in are copied and the file itself is left alone. The tree keeps the mapping until it's destroyed
+JSIMPLON_DEF Jsimplon_Value *jsimplon_tree_from_file_insitu_ex(char **error, const char *file_name, const Jsimplon_Options *options);
+// Parses buf in place: strings are unescaped and NUL-terminated inside buf and the tree borrows them,
+// so buf is left modified and has to outlive the tree. buf does not need to be NUL-terminated. The few strings
+// with a \u0000 in them are copied out, the NUL would cut them short
+JSIMPLON_DEF Jsimplon_Value *jsimplon_tree_from_buffer_insitu(char **error, char *buf, size_t len);
+JSIMPLON_DEF Jsimplon_Value *jsimplon_tree_from_buffer_insitu_ex(char **error, char *buf, size_t len, const Jsimplon_Options *options);
 JSIMPLON_DEF char *          jsimplon_tree_to_str(char **error, const Jsimplon_Value *root_value);
 JSIMPLON_DEF int             jsimplon_tree_to_file(char **error, const Jsimplon_Value *root_value, const char *file_name);
 JSIMPLON_DEF int             jsimplon_tree_destroy(Jsimplon_Value *root_value);
 
+typedef struct jsimplon_stream_parser Jsimplon_StreamParser;
+
+// Parses a document handed over in chunks of any size as they arrive, tokens split between chunks are picked up
+// where they were left. Once feed fails the stream stays failed, finish returns the tree and destroys the stream
+// either way and destroy is only for giving up on a stream early. Streams always use the token engine
+JSIMPLON_DEF Jsimplon_StreamParser *jsimplon_stream_parser_create(const Jsimplon_Options *options);
+JSIMPLON_DEF int                    jsimplon_stream_parser_feed(char **error, Jsimplon_StreamParser *stream, const char *chunk, size_t chunk_len);
+JSIMPLON_DEF Jsimplon_Value *       jsimplon_stream_parser_finish(char **error, Jsimplon_StreamParser *stream);
+JSIMPLON_DEF void                   jsimplon_stream_parser_destroy(Jsimplon_StreamParser *stream);
+
+// Events for jsimplon_sax_parse, a NULL callback skips its event. Keys and strings are the bytes between the quotes
+// with their escapes left as they are (jsimplon_string_from_slice decodes them) and numbers are the literal as written,
+// none of them are NUL-terminated. Returning anything but JSIMPLON_SUCCESS stops the parse and jsimplon_sax_parse
+// returns it as it is
+typedef struct {
+	int (*object_begin)(void *context);
+	int (*object_end)(void *context);
+	int (*array_begin)(void *context);
+	int (*array_end)(void *context);
+	int (*key)(void *context, const char *key, size_t length);
+	int (*string)(void *context, const char *str, size_t length);
+	int (*number)(void *context, const char *literal, size_t length);
+	int (*bool_value)(void *context, bool bool_value);
+	int (*null_value)(void *context);
+} Jsimplon_SaxHandler;
+
+// Reports src to handler as it goes without building a tree or copying anything, memory doesn't grow with src
+JSIMPLON_DEF int    jsimplon_sax_parse(char **error, const char *src, size_t src_len, const Jsimplon_SaxHandler *handler, void *context, const Jsimplon_Options *options);
+JSIMPLON_DEF double jsimplon_number_from_slice(const char *literal, size_t length); // For the number event, returns infinity if failed
+// For the key and string events, decodes the escapes in str into out and NUL-terminates it. Decoding never makes a
+// string longer so out needs length + 1 bytes and can be str itself, out_len gets the decoded length if it isn't NULL
+JSIMPLON_DEF int    jsimplon_string_from_slice(const char *str, size_t length, char *out, size_t *out_len);
+
+// Gets every record of an NDJSON document, in order. A record can be any JSON value, scalars included, where a whole
+// document has to be an object or an array. tree belongs to the callback from then on and is NULL if the
+// record failed to parse, error then says why and is freed once the callback returns. Locations in error are within
+// the record, line is where the record is in src. Returning anything but JSIMPLON_SUCCESS stops the parse and
+// jsimplon_ndjson_parse returns it as it is, otherwise it fails if any record did
+typedef int (*Jsimplon_NdjsonCallback)(void *context, size_t line, Jsimplon_Value *tree, const char *error);
+
+// Records are parsed in parallel on options->thread_count workers while the calling thread hands them out in order
+JSIMPLON_DEF int jsimplon_ndjson_parse(char **error, const char *src, size_t src_len, Jsimplon_NdjsonCallback callback, void *context, const Jsimplon_Options *options);
+
 #ifndef JSIMPLON_SUCCESS
 #define JSIMPLON_SUCCESS 0
 #endif // JSIMPLON_SUCCESS
@@ -62,8 +164,13 @@ JSIMPLON_DEF int             jsimplon_tree_destroy(Jsimplon_Value *root_value);
 
 /* Setters */
 
+// Strings and keys carry their length and may have NULs in them, the _len functions take and give it. They're still
+// NUL-terminated, so everything else sees them up to their first NUL
 JSIMPLON_DEF int              jsimplon_value_set_str(Jsimplon_Value *value, const char *str);
+JSIMPLON_DEF int              jsimplon_value_set_str_len(Jsimplon_Value *value, const char *str, size_t length);
 JSIMPLON_DEF int              jsimplon_value_set_number(Jsimplon_Value *value, double number);
+JSIMPLON_DEF int              jsimplon_value_set_int64(Jsimplon_Value *value, int64_t integer);
+JSIMPLON_DEF int              jsimplon_value_set_uint64(Jsimplon_Value *value, uint64_t integer);
 JSIMPLON_DEF int              jsimplon_value_set_bool(Jsimplon_Value *value, bool bool_value);
 JSIMPLON_DEF int              jsimplon_value_set_null(Jsimplon_Value *value);
 JSIMPLON_DEF Jsimplon_Object *jsimplon_value_set_object(Jsimplon_Value *value);
@@ -71,18 +178,24 @@ JSIMPLON_DEF Jsimplon_Array * jsimplon_value_set_array(Jsimplon_Value *value);
 
 JSIMPLON_DEF Jsimplon_Member *jsimplon_object_add_member(Jsimplon_Object *object);
 JSIMPLON_DEF Jsimplon_Value * jsimplon_object_add_member_value(Jsimplon_Object *object, const char *key);
+JSIMPLON_DEF Jsimplon_Value * jsimplon_object_add_member_value_len(Jsimplon_Object *object, const char *key, size_t key_length);
 JSIMPLON_DEF int              jsimplon_object_add_member_str(Jsimplon_Object *object, const char *key, const char *str);
 JSIMPLON_DEF int              jsimplon_object_add_member_number(Jsimplon_Object *object, const char *key, double number);
+JSIMPLON_DEF int              jsimplon_object_add_member_int64(Jsimplon_Object *object, const char *key, int64_t integer);
 JSIMPLON_DEF int              jsimplon_object_add_member_bool(Jsimplon_Object *object, const char *key, bool bool_value);
 JSIMPLON_DEF int              jsimplon_object_add_member_null(Jsimplon_Object *object, const char *key);
 JSIMPLON_DEF Jsimplon_Object *jsimplon_object_add_member_object(Jsimplon_Object *object, const char *key);
 JSIMPLON_DEF Jsimplon_Array * jsimplon_object_add_member_array(Jsimplon_Object *object, const char *key);
 JSIMPLON_DEF int              jsimplon_object_remove_member(Jsimplon_Object *object, const char *key);
+JSIMPLON_DEF int              jsimplon_object_reserve(Jsimplon_Object *object, size_t members_size); // Room for at least that many members
+JSIMPLON_DEF int              jsimplon_object_shrink_to_fit(Jsimplon_Object *object); // Does nothing in arena documents
 
 JSIMPLON_DEF int              jsimplon_member_set_key(Jsimplon_Member *member, const char *new_key);
+JSIMPLON_DEF int              jsimplon_member_set_key_len(Jsimplon_Member *member, const char *new_key, size_t length); // Keys are at most UINT32_MAX long
 JSIMPLON_DEF Jsimplon_Value * jsimplon_member_set_value(Jsimplon_Member *member); // Kind of useless
 JSIMPLON_DEF int              jsimplon_member_set_str(Jsimplon_Member *member, const char *str);
 JSIMPLON_DEF int              jsimplon_member_set_number(Jsimplon_Member *member, double number);
+JSIMPLON_DEF int              jsimplon_member_set_int64(Jsimplon_Member *member, int64_t integer);
 JSIMPLON_DEF int              jsimplon_member_set_bool(Jsimplon_Member *member, bool bool_value);
 JSIMPLON_DEF int              jsimplon_member_set_null(Jsimplon_Member *member);
 JSIMPLON_DEF Jsimplon_Object *jsimplon_member_set_object(Jsimplon_Member *member);
@@ -91,12 +204,15 @@ JSIMPLON_DEF Jsimplon_Array * jsimplon_member_set_array(Jsimplon_Member *member)
 JSIMPLON_DEF Jsimplon_Value * jsimplon_array_push_value(Jsimplon_Array *array);
 JSIMPLON_DEF int              jsimplon_array_push_str(Jsimplon_Array *array, const char *str);
 JSIMPLON_DEF int              jsimplon_array_push_number(Jsimplon_Array *array, double number);
+JSIMPLON_DEF int              jsimplon_array_push_int64(Jsimplon_Array *array, int64_t integer);
 JSIMPLON_DEF int              jsimplon_array_push_bool(Jsimplon_Array *array, bool bool_value);
 JSIMPLON_DEF int              jsimplon_array_push_null(Jsimplon_Array *array);
 JSIMPLON_DEF Jsimplon_Object *jsimplon_array_push_object(Jsimplon_Array *array);
 JSIMPLON_DEF Jsimplon_Array * jsimplon_array_push_array(Jsimplon_Array *array);
 JSIMPLON_DEF Jsimplon_Value * jsimplon_array_insert_value_at_index(Jsimplon_Array *array, size_t index);
 JSIMPLON_DEF int              jsimplon_array_remove_value_at_index(Jsimplon_Array *array, size_t index);
+JSIMPLON_DEF int              jsimplon_array_reserve(Jsimplon_Array *array, size_t values_size); // Room for at least that many values
+JSIMPLON_DEF int              jsimplon_array_shrink_to_fit(Jsimplon_Array *array); // Does nothing in arena documents
 
 /* Getters */
 
@@ -106,25 +222,32 @@ JSIMPLON_DEF int              jsimplon_array_remove_value_at_index(Jsimplon_Arra
 JSIMPLON_DEF Jsimplon_ValueType jsimplon_value_get_type(Jsimplon_Value *value);
 JSIMPLON_DEF Jsimplon_Object *  jsimplon_value_get_object(Jsimplon_Value *value);
 JSIMPLON_DEF Jsimplon_Array *   jsimplon_value_get_array(Jsimplon_Value *value);
-JSIMPLON_DEF const char *       jsimplon_value_get_str(Jsimplon_Value *value);
-JSIMPLON_DEF double             jsimplon_value_get_number(Jsimplon_Value *value); // returns infinity if failed
+JSIMPLON_DEF const char *       jsimplon_value_get_str(Jsimplon_Value *value); // short strings are stored in their value, the pointer only lasts as long as it stays put
+JSIMPLON_DEF size_t             jsimplon_value_get_str_len(Jsimplon_Value *value); // returns 0 if failed
+JSIMPLON_DEF double             jsimplon_value_get_number(Jsimplon_Value *value); // returns infinity if failed, integers are converted
+JSIMPLON_DEF int64_t            jsimplon_value_get_int64(Jsimplon_Value *value); // returns INT64_MIN if failed, whole numbers in range are converted
+JSIMPLON_DEF uint64_t           jsimplon_value_get_uint64(Jsimplon_Value *value); // returns UINT64_MAX if failed, whole numbers in range are converted
 JSIMPLON_DEF int                jsimplon_value_get_bool(Jsimplon_Value *value); // returns -1 if failed
 
 JSIMPLON_DEF Jsimplon_Member *  jsimplon_object_get_member(Jsimplon_Object *object, const char *key);
+JSIMPLON_DEF Jsimplon_Member *  jsimplon_object_get_member_len(Jsimplon_Object *object, const char *key, size_t key_length);
 JSIMPLON_DEF size_t             jsimplon_object_get_member_count(Jsimplon_Object *object);
 JSIMPLON_DEF Jsimplon_Member *  jsimplon_object_get_member_at_index(Jsimplon_Object *object, size_t index);
 JSIMPLON_DEF Jsimplon_ValueType jsimplon_object_member_get_type(Jsimplon_Object *object, const char *key);
 JSIMPLON_DEF Jsimplon_Value *   jsimplon_object_member_get_value(Jsimplon_Object *object, const char *key);
 JSIMPLON_DEF const char *       jsimplon_object_member_get_str(Jsimplon_Object *object, const char *key);
 JSIMPLON_DEF double             jsimplon_object_member_get_number(Jsimplon_Object *object, const char *key); // returns infinity if failed
+JSIMPLON_DEF int64_t            jsimplon_object_member_get_int64(Jsimplon_Object *object, const char *key); // returns INT64_MIN if failed
 JSIMPLON_DEF int                jsimplon_object_member_get_bool(Jsimplon_Object *object, const char *key); // returns -1 if failed
 JSIMPLON_DEF Jsimplon_Object *  jsimplon_object_member_get_object(Jsimplon_Object *object, const char *key);
 JSIMPLON_DEF Jsimplon_Array *   jsimplon_object_member_get_array(Jsimplon_Object *object, const char *key);
 
-JSIMPLON_DEF const char *       jsimplon_member_get_key(Jsimplon_Member *member);
+JSIMPLON_DEF const char *       jsimplon_member_get_key(Jsimplon_Member *member); // same as jsimplon_value_get_str
+JSIMPLON_DEF size_t             jsimplon_member_get_key_len(Jsimplon_Member *member); // returns 0 if failed
 JSIMPLON_DEF Jsimplon_Value *   jsimplon_member_get_value(Jsimplon_Member *member);
 JSIMPLON_DEF const char *       jsimplon_member_get_str(Jsimplon_Member *member);
 JSIMPLON_DEF double             jsimplon_member_get_number(Jsimplon_Member *member); // returns infinity if failed
+JSIMPLON_DEF int64_t            jsimplon_member_get_int64(Jsimplon_Member *member); // returns INT64_MIN if failed
 JSIMPLON_DEF int                jsimplon_member_get_bool(Jsimplon_Member *member); // returns -1 if failed
 JSIMPLON_DEF Jsimplon_Object *  jsimplon_member_get_object(Jsimplon_Member *member);
 JSIMPLON_DEF Jsimplon_Array *   jsimplon_member_get_array(Jsimplon_Member *member);
@@ -132,21 +255,54 @@ JSIMPLON_DEF Jsimplon_Array *   jsimplon_member_get_array(Jsimplon_Member *membe
 JSIMPLON_DEF size_t             jsimplon_array_get_count(Jsimplon_Array *array);
 JSIMPLON_DEF Jsimplon_Value *   jsimplon_array_get_value_at_index(Jsimplon_Array *array, size_t index);
 
+/* Paths */
+
+typedef struct jsimplon_path Jsimplon_Path;
+
+// JSON Pointers (RFC 6901) like "/meta/region/0/id", compiled once and then resolved against any number of trees.
+// A reference token picks an element in an array if it's an index and a member in an object, "" is the root itself
+// and "-" never resolves. Compiled paths are never written to, so threads can share them
+JSIMPLON_DEF Jsimplon_Path * jsimplon_path_compile(char **error, const char *pointer);
+JSIMPLON_DEF Jsimplon_Value *jsimplon_path_get(Jsimplon_Value *root, const Jsimplon_Path *path); // NULL if nothing is there
+// Resolves all of paths against root in one walk, each prefix they share is only looked up once. values[i] is what
+// paths[i] resolved to or NULL, returns how many did resolve
+JSIMPLON_DEF size_t          jsimplon_path_get_many(Jsimplon_Value *root, const Jsimplon_Path *const *paths, size_t paths_count, Jsimplon_Value **values);
+JSIMPLON_DEF void            jsimplon_path_destroy(Jsimplon_Path *path);
+
 #ifdef JSIMPLON_IMPLEMENTATION
 
 #include <errno.h>
-#include <ctype.h>
+#include <float.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
 #include <string.h>
 
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Without C11 threads NDJSON records are parsed on the calling thread, define JSIMPLON_NO_THREADS to ask for that
+#if !defined(JSIMPLON_NO_THREADS) && !defined(__STDC_NO_THREADS__)
+#define JSIMPLON_THREADS
+#include <threads.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#define JSIMPLON_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #define JSIMPLON_DEF_INTERNAL static
 
 typedef enum {
 	JSIMPLON_TOKEN_END,
 	JSIMPLON_TOKEN_STRING_LITERAL,
 	JSIMPLON_TOKEN_NUMBER_LITERAL,
+	JSIMPLON_TOKEN_INTEGER_LITERAL,
 	JSIMPLON_TOKEN_TRUE,
 	JSIMPLON_TOKEN_FALSE,
 	JSIMPLON_TOKEN_NULL,
@@ -160,16 +316,172 @@ typedef enum {
 
 typedef struct {
 	char *value; // NULL for things like { } , : and so on
+	size_t length; // Of value, slicing lexers don't NUL-terminate it
+
+	// Number and integer literals are decoded by the lexer
+	union {
+		double number;
+		int64_t integer;
+		uint64_t unsigned_integer; // Only when is_unsigned
+	};
+
 	Jsimplon_TokenType type;
 	uint32_t line, column;
+	bool is_unsigned; // The integer is above INT64_MAX
+	bool is_interned; // value belongs to the document's intern table
+	bool is_short; // value is the lexer's short_str, it has to be copied out before the next token
+	bool is_copied; // value was parsed in place but decodes to a NUL, so it's a Jsimplon_String of its own instead
 } Jsimplon_Token;
 
-#define JSIMPLON_STRING_LITERAL_MAX_LENGTH ((1 << 15) - 1)
-#define JSIMPLON_NUMBER_LITERAL_MAX_LENGTH 21
+// Character classes drive the lexer, the order matters:
+// everything from JSIMPLON_CHAR_MINUS on can be part of a number and everything from JSIMPLON_CHAR_ZERO on part of a word
+typedef enum {
+	JSIMPLON_CHAR_OTHER,
+	JSIMPLON_CHAR_WHITESPACE,
+	JSIMPLON_CHAR_STRUCTURAL,
+	JSIMPLON_CHAR_QUOTE,
+	JSIMPLON_CHAR_MINUS,
+	JSIMPLON_CHAR_PLUS,
+	JSIMPLON_CHAR_DOT,
+	JSIMPLON_CHAR_ZERO,
+	JSIMPLON_CHAR_DIGIT,
+	JSIMPLON_CHAR_EXPONENT,
+	JSIMPLON_CHAR_LETTER,
+	JSIMPLON_CHAR_CLASS_COUNT
+} Jsimplon_CharClass;
+
+static const uint8_t jsimplon_char_classes[256] = {
+	[' '] = JSIMPLON_CHAR_WHITESPACE, ['\t'] = JSIMPLON_CHAR_WHITESPACE, ['\n'] = JSIMPLON_CHAR_WHITESPACE, ['\r'] = JSIMPLON_CHAR_WHITESPACE,
+
+	['{'] = JSIMPLON_CHAR_STRUCTURAL, ['}'] = JSIMPLON_CHAR_STRUCTURAL, ['['] = JSIMPLON_CHAR_STRUCTURAL,
+	[']'] = JSIMPLON_CHAR_STRUCTURAL, [':'] = JSIMPLON_CHAR_STRUCTURAL, [','] = JSIMPLON_CHAR_STRUCTURAL,
+
+	['\"'] = JSIMPLON_CHAR_QUOTE,
+	['-'] = JSIMPLON_CHAR_MINUS, ['+'] = JSIMPLON_CHAR_PLUS, ['.'] = JSIMPLON_CHAR_DOT,
+	['e'] = JSIMPLON_CHAR_EXPONENT, ['E'] = JSIMPLON_CHAR_EXPONENT,
+
+	['0'] = JSIMPLON_CHAR_ZERO,
+	['1'] = JSIMPLON_CHAR_DIGIT, ['2'] = JSIMPLON_CHAR_DIGIT, ['3'] = JSIMPLON_CHAR_DIGIT,
+	['4'] = JSIMPLON_CHAR_DIGIT, ['5'] = JSIMPLON_CHAR_DIGIT, ['6'] = JSIMPLON_CHAR_DIGIT,
+	['7'] = JSIMPLON_CHAR_DIGIT, ['8'] = JSIMPLON_CHAR_DIGIT, ['9'] = JSIMPLON_CHAR_DIGIT,
+
+	['a'] = JSIMPLON_CHAR_LETTER, ['b'] = JSIMPLON_CHAR_LETTER, ['c'] = JSIMPLON_CHAR_LETTER, ['d'] = JSIMPLON_CHAR_LETTER,
+	['f'] = JSIMPLON_CHAR_LETTER, ['g'] = JSIMPLON_CHAR_LETTER, ['h'] = JSIMPLON_CHAR_LETTER, ['i'] = JSIMPLON_CHAR_LETTER,
+	['j'] = JSIMPLON_CHAR_LETTER, ['k'] = JSIMPLON_CHAR_LETTER, ['l'] = JSIMPLON_CHAR_LETTER, ['m'] = JSIMPLON_CHAR_LETTER,
+	['n'] = JSIMPLON_CHAR_LETTER, ['o'] = JSIMPLON_CHAR_LETTER, ['p'] = JSIMPLON_CHAR_LETTER, ['q'] = JSIMPLON_CHAR_LETTER,
+	['r'] = JSIMPLON_CHAR_LETTER, ['s'] = JSIMPLON_CHAR_LETTER, ['t'] = JSIMPLON_CHAR_LETTER, ['u'] = JSIMPLON_CHAR_LETTER,
+	['v'] = JSIMPLON_CHAR_LETTER, ['w'] = JSIMPLON_CHAR_LETTER, ['x'] = JSIMPLON_CHAR_LETTER, ['y'] = JSIMPLON_CHAR_LETTER,
+	['z'] = JSIMPLON_CHAR_LETTER,
+	['A'] = JSIMPLON_CHAR_LETTER, ['B'] = JSIMPLON_CHAR_LETTER, ['C'] = JSIMPLON_CHAR_LETTER, ['D'] = JSIMPLON_CHAR_LETTER,
+	['F'] = JSIMPLON_CHAR_LETTER, ['G'] = JSIMPLON_CHAR_LETTER, ['H'] = JSIMPLON_CHAR_LETTER, ['I'] = JSIMPLON_CHAR_LETTER,
+	['J'] = JSIMPLON_CHAR_LETTER, ['K'] = JSIMPLON_CHAR_LETTER, ['L'] = JSIMPLON_CHAR_LETTER, ['M'] = JSIMPLON_CHAR_LETTER,
+	['N'] = JSIMPLON_CHAR_LETTER, ['O'] = JSIMPLON_CHAR_LETTER, ['P'] = JSIMPLON_CHAR_LETTER, ['Q'] = JSIMPLON_CHAR_LETTER,
+	['R'] = JSIMPLON_CHAR_LETTER, ['S'] = JSIMPLON_CHAR_LETTER, ['T'] = JSIMPLON_CHAR_LETTER, ['U'] = JSIMPLON_CHAR_LETTER,
+	['V'] = JSIMPLON_CHAR_LETTER, ['W'] = JSIMPLON_CHAR_LETTER, ['X'] = JSIMPLON_CHAR_LETTER, ['Y'] = JSIMPLON_CHAR_LETTER,
+	['Z'] = JSIMPLON_CHAR_LETTER
+};
+
+// RFC 8259 number grammar: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+typedef enum {
+	JSIMPLON_NUMBER_START,
+	JSIMPLON_NUMBER_MINUS,
+	JSIMPLON_NUMBER_ZERO,
+	JSIMPLON_NUMBER_INTEGER,
+	JSIMPLON_NUMBER_DOT,
+	JSIMPLON_NUMBER_FRACTION,
+	JSIMPLON_NUMBER_EXPONENT,
+	JSIMPLON_NUMBER_EXPONENT_SIGN,
+	JSIMPLON_NUMBER_EXPONENT_DIGITS,
+	JSIMPLON_NUMBER_DONE,
+	JSIMPLON_NUMBER_ERROR
+} Jsimplon_NumberState;
+
+#define JSIMPLON_N_S  JSIMPLON_NUMBER_START
+#define JSIMPLON_N_M  JSIMPLON_NUMBER_MINUS
+#define JSIMPLON_N_Z  JSIMPLON_NUMBER_ZERO
+#define JSIMPLON_N_I  JSIMPLON_NUMBER_INTEGER
+#define JSIMPLON_N_D  JSIMPLON_NUMBER_DOT
+#define JSIMPLON_N_F  JSIMPLON_NUMBER_FRACTION
+#define JSIMPLON_N_E  JSIMPLON_NUMBER_EXPONENT
+#define JSIMPLON_N_ES JSIMPLON_NUMBER_EXPONENT_SIGN
+#define JSIMPLON_N_ED JSIMPLON_NUMBER_EXPONENT_DIGITS
+#define JSIMPLON_N_OK JSIMPLON_NUMBER_DONE
+#define JSIMPLON_N_XX JSIMPLON_NUMBER_ERROR
+
+static const uint8_t jsimplon_number_transitions[JSIMPLON_NUMBER_DONE][JSIMPLON_CHAR_CLASS_COUNT] = {
+	//                                 other          space          structural     quote          -              +              .              0              1-9            e E            letter
+	[JSIMPLON_NUMBER_START]           = { JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_M,  JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_Z,  JSIMPLON_N_I,  JSIMPLON_N_XX, JSIMPLON_N_XX },
+	[JSIMPLON_NUMBER_MINUS]           = { JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_Z,  JSIMPLON_N_I,  JSIMPLON_N_XX, JSIMPLON_N_XX },
+	[JSIMPLON_NUMBER_ZERO]            = { JSIMPLON_N_OK, JSIMPLON_N_OK, JSIMPLON_N_OK, JSIMPLON_N_OK, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_D,  JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_E,  JSIMPLON_N_OK },
+	[JSIMPLON_NUMBER_INTEGER]         = { JSIMPLON_N_OK, JSIMPLON_N_OK, JSIMPLON_N_OK, JSIMPLON_N_OK, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_D,  JSIMPLON_N_I,  JSIMPLON_N_I,  JSIMPLON_N_E,  JSIMPLON_N_OK },
+	[JSIMPLON_NUMBER_DOT]             = { JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_F,  JSIMPLON_N_F,  JSIMPLON_N_XX, JSIMPLON_N_XX },
+	[JSIMPLON_NUMBER_FRACTION]        = { JSIMPLON_N_OK, JSIMPLON_N_OK, JSIMPLON_N_OK, JSIMPLON_N_OK, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_F,  JSIMPLON_N_F,  JSIMPLON_N_E,  JSIMPLON_N_OK },
+	[JSIMPLON_NUMBER_EXPONENT]        = { JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_ES, JSIMPLON_N_ES, JSIMPLON_N_XX, JSIMPLON_N_ED, JSIMPLON_N_ED, JSIMPLON_N_XX, JSIMPLON_N_XX },
+	[JSIMPLON_NUMBER_EXPONENT_SIGN]   = { JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_ED, JSIMPLON_N_ED, JSIMPLON_N_XX, JSIMPLON_N_XX },
+	[JSIMPLON_NUMBER_EXPONENT_DIGITS] = { JSIMPLON_N_OK, JSIMPLON_N_OK, JSIMPLON_N_OK, JSIMPLON_N_OK, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_XX, JSIMPLON_N_ED, JSIMPLON_N_ED, JSIMPLON_N_XX, JSIMPLON_N_OK }
+};
+
+#undef JSIMPLON_N_S
+#undef JSIMPLON_N_M
+#undef JSIMPLON_N_Z
+#undef JSIMPLON_N_I
+#undef JSIMPLON_N_D
+#undef JSIMPLON_N_F
+#undef JSIMPLON_N_E
+#undef JSIMPLON_N_ES
+#undef JSIMPLON_N_ED
+#undef JSIMPLON_N_OK
+#undef JSIMPLON_N_XX
+
+// What the DFA wanted to see when it ended up in JSIMPLON_NUMBER_ERROR
+static const char *const jsimplon_number_expectations[JSIMPLON_NUMBER_DONE] = {
+	[JSIMPLON_NUMBER_START]           = "expected a digit or '-'",
+	[JSIMPLON_NUMBER_MINUS]           = "expected a digit after '-'",
+	[JSIMPLON_NUMBER_ZERO]            = "expected '.', 'e' or the end of the number after a leading zero",
+	[JSIMPLON_NUMBER_INTEGER]         = "expected a digit, '.', 'e' or the end of the number",
+	[JSIMPLON_NUMBER_DOT]             = "expected a digit after '.'",
+	[JSIMPLON_NUMBER_FRACTION]        = "expected a digit, 'e' or the end of the number",
+	[JSIMPLON_NUMBER_EXPONENT]        = "expected a digit, '+' or '-' in the exponent",
+	[JSIMPLON_NUMBER_EXPONENT_SIGN]   = "expected a digit in the exponent",
+	[JSIMPLON_NUMBER_EXPONENT_DIGITS] = "expected a digit or the end of the number"
+};
+
+// Every decimal digit the slow path of the number decoder can need for an exact answer, and then some
+#define JSIMPLON_DECIMAL_MAX_DIGITS 800
+
+// Arbitrary precision decimal, digits[0] is the most significant digit and the value is 0.digits * 10^decimal_point
+typedef struct {
+	uint8_t digits[JSIMPLON_DECIMAL_MAX_DIGITS];
+	uint32_t count;
+	int32_t decimal_point;
+	bool truncated; // Non zero digits were dropped past JSIMPLON_DECIMAL_MAX_DIGITS
+} Jsimplon_Decimal;
+
+// Longest output of jsimplon_number_format, like -2.2250738585072014e-308 or -0.0000012345678901234567
+#define JSIMPLON_NUMBER_FORMAT_MAX_LENGTH 32
+
+// Unpacked floating point number, f * 2^e
+typedef struct {
+	uint64_t f;
+	int32_t e;
+} Jsimplon_DiyFp;
+
+typedef struct jsimplon_document Jsimplon_Document;
+
+// Strings shorter than these are stored inline, in what a value or member already has room for. The last byte is how
+// much room is left, so for the longest ones it's also their NUL
+#define JSIMPLON_INLINE_STR_SIZE 8
+#define JSIMPLON_INLINE_KEY_SIZE 12
 
 typedef struct {
 	const char *src;
-	char *lexeme;
+	size_t src_len;
+	char *insitu_src; // src itself when parsing in place, NULL otherwise
+	bool is_slicing; // Strings and numbers are left undecoded in src and their tokens point at them
+	bool validate_utf8;
+	Jsimplon_Document *document;  // The document values are made for
+	Jsimplon_Document *allocator; // Where their memory comes from, the same document unless a worker is filling in part of it
+	char short_str[JSIMPLON_INLINE_STR_SIZE]; // Short literals are unescaped here rather than allocated
 	size_t index;
 	size_t begin_of_line;
 	uint32_t line;
@@ -179,65 +491,429 @@ typedef struct {
 	uint32_t error_count;
 } Jsimplon_Lexer;
 
+typedef enum {
+	JSIMPLON_EXPECT_ROOT,    // '{' or '[', or any value if the parser allows scalar roots
+	JSIMPLON_EXPECT_VALUE,
+	JSIMPLON_EXPECT_ELEMENT, // A value or, in an empty array, ']'
+	JSIMPLON_EXPECT_KEY,     // A string literal or, in an empty object, '}'
+	JSIMPLON_EXPECT_COLON,
+	JSIMPLON_EXPECT_NEXT     // ',' or the end of the innermost container, or of the input once there's none
+} Jsimplon_Expecting;
+
 typedef struct {
 	Jsimplon_Lexer lexer;
 	Jsimplon_Token token;
 	uint32_t error_count;
-	bool is_at_beginning;
+
+	// Where the token engine is, so that it can stop after any token and carry on later
+	Jsimplon_Value *value;
+	Jsimplon_Expecting expecting;
+
+	// Open containers, innermost last, both engines build into them in place
+	Jsimplon_Value **stack;
+	uint32_t stack_count;
+	uint32_t stack_size;
+	uint32_t max_depth;
+
+	bool is_lazy; // Containers inside the outermost one are skipped over and left for jsimplon_value_load
+	bool allows_scalar_root; // For NDJSON records, kept by jsimplon_tree_parse_with like the stack is
 } Jsimplon_Parser;
 
+typedef struct {
+	Jsimplon_Parser parser;
+	const Jsimplon_SaxHandler *handler;
+	void *context;
+
+	uint64_t *is_object; // A bit per level of nesting, clear for arrays
+	uint32_t depth;
+	bool is_empty; // Nothing has gone into the innermost container yet
+} Jsimplon_SaxParser;
+
+#ifndef JSIMPLON_NDJSON_BLOCK_SIZE
+#define JSIMPLON_NDJSON_BLOCK_SIZE (64 * 1024)
+#endif // JSIMPLON_NDJSON_BLOCK_SIZE
+
+typedef struct {
+	Jsimplon_Value *tree;
+	char *error; // Only when tree is NULL
+	size_t line; // From the start of its block
+} Jsimplon_NdjsonRecord;
+
+// Workers take whole lines about JSIMPLON_NDJSON_BLOCK_SIZE bytes at a time
+typedef struct {
+	Jsimplon_NdjsonRecord *records;
+	uint32_t records_count;
+	uint32_t records_size;
+	size_t line_count;
+	bool is_done;
+} Jsimplon_NdjsonBlock;
+
+typedef struct {
+	const char *src;
+	size_t src_len;
+	const Jsimplon_Options *options;
+
+	// Block i is parsed into blocks[i % blocks_count], so workers stay at most blocks_count blocks ahead
+	Jsimplon_NdjsonBlock *blocks;
+	size_t blocks_count;
+	size_t next_block;
+	size_t next_offset;
+	size_t delivered_count;
+	bool is_stopping;
+
+#ifdef JSIMPLON_THREADS
+	mtx_t mutex;
+	cnd_t block_done;
+	cnd_t block_delivered;
+#endif
+} Jsimplon_NdjsonJob;
+
+struct jsimplon_stream_parser {
+	Jsimplon_Parser parser;
+	Jsimplon_Value *tree;
+
+	// Whatever hasn't been lexed yet, at most the token the last chunk cut off and the next chunk
+	char *buffer;
+	size_t buffer_count;
+	size_t buffer_size;
+
+	// How far past the start of the unfinished token jsimplon_stream_has_token got, so the next chunk carries on
+	// from there instead of rescanning the token, one past the buffer when it stopped on a backslash
+	size_t scan_length;
+
+	char *error;
+	size_t error_size;
+	bool has_failed;
+};
+
 typedef struct {
 	char **error;
 	size_t *error_size;
+	// The output, NUL-terminated only once it's done. There's always room left for the NUL
 	char *str;
+	size_t str_count;
 	size_t str_size;
 	uint32_t error_count;
 } Jsimplon_Serialiser;
 
+typedef struct {
+	char *src; // From the '{' or '[' to the matching '}' or ']', in the source the document was parsed from
+	size_t length;
+} Jsimplon_Lazy;
+
+// Objects and arrays live out of line, behind a pointer in their value, so values stay small and what the getters hand
+// out stays put wherever the value is moved to. Their tag is the same as their value's but for its flags
 typedef struct jsimplon_object {
-	Jsimplon_Member *members;
-	size_t members_count;
-	size_t members_size;
+	union {
+		struct {
+			Jsimplon_Member *members;
+			uint32_t members_count;
+			uint32_t members_size;
+		};
+		Jsimplon_Lazy lazy; // Only with JSIMPLON_FLAG_LAZY
+	};
+	uintptr_t tag;
 } Jsimplon_Object;
 
 typedef struct jsimplon_array {
-	Jsimplon_Value *values;
-	size_t values_count;
-	size_t values_size;
+	union {
+		struct {
+			Jsimplon_Value *values;
+			uint32_t values_count;
+			uint32_t values_size;
+		};
+		Jsimplon_Lazy lazy; // Only with JSIMPLON_FLAG_LAZY
+	};
+	uintptr_t tag;
 } Jsimplon_Array;
 
+#ifndef JSIMPLON_OBJECT_INDEX_THRESHOLD
+#define JSIMPLON_OBJECT_INDEX_THRESHOLD 32
+#endif // JSIMPLON_OBJECT_INDEX_THRESHOLD
+
+// How many renamed members a document remembers, an index further behind than that is rebuilt
+#ifndef JSIMPLON_RENAMED_KEYS_COUNT
+#define JSIMPLON_RENAMED_KEYS_COUNT 16
+#endif // JSIMPLON_RENAMED_KEYS_COUNT
+
+// Objects with room for at least JSIMPLON_OBJECT_INDEX_THRESHOLD members keep a hash index of their keys right behind
+// the members, in the same allocation, so it comes and goes with them and members stay in order. Open addressing with
+// linear probing, a slot holds a member's index plus one and 0 is empty
+typedef struct {
+	uint64_t keys_version; // The document's, keys renamed since then may be in the wrong slots
+	uint32_t indexed_count; // Members from here on aren't in the slots yet
+	uint32_t stale_count; // Slots renamed members left behind, lookups probe past them
+	bool has_duplicates; // A member isn't in the slots because an earlier one has its key
+	uint32_t slots_count; // A power of two, at least twice the room for members
+	uint32_t slots[];
+} Jsimplon_ObjectIndex;
+
+// Strings the document allocates or interns, the ones parsed in place have nowhere to keep their length
+typedef struct {
+	size_t length;
+	char str[]; // What values and members point at
+} Jsimplon_String;
+
+// Documents are allocated this aligned, which leaves the low bits of a pointer to one free for a type and flags
+#define JSIMPLON_DOCUMENT_ALIGNMENT 256
+#define JSIMPLON_TAG_TYPE_BITS 3
+
+// 16 bytes, a payload and a tag. The tag is the document the value belongs to, which everything it owns is allocated
+// through, with the type in its low JSIMPLON_TAG_TYPE_BITS bits and the flags above them, see jsimplon_tag
 typedef struct jsimplon_value {
 	union {
-		char *          string_value;
-		double          number_value;
-		bool            bool_value;
-		void *          null_value;
-		Jsimplon_Object object_value;
-		Jsimplon_Array  array_value;
+		char *           string_value; // A Jsimplon_String's str unless it's parsed in place
+		char             inline_str[JSIMPLON_INLINE_STR_SIZE]; // Only with JSIMPLON_FLAG_INLINE
+		double           number_value;
+		int64_t          integer_value;
+		uint64_t         unsigned_value; // Only with JSIMPLON_FLAG_UNSIGNED
+		bool             bool_value;
+		void *           null_value;
+		Jsimplon_Object *object_value;
+		Jsimplon_Array * array_value;
 	};
 
-	Jsimplon_ValueType type;
+	uintptr_t tag;
 } Jsimplon_Value;
 
+typedef enum {
+	JSIMPLON_FLAG_BORROWED = 1 << 0, // The string points into a buffer owned by someone else, like the source parsed in
+	                                 // place or the document's intern table, it's never freed. With JSIMPLON_FLAG_LAZY
+	                                 // the source is parsed in place
+	JSIMPLON_FLAG_UNSIGNED = 1 << 1, // The integer is above INT64_MAX and lives in unsigned_value
+	JSIMPLON_FLAG_LAZY     = 1 << 2, // The object or array hasn't been parsed yet, its lazy is where it is. Only ever
+	                                 // in a container's own tag
+	JSIMPLON_FLAG_INLINE   = 1 << 3, // The string or key is stored in the value or member itself, there's nothing to free
+	JSIMPLON_FLAG_INSITU   = 1 << 4  // The string is in the source parsed in place and isn't a Jsimplon_String
+} Jsimplon_Flag;
+
+// An inline key takes the place of the pointer and the length, so members are no bigger for them
 typedef struct jsimplon_member {
-	char *key;
+	union {
+		struct {
+			char *key;
+			uint32_t key_length;
+			uint32_t key_flags;
+		};
+		char inline_key[JSIMPLON_INLINE_KEY_SIZE]; // Only with JSIMPLON_FLAG_INLINE in key_flags
+	};
 	Jsimplon_Value value;
 } Jsimplon_Member;
 
+typedef struct {
+	const char *key; // Unescaped and NUL-terminated
+	size_t length;
+	uint64_t hash; // jsimplon_hash of key
+	size_t index; // SIZE_MAX if the token isn't an array index
+} Jsimplon_PathSegment;
+
+// The keys are stored right after the segments, in the same allocation
+struct jsimplon_path {
+	uint32_t segments_count;
+	Jsimplon_PathSegment segments[];
+};
+
+// For sorting jsimplon_path_get_many's paths without losing track of where their values go
+typedef struct {
+	const Jsimplon_Path *path;
+	size_t index;
+} Jsimplon_PathOrder;
+
+#ifndef JSIMPLON_ARENA_BLOCK_SIZE
+#define JSIMPLON_ARENA_BLOCK_SIZE (64 * 1024)
+#endif // JSIMPLON_ARENA_BLOCK_SIZE
+
+typedef struct jsimplon_arena_block {
+	struct jsimplon_arena_block *next;
+	size_t size;
+	size_t used;
+	max_align_t data[];
+} Jsimplon_ArenaBlock;
+
+#ifndef JSIMPLON_INTERN_MAX_LENGTH
+#define JSIMPLON_INTERN_MAX_LENGTH 32
+#endif // JSIMPLON_INTERN_MAX_LENGTH
+
+// Open addressing with linear probing, NULL is an empty slot. The strings live in an arena of their own even when the
+// document doesn't use one, they're never freed before the document is
+typedef struct {
+	Jsimplon_String **slots;
+	uint32_t slots_count;
+	uint32_t strings_count;
+	Jsimplon_ArenaBlock *arena;
+} Jsimplon_InternTable;
+
+// Aligned to JSIMPLON_DOCUMENT_ALIGNMENT when it's a tree's, chunk allocators are never in a tag
+typedef struct jsimplon_document {
+	Jsimplon_Value root; // First, so the root value and its document share an address
+	Jsimplon_ArenaBlock *arena;
+	bool use_arena;
+
+	// The file the tree was parsed from when the tree still points into it, it goes with the document
+	char *source;
+	size_t source_length;
+	bool is_source_mapped;
+
+	// Keys changed in place, members don't know their object so its index catches up from the last few of them
+	uint64_t keys_version; // How many there have been
+	Jsimplon_Member *renamed_keys[JSIMPLON_RENAMED_KEYS_COUNT]; // Rename n is at n % JSIMPLON_RENAMED_KEYS_COUNT
+
+	bool intern_strings;
+	Jsimplon_InternTable interns;
+
+	bool validate_utf8; // For the lexers of lazy containers, which parse long after the options are gone
+} Jsimplon_Document;
+
+// One bit per byte of a 64 byte block of input
+typedef struct {
+	uint64_t quote;
+	uint64_t backslash;
+	uint64_t whitespace;
+	uint64_t structural; // { } [ ] : ,
+	uint64_t open;       // { [
+	uint64_t close;      // } ]
+} Jsimplon_BlockMasks;
+
+#ifndef JSIMPLON_SPLIT_CHUNK_SIZE
+#define JSIMPLON_SPLIT_CHUNK_SIZE (1024 * 1024)
+#endif // JSIMPLON_SPLIT_CHUNK_SIZE
+
+// A run of elements of a split root array, parsed as if they were all the array had
+typedef struct {
+	size_t begin; // Just past the '[' or ',' before the first element
+	size_t end;   // At the ',' or ']' after the last one
+	Jsimplon_Value elements;
+	Jsimplon_Document allocator; // Only its arenas are used, the chunk's memory is handed to the document at the end
+	bool has_failed;
+} Jsimplon_SplitChunk;
+
+// Chunks are at least JSIMPLON_SPLIT_CHUNK_SIZE bytes and there are a few per worker, whoever is free takes the next
+typedef struct {
+	const char *src;
+	const Jsimplon_Options *options;
+	Jsimplon_Document *document;
+
+	Jsimplon_SplitChunk *chunks;
+	size_t chunks_count;
+	size_t next_chunk;
+	bool is_stopping;
+
+#ifdef JSIMPLON_THREADS
+	mtx_t mutex;
+#endif
+} Jsimplon_SplitJob;
+
 /* Parser functions */
-JSIMPLON_DEF_INTERNAL Jsimplon_Value  jsimplon_parser_parse_value(Jsimplon_Parser *parser);
-JSIMPLON_DEF_INTERNAL Jsimplon_Object jsimplon_parser_parse_object(Jsimplon_Parser *parser);
-JSIMPLON_DEF_INTERNAL Jsimplon_Member jsimplon_parser_parse_member(Jsimplon_Parser *parser);
-JSIMPLON_DEF_INTERNAL Jsimplon_Array  jsimplon_parser_parse_array(Jsimplon_Parser *parser);
+JSIMPLON_DEF_INTERNAL Jsimplon_Value *jsimplon_tree_parse(char **error, const char *src, size_t src_len, char *insitu_src, const Jsimplon_Options *options);
+JSIMPLON_DEF_INTERNAL Jsimplon_Value *jsimplon_tree_parse_with(Jsimplon_Parser *parser, char **error, size_t *error_size, const char *src, size_t src_len, char *insitu_src, const Jsimplon_Options *options);
+JSIMPLON_DEF_INTERNAL Jsimplon_Value *jsimplon_tree_parse_file(char **error, const char *file_name, bool is_insitu, const Jsimplon_Options *options);
+JSIMPLON_DEF_INTERNAL void            jsimplon_parser_parse_tokens(Jsimplon_Parser *parser);
+JSIMPLON_DEF_INTERNAL void            jsimplon_parser_step(Jsimplon_Parser *parser);
+JSIMPLON_DEF_INTERNAL int             jsimplon_parser_parse_scalar(Jsimplon_Parser *parser, Jsimplon_Value *value);
+JSIMPLON_DEF_INTERNAL void            jsimplon_parser_discard_token(Jsimplon_Parser *parser); // For a token nothing is going to take
+JSIMPLON_DEF_INTERNAL int             jsimplon_parser_push(Jsimplon_Parser *parser, Jsimplon_Value *container);
+JSIMPLON_DEF_INTERNAL void            jsimplon_parser_too_deep(Jsimplon_Parser *parser, uint32_t line, uint32_t column);
+JSIMPLON_DEF_INTERNAL void            jsimplon_parser_expected_token(Jsimplon_Parser *parser, const char *expected);
+JSIMPLON_DEF_INTERNAL int             jsimplon_parser_skip(Jsimplon_Parser *parser, Jsimplon_Value *container);
+JSIMPLON_DEF_INTERNAL Jsimplon_Value  jsimplon_parser_parse_structural(Jsimplon_Parser *parser);
+JSIMPLON_DEF_INTERNAL void            jsimplon_parser_expected(Jsimplon_Parser *parser, size_t offset, const char *expected);
+
+// Parse a lazy container's own members or elements if it hasn't been yet, anything else is left as it is
+JSIMPLON_DEF_INTERNAL int jsimplon_value_load(Jsimplon_Value *value);
+JSIMPLON_DEF_INTERNAL int jsimplon_object_load(Jsimplon_Object *object);
+JSIMPLON_DEF_INTERNAL int jsimplon_array_load(Jsimplon_Array *array);
+JSIMPLON_DEF_INTERNAL int jsimplon_lazy_parse(const Jsimplon_Lazy *lazy, uintptr_t tag, Jsimplon_Value *loaded); // loaded gets a header of its own
+
+JSIMPLON_DEF_INTERNAL Jsimplon_Value *jsimplon_path_step(Jsimplon_Value *value, const Jsimplon_PathSegment *segment); // NULL if nothing is there
+JSIMPLON_DEF_INTERNAL bool            jsimplon_path_segment_equals(const Jsimplon_PathSegment *a, const Jsimplon_PathSegment *b);
+JSIMPLON_DEF_INTERNAL int             jsimplon_path_order_compare(const void *a, const void *b);
+
+JSIMPLON_DEF_INTERNAL int jsimplon_sax_step(Jsimplon_SaxParser *sax);
+JSIMPLON_DEF_INTERNAL int jsimplon_sax_value(Jsimplon_SaxParser *sax);
+JSIMPLON_DEF_INTERNAL int jsimplon_sax_close(Jsimplon_SaxParser *sax, bool is_object);
+
+JSIMPLON_DEF_INTERNAL size_t   jsimplon_ndjson_block_end(const char *src, size_t begin, size_t src_len);
+JSIMPLON_DEF_INTERNAL void     jsimplon_ndjson_parse_block(Jsimplon_NdjsonJob *job, Jsimplon_NdjsonBlock *block, size_t begin, size_t end, Jsimplon_Parser *parser, char **error, size_t *error_size);
+JSIMPLON_DEF_INTERNAL void     jsimplon_ndjson_deliver(Jsimplon_NdjsonBlock *block, size_t *line, Jsimplon_NdjsonCallback callback, void *context, int *status, size_t *failed_count);
+JSIMPLON_DEF_INTERNAL uint32_t jsimplon_cpu_count(void);
+#ifdef JSIMPLON_THREADS
+JSIMPLON_DEF_INTERNAL int      jsimplon_ndjson_worker(void *job);
+#endif
+
+#ifdef JSIMPLON_THREADS
+JSIMPLON_DEF_INTERNAL Jsimplon_Value *jsimplon_tree_parse_split(const char *src, size_t src_len, const Jsimplon_Options *options); // Returns NULL if it didn't
+JSIMPLON_DEF_INTERNAL size_t          jsimplon_split_root_array(const char *src, size_t src_len, size_t *splits, size_t splits_size);
+JSIMPLON_DEF_INTERNAL void            jsimplon_split_parse_chunk(Jsimplon_SplitJob *job, Jsimplon_SplitChunk *chunk, Jsimplon_Parser *parser);
+JSIMPLON_DEF_INTERNAL int             jsimplon_split_worker(void *job);
+#endif
+
+JSIMPLON_DEF_INTERNAL void jsimplon_stream_parser_run(Jsimplon_StreamParser *stream, bool is_final);
+JSIMPLON_DEF_INTERNAL int  jsimplon_stream_parser_report(char **error, Jsimplon_StreamParser *stream);
+JSIMPLON_DEF_INTERNAL bool jsimplon_stream_has_token(Jsimplon_StreamParser *stream);
 
 /* Lexer functions */
 JSIMPLON_DEF_INTERNAL Jsimplon_Token jsimplon_lexer_next_token(Jsimplon_Lexer *lexer);
+JSIMPLON_DEF_INTERNAL void           jsimplon_lexer_skip_whitespace(Jsimplon_Lexer *lexer);
+JSIMPLON_DEF_INTERNAL Jsimplon_Token jsimplon_lexer_lex_string(Jsimplon_Lexer *lexer, Jsimplon_Token token);
+JSIMPLON_DEF_INTERNAL Jsimplon_Token jsimplon_lexer_lex_number(Jsimplon_Lexer *lexer, Jsimplon_Token token);
+JSIMPLON_DEF_INTERNAL Jsimplon_Token jsimplon_lexer_lex_literal(Jsimplon_Lexer *lexer, Jsimplon_Token token);
+JSIMPLON_DEF_INTERNAL void           jsimplon_lexer_locate(const Jsimplon_Lexer *lexer, Jsimplon_Token *token, size_t offset);
 JSIMPLON_DEF_INTERNAL const char *   jsimplon_token_to_str(Jsimplon_Token token);
 
+/* Number functions */
+// src has to be a literal the number DFA accepted, it doesn't have to be NUL-terminated
+JSIMPLON_DEF_INTERNAL double   jsimplon_number_parse(const char *src, size_t length);
+JSIMPLON_DEF_INTERNAL uint64_t jsimplon_number_eisel_lemire(uint64_t mantissa, int64_t exponent);
+JSIMPLON_DEF_INTERNAL uint64_t jsimplon_number_slow_path(const char *src, size_t length);
+JSIMPLON_DEF_INTERNAL void     jsimplon_decimal_shift_left(Jsimplon_Decimal *decimal, uint32_t shift);
+JSIMPLON_DEF_INTERNAL void     jsimplon_decimal_shift_right(Jsimplon_Decimal *decimal, uint32_t shift);
+JSIMPLON_DEF_INTERNAL uint64_t jsimplon_decimal_rounded_integer(const Jsimplon_Decimal *decimal);
+JSIMPLON_DEF_INTERNAL size_t   jsimplon_number_format(double number, char *buffer); // Not NUL-terminated, returns the length
+JSIMPLON_DEF_INTERNAL size_t   jsimplon_integer_format(uint64_t magnitude, bool negative, char *buffer); // Same
+JSIMPLON_DEF_INTERNAL void     jsimplon_grisu2(double number, char *digits, int32_t *length, int32_t *decimal_exponent);
+JSIMPLON_DEF_INTERNAL void     jsimplon_grisu2_digits(Jsimplon_DiyFp w, Jsimplon_DiyFp plus, uint64_t delta, char *digits, int32_t *length, int32_t *decimal_exponent);
+JSIMPLON_DEF_INTERNAL Jsimplon_DiyFp jsimplon_diyfp_multiply(Jsimplon_DiyFp a, Jsimplon_DiyFp b);
+JSIMPLON_DEF_INTERNAL uint64_t jsimplon_mul128(uint64_t a, uint64_t b, uint64_t *high); // Returns the low half
+JSIMPLON_DEF_INTERNAL uint32_t jsimplon_clz64(uint64_t x);
+
+/* Scanning functions */
+// Both return the index of the first matching byte at or after index, or src_len if there is none
+JSIMPLON_DEF_INTERNAL size_t jsimplon_scan_string(const char *src, size_t index, size_t src_len); // '"', '\\' or a control character
+JSIMPLON_DEF_INTERNAL size_t jsimplon_scan_whitespace(const char *src, size_t index, size_t src_len, uint32_t *newline_count, size_t *last_newline); // anything but whitespace
+JSIMPLON_DEF_INTERNAL size_t jsimplon_copy_span(char *dst, const char *src, size_t index, size_t end); // Up to the first '\\', returns how much it copied
+JSIMPLON_DEF_INTERNAL char * jsimplon_unescape(char *dst, const char *src, size_t index, size_t end); // Returns the end of dst
+JSIMPLON_DEF_INTERNAL size_t jsimplon_escape_decode(const char *src, size_t index, size_t src_len, char *decoded, size_t *escape_length, bool is_strict); // 0 if it isn't one
+JSIMPLON_DEF_INTERNAL bool   jsimplon_hex4(const char *src, size_t index, size_t src_len, uint32_t *code);
+JSIMPLON_DEF_INTERNAL size_t jsimplon_utf8_encode(uint32_t code, char *dst);
+JSIMPLON_DEF_INTERNAL size_t jsimplon_scan_ascii(const char *src, size_t index, size_t src_len); // The first byte above 0x7F
+JSIMPLON_DEF_INTERNAL bool   jsimplon_utf8_validate(const char *src, size_t length);
+#if defined(__AVX2__)
+JSIMPLON_DEF_INTERNAL __m256i jsimplon_utf8_block_errors(__m256i input, __m256i prev_input);
+#else
+JSIMPLON_DEF_INTERNAL size_t jsimplon_utf8_sequence(const char *src, size_t index, size_t length); // Its length, 0 if it's malformed
+#endif
+JSIMPLON_DEF_INTERNAL uint32_t jsimplon_load32(const char *src);
+#if defined(__SSE2__) || defined(__AVX2__)
+JSIMPLON_DEF_INTERNAL uint32_t jsimplon_ctz32(uint32_t x);
+#endif
+JSIMPLON_DEF_INTERNAL uint32_t jsimplon_ctz64(uint64_t x);
+JSIMPLON_DEF_INTERNAL uint32_t jsimplon_popcount64(uint64_t x);
+
+/* Structural index functions */
+JSIMPLON_DEF_INTERNAL uint32_t *jsimplon_structural_index(const char *src, size_t src_len, size_t *count); // Has to be freed
+JSIMPLON_DEF_INTERNAL Jsimplon_BlockMasks jsimplon_classify_block(const char *block);
+JSIMPLON_DEF_INTERNAL uint64_t jsimplon_find_escaped(uint64_t backslash, uint64_t *next_is_escaped);
+JSIMPLON_DEF_INTERNAL uint64_t jsimplon_prefix_xor(uint64_t x);
+// Returns SIZE_MAX if it isn't closed, or if it nests deeper than max_depth and then too_deep is where
+JSIMPLON_DEF_INTERNAL size_t   jsimplon_skip_container(const char *src, size_t index, size_t src_len, uint64_t max_depth, size_t *too_deep);
+
 /* Serialisation functions */
 JSIMPLON_DEF_INTERNAL void jsimplon_value_to_str(Jsimplon_Serialiser *serialiser, const Jsimplon_Value *value);
 JSIMPLON_DEF_INTERNAL void jsimplon_object_to_str(Jsimplon_Serialiser *serialiser, const Jsimplon_Object *object);
 JSIMPLON_DEF_INTERNAL void jsimplon_array_to_str(Jsimplon_Serialiser *serialiser, const Jsimplon_Array *array);
+JSIMPLON_DEF_INTERNAL char *jsimplon_serialiser_reserve(Jsimplon_Serialiser *serialiser, size_t length); // Returns where the next length characters go
+JSIMPLON_DEF_INTERNAL void  jsimplon_serialiser_append(Jsimplon_Serialiser *serialiser, const char *src, size_t length);
+JSIMPLON_DEF_INTERNAL void  jsimplon_serialiser_str(Jsimplon_Serialiser *serialiser, const char *str, size_t length); // Quoted and escaped
 
 /* Cleaning */
 JSIMPLON_DEF_INTERNAL void jsimplon_value_destroy(Jsimplon_Value *value);
@@ -245,1382 +921,5912 @@ JSIMPLON_DEF_INTERNAL void jsimplon_object_destroy(Jsimplon_Object *object);
 JSIMPLON_DEF_INTERNAL void jsimplon_member_destroy(Jsimplon_Member *member);
 JSIMPLON_DEF_INTERNAL void jsimplon_array_destroy(Jsimplon_Array *array);
 
+/* Document functions */
+// A NULL document means plain heap memory
+JSIMPLON_DEF_INTERNAL void * jsimplon_document_alloc(Jsimplon_Document *document, size_t size);
+JSIMPLON_DEF_INTERNAL void * jsimplon_document_realloc(Jsimplon_Document *document, void *ptr, size_t old_size, size_t new_size);
+JSIMPLON_DEF_INTERNAL void   jsimplon_document_free(Jsimplon_Document *document, void *ptr);
+JSIMPLON_DEF_INTERNAL char * jsimplon_document_strdup(Jsimplon_Document *document, const char *str);
+JSIMPLON_DEF_INTERNAL char * jsimplon_document_intern(Jsimplon_Document *document, const char *str, size_t length, uint32_t *flags); // Sets JSIMPLON_FLAG_BORROWED in flags if it did
+JSIMPLON_DEF_INTERNAL char * jsimplon_document_string(Jsimplon_Document *document, size_t length); // A Jsimplon_String's str, only its NUL is set
+JSIMPLON_DEF_INTERNAL Jsimplon_String *jsimplon_string(char *str); // The Jsimplon_String str belongs to
+JSIMPLON_DEF_INTERNAL uintptr_t          jsimplon_tag(Jsimplon_Document *document, Jsimplon_ValueType type, uint32_t flags);
+JSIMPLON_DEF_INTERNAL Jsimplon_Document *jsimplon_tag_document(uintptr_t tag);
+JSIMPLON_DEF_INTERNAL Jsimplon_ValueType jsimplon_tag_type(uintptr_t tag);
+JSIMPLON_DEF_INTERNAL uint32_t           jsimplon_tag_flags(uintptr_t tag);
+JSIMPLON_DEF_INTERNAL void               jsimplon_value_retag(Jsimplon_Value *value, Jsimplon_ValueType type, uint32_t flags); // Keeps the document
+JSIMPLON_DEF_INTERNAL void               jsimplon_value_open(Jsimplon_Value *value, Jsimplon_Document *allocator, Jsimplon_ValueType type);
+JSIMPLON_DEF_INTERNAL const char *jsimplon_value_str(const Jsimplon_Value *value);
+JSIMPLON_DEF_INTERNAL size_t      jsimplon_value_str_length(const Jsimplon_Value *value);
+JSIMPLON_DEF_INTERNAL const char *jsimplon_member_key(const Jsimplon_Member *member); // NULL if it hasn't got one yet
+JSIMPLON_DEF_INTERNAL size_t      jsimplon_member_key_length(const Jsimplon_Member *member);
+JSIMPLON_DEF_INTERNAL bool        jsimplon_member_key_equals(const Jsimplon_Member *member, const char *key, size_t length);
+JSIMPLON_DEF_INTERNAL void        jsimplon_value_store_str(Jsimplon_Value *value, Jsimplon_Document *document, const char *str, size_t length);
+JSIMPLON_DEF_INTERNAL void        jsimplon_member_store_key(Jsimplon_Member *member, Jsimplon_Document *document, const char *key, size_t length);
+JSIMPLON_DEF_INTERNAL void        jsimplon_value_take_str(Jsimplon_Value *value, const Jsimplon_Lexer *lexer, const Jsimplon_Token *token);
+JSIMPLON_DEF_INTERNAL void        jsimplon_member_take_key(Jsimplon_Member *member, const Jsimplon_Lexer *lexer, const Jsimplon_Token *token);
+JSIMPLON_DEF_INTERNAL char * jsimplon_intern(Jsimplon_InternTable *table, const char *str, size_t length); // A Jsimplon_String's str
+JSIMPLON_DEF_INTERNAL void * jsimplon_arena_alloc(Jsimplon_ArenaBlock **arena, size_t size);
+#ifdef JSIMPLON_THREADS
+JSIMPLON_DEF_INTERNAL void   jsimplon_arena_splice(Jsimplon_ArenaBlock **arena, Jsimplon_ArenaBlock *blocks);
+#endif
+JSIMPLON_DEF_INTERNAL void   jsimplon_arena_destroy(Jsimplon_ArenaBlock *arena);
+JSIMPLON_DEF_INTERNAL void   jsimplon_object_grow(Jsimplon_Document *document, Jsimplon_Object *object);
+JSIMPLON_DEF_INTERNAL void   jsimplon_object_resize(Jsimplon_Document *document, Jsimplon_Object *object, uint32_t new_size);
+JSIMPLON_DEF_INTERNAL void   jsimplon_array_grow(Jsimplon_Document *document, Jsimplon_Array *array);
+JSIMPLON_DEF_INTERNAL void   jsimplon_array_resize(Jsimplon_Document *document, Jsimplon_Array *array, uint32_t new_size);
+JSIMPLON_DEF_INTERNAL Jsimplon_Document *jsimplon_object_document(Jsimplon_Object *object);
+JSIMPLON_DEF_INTERNAL Jsimplon_Document *jsimplon_array_document(Jsimplon_Array *array);
+
+/* Object index functions */
+JSIMPLON_DEF_INTERNAL size_t                jsimplon_object_index_size(uint32_t members_size); // 0 if it's too small for one
+JSIMPLON_DEF_INTERNAL Jsimplon_ObjectIndex *jsimplon_object_index_update(Jsimplon_Object *object); // NULL if it has none
+JSIMPLON_DEF_INTERNAL void                  jsimplon_object_index_reset(Jsimplon_ObjectIndex *index);
+JSIMPLON_DEF_INTERNAL bool                  jsimplon_object_index_reslot(Jsimplon_Object *object, Jsimplon_ObjectIndex *index, uint32_t member_index); // false if it has to be reset instead
+JSIMPLON_DEF_INTERNAL Jsimplon_Member *     jsimplon_object_index_find(Jsimplon_Object *object, Jsimplon_ObjectIndex *index, const char *key, size_t length, uint64_t hash);
+JSIMPLON_DEF_INTERNAL bool                  jsimplon_key_equals(const char *a, size_t a_length, const char *b, size_t b_length);
+
 /* Utility functions */
 JSIMPLON_DEF_INTERNAL void  jsimplon_append_str(char **str, size_t *str_size, const char *fmt, ...);
+JSIMPLON_DEF_INTERNAL uint64_t jsimplon_hash(const char *key, size_t length); // FNV-1a
 JSIMPLON_DEF_INTERNAL char *jsimplon_file_read(char **error, size_t *error_size, const char *file_name); // Returns NULL if failed
+JSIMPLON_DEF_INTERNAL char *jsimplon_file_map(char **error, size_t *error_size, const char *file_name, bool is_writable, size_t *length, bool *is_mapped); // Same
+JSIMPLON_DEF_INTERNAL void  jsimplon_file_unmap(char *src, size_t length, bool is_mapped);
 JSIMPLON_DEF_INTERNAL int   jsimplon_file_write(char **error, size_t *error_size, const char *file_name, const char *src); // Returns 0 if success anything else if failed
 
 JSIMPLON_DEF Jsimplon_Value *jsimplon_tree_from_str(char **error, const char *src)
 {
-	Jsimplon_Value *tree = jsimplon_tree_root_create();
+	return jsimplon_tree_parse(error, src, strlen(src), NULL, NULL);
+}
+
+JSIMPLON_DEF Jsimplon_Value *jsimplon_tree_from_str_ex(char **error, const char *src, size_t src_len, const Jsimplon_Options *options)
+{
+	return jsimplon_tree_parse(error, src, src_len, NULL, options);
+}
+
+JSIMPLON_DEF Jsimplon_Value *jsimplon_tree_from_buffer_insitu(char **error, char *buf, size_t len)
+{
+	return jsimplon_tree_parse(error, buf, len, buf, NULL);
+}
+
+JSIMPLON_DEF Jsimplon_Value *jsimplon_tree_from_buffer_insitu_ex(char **error, char *buf, size_t len, const Jsimplon_Options *options)
+{
+	return jsimplon_tree_parse(error, buf, len, buf, options);
+}
 
+JSIMPLON_DEF_INTERNAL Jsimplon_Value *jsimplon_tree_parse(char **error, const char *src, size_t src_len, char *insitu_src, const Jsimplon_Options *options)
+{
 	size_t error_size = 0;
 	if (error != NULL) {
 		error_size = 1;
 		*error = calloc(error_size, (sizeof *(*error)));
 	}
 
+	Jsimplon_Parser parser = { 0 };
+	Jsimplon_Value *tree = NULL;
+
+#ifdef JSIMPLON_THREADS
+	if (options != NULL && options->split_root_array && insitu_src == NULL)
+		tree = jsimplon_tree_parse_split(src, src_len, options);
+#endif
+
+	if (tree == NULL)
+		tree = jsimplon_tree_parse_with(&parser, error, &error_size, src, src_len, insitu_src, options);
+
+	free(parser.stack);
+
+	if (tree != NULL && error != NULL) {
+		free(*error);
+		*error = NULL;
+	}
+
+	return tree;
+}
+
+// Errors are appended to error, the parser only lends its stack and keeps it for the next document parsed with it
+JSIMPLON_DEF_INTERNAL Jsimplon_Value *jsimplon_tree_parse_with(Jsimplon_Parser *parser, char **error, size_t *error_size, const char *src, size_t src_len, char *insitu_src, const Jsimplon_Options *options)
+{
+	Jsimplon_Value *tree = jsimplon_tree_root_create_ex(options);
+	Jsimplon_Value **stack = parser->stack;
+	uint32_t stack_size = parser->stack_size;
+	bool allows_scalar_root = parser->allows_scalar_root;
+
 	bool success = true;
 
-	Jsimplon_Parser parser = {
+	*parser = (Jsimplon_Parser){
 		.lexer = {
 			.src        = src,
+			.src_len    = src_len,
+			.insitu_src = insitu_src,
+			.validate_utf8 = jsimplon_tag_document(tree->tag)->validate_utf8,
+			.document   = jsimplon_tag_document(tree->tag),
+			.allocator  = jsimplon_tag_document(tree->tag),
 			.error      = error,
-			.error_size = &error_size,
-			.lexeme     = malloc(JSIMPLON_STRING_LITERAL_MAX_LENGTH + 1),
+			.error_size = error_size,
 			.line       = 1
 		},
-		.is_at_beginning = true
+		.value = tree,
+		.expecting = JSIMPLON_EXPECT_ROOT,
+		.stack = stack,
+		.stack_size = stack_size,
+		.max_depth = options != NULL && options->max_depth != 0 ? options->max_depth : JSIMPLON_DEFAULT_MAX_DEPTH,
+		.is_lazy = options != NULL && options->lazy,
+		.allows_scalar_root = allows_scalar_root
 	};
 
-	parser.token = jsimplon_lexer_next_token(&parser.lexer);
-	*tree = jsimplon_parser_parse_value(&parser);
+	// The index stores 32 bit offsets, anything bigger goes through the token engine. So does a lazy document, which
+	// would be indexed all the way down for nothing
+	if (options != NULL && options->engine == JSIMPLON_ENGINE_STRUCTURAL && src_len <= UINT32_MAX && !parser->is_lazy) {
+		*tree = jsimplon_parser_parse_structural(parser);
+	}
+	else {
+		parser->token = jsimplon_lexer_next_token(&parser->lexer);
+		jsimplon_parser_parse_tokens(parser);
+	}
 
-	if (parser.lexer.error_count > 0) {
+	if (parser->lexer.error_count > 0) {
 		success = false;
 
 		jsimplon_append_str(
-			error, &error_size,
+			error, error_size,
 			"lexer generated %u error(s)\n",
-			parser.lexer.error_count
+			parser->lexer.error_count
 		);
 	}
 
-	if (parser.error_count > 0) {
+	if (parser->error_count > 0) {
 		success = false;
 
 		jsimplon_append_str(
-			error, &error_size,
+			error, error_size,
 			"parser generated %u error(s)\n",
-			parser.error_count
+			parser->error_count
 		);
 	}
 
-	free(parser.lexer.lexeme);
-
 	if (!success) {
 		jsimplon_tree_destroy(tree);
 		return NULL;
 	}
 
-	free(*error);
-	*error = NULL;
-
 	return tree;
 }
 
-JSIMPLON_DEF Jsimplon_Value *jsimplon_tree_from_file(char **error, const char *file_name)
+JSIMPLON_DEF Jsimplon_StreamParser *jsimplon_stream_parser_create(const Jsimplon_Options *options)
 {
-	size_t error_size;
-	if (error != NULL) {
-		error_size = 128;
-		*error = calloc(error_size, sizeof *(*error));
-	}
-
-	char *src = jsimplon_file_read(error, &error_size, file_name);
+	Jsimplon_StreamParser *stream = calloc(1, sizeof *stream);
 
-	if (src == NULL)
-		return NULL;
-
-	if (error != NULL && *error != NULL)
-		free(*error);
+	stream->tree = jsimplon_tree_root_create_ex(options);
+	stream->error_size = 1;
+	stream->error = calloc(stream->error_size, (sizeof *stream->error));
 
-	Jsimplon_Value *tree = jsimplon_tree_from_str(error, src);
-	free(src);
+	stream->parser = (Jsimplon_Parser){
+		.lexer = {
+			.validate_utf8 = jsimplon_tag_document(stream->tree->tag)->validate_utf8,
+			.document   = jsimplon_tag_document(stream->tree->tag),
+			.allocator  = jsimplon_tag_document(stream->tree->tag),
+			.error      = &stream->error,
+			.error_size = &stream->error_size,
+			.line       = 1
+		},
+		.value = stream->tree,
+		.expecting = JSIMPLON_EXPECT_ROOT,
+		.max_depth = options != NULL && options->max_depth != 0 ? options->max_depth : JSIMPLON_DEFAULT_MAX_DEPTH
+	};
 
-	return tree;
+	return stream;
 }
 
-JSIMPLON_DEF char *jsimplon_tree_to_str(char **error, const Jsimplon_Value *root_value)
+JSIMPLON_DEF int jsimplon_stream_parser_feed(char **error, Jsimplon_StreamParser *stream, const char *chunk, size_t chunk_len)
 {
-	size_t error_size;
-	if (error != NULL) {
-		error_size = 128;
-		*error = calloc(error_size, sizeof *(*error));
-	}
-
-	bool success = true;
-
-	Jsimplon_Serialiser serialiser = {
-		.error = error,
-		.error_size = &error_size,
-		.str_size = 128
-	};
-	serialiser.str = calloc(serialiser.str_size, sizeof *serialiser.str);
-
-	jsimplon_value_to_str(&serialiser, root_value);
+	if (error != NULL)
+		*error = NULL;
 
-	if (serialiser.error_count > 0) {
-		success = false;
+	if (stream == NULL || (chunk == NULL && chunk_len > 0))
+		return JSIMPLON_FAILURE;
 
-		jsimplon_append_str(
-			error, &error_size,
-			"serialiser generated %u error(s)\n",
-			serialiser.error_count
-		);
+	if (stream->buffer_count + chunk_len > stream->buffer_size) {
+		stream->buffer_size = stream->buffer_size * 2 < stream->buffer_count + chunk_len ? stream->buffer_count + chunk_len : stream->buffer_size * 2;
+		stream->buffer = realloc(stream->buffer, stream->buffer_size);
 	}
 
-	if (!success) {
-		free(serialiser.str);
-		return NULL;
-	}
+	if (chunk_len > 0)
+		memcpy(&stream->buffer[stream->buffer_count], chunk, chunk_len);
+	stream->buffer_count += chunk_len;
 
-	free(*error);
-	*error = NULL;
+	jsimplon_stream_parser_run(stream, false);
 
-	return serialiser.str;
+	return jsimplon_stream_parser_report(error, stream);
 }
 
-JSIMPLON_DEF int jsimplon_tree_to_file(char **error, const Jsimplon_Value *root_value, const char *file_name)
+JSIMPLON_DEF Jsimplon_Value *jsimplon_stream_parser_finish(char **error, Jsimplon_StreamParser *stream)
 {
-	char *str = jsimplon_tree_to_str(error, root_value);
-
-	size_t error_size;
+	if (error != NULL)
+		*error = NULL;
 
-	if (str == NULL)
-		return JSIMPLON_FAILURE;
+	if (stream == NULL)
+		return NULL;
 
-	if (error != NULL) {
-		error_size = 128;
-		*error = calloc(error_size, sizeof *(*error));
-	}
+	Jsimplon_Value *tree = NULL;
 
-	int status = jsimplon_file_write(error, &error_size, file_name, str);
-	free(str);
+	jsimplon_stream_parser_run(stream, true);
 
-	if (status == JSIMPLON_SUCCESS) {
-		free(*error);
-		*error = NULL;
+	if (jsimplon_stream_parser_report(error, stream) == JSIMPLON_SUCCESS) {
+		tree = stream->tree;
+		stream->tree = NULL;
 	}
 
-	return status;
+	jsimplon_stream_parser_destroy(stream);
+
+	return tree;
 }
 
-JSIMPLON_DEF int jsimplon_tree_destroy(Jsimplon_Value *tree)
+JSIMPLON_DEF void jsimplon_stream_parser_destroy(Jsimplon_StreamParser *stream)
 {
-	if (tree == NULL)
-		return JSIMPLON_FAILURE;
+	if (stream == NULL)
+		return;
 
-	jsimplon_value_destroy(tree);
-	free(tree);
+	if (stream->tree != NULL)
+		jsimplon_tree_destroy(stream->tree);
 
-	return JSIMPLON_SUCCESS;
+	free(stream->parser.stack);
+	free(stream->buffer);
+	free(stream->error);
+	free(stream);
 }
 
-JSIMPLON_DEF Jsimplon_Value *jsimplon_tree_root_create(void)
+// Lexes every whole token that has arrived, a token cut off by the end of the chunk is kept for the next one
+JSIMPLON_DEF_INTERNAL void jsimplon_stream_parser_run(Jsimplon_StreamParser *stream, bool is_final)
 {
-	return calloc(1, sizeof(Jsimplon_Value));
-}
+	Jsimplon_Parser *parser = &stream->parser;
+	Jsimplon_Lexer *lexer = &parser->lexer;
 
-JSIMPLON_DEF int jsimplon_value_set_str(Jsimplon_Value *value, const char *str)
-{
-	if (value == NULL || str == NULL)
-		return JSIMPLON_FAILURE;
+	lexer->src = stream->buffer;
+	lexer->src_len = stream->buffer_count;
 
-	jsimplon_value_destroy(value);
-	value->type = JSIMPLON_VALUE_STRING;
-	value->string_value = malloc(strlen(str) + 1);
-	strcpy(value->string_value, str);
+	while (parser->error_count == 0 && lexer->error_count == 0) {
+		jsimplon_lexer_skip_whitespace(lexer);
 
-	return JSIMPLON_SUCCESS;
-}
+		if (!is_final && !jsimplon_stream_has_token(stream))
+			break;
 
-JSIMPLON_DEF int jsimplon_value_set_number(Jsimplon_Value *value, double number)
-{
-	if (value == NULL)
-		return JSIMPLON_FAILURE;
+		parser->token = jsimplon_lexer_next_token(lexer);
+		stream->scan_length = 0;
 
-	jsimplon_value_destroy(value);
-	value->type = JSIMPLON_VALUE_NUMBER;
-	value->number_value = number;
+		if (lexer->error_count > 0) {
+			jsimplon_parser_discard_token(parser);
+			break;
+		}
 
-	return JSIMPLON_SUCCESS;
+		jsimplon_parser_step(parser);
+
+		if (parser->token.type == JSIMPLON_TOKEN_END)
+			break;
+	}
+
+	// Only the unfinished token is kept, begin_of_line may end up before the buffer but columns are differences
+	// of unsigned offsets so they still come out right
+	if (lexer->index > 0) {
+		memmove(stream->buffer, &stream->buffer[lexer->index], lexer->src_len - lexer->index);
+		stream->buffer_count -= lexer->index;
+		lexer->begin_of_line -= lexer->index;
+		lexer->index = 0;
+	}
 }
 
-JSIMPLON_DEF int jsimplon_value_set_bool(Jsimplon_Value *value, bool bool_value)
+JSIMPLON_DEF_INTERNAL int jsimplon_stream_parser_report(char **error, Jsimplon_StreamParser *stream)
 {
-	if (value == NULL)
-		return JSIMPLON_FAILURE;
+	Jsimplon_Parser *parser = &stream->parser;
 
-	jsimplon_value_destroy(value);
-	value->type = JSIMPLON_VALUE_BOOL;
-	value->bool_value = bool_value;
+	if (parser->lexer.error_count == 0 && parser->error_count == 0)
+		return JSIMPLON_SUCCESS;
 
-	return JSIMPLON_SUCCESS;
-}
+	// A failed stream stays failed and keeps handing out the same message
+	if (!stream->has_failed) {
+		stream->has_failed = true;
 
-JSIMPLON_DEF int jsimplon_value_set_null(Jsimplon_Value *value)
-{
-	if (value == NULL)
-		return JSIMPLON_FAILURE;
+		if (parser->lexer.error_count > 0) {
+			jsimplon_append_str(
+				&stream->error, &stream->error_size,
+				"lexer generated %u error(s)\n",
+				parser->lexer.error_count
+			);
+		}
 
-	jsimplon_value_destroy(value);
-	value->type = JSIMPLON_VALUE_NULL;
-	value->null_value = NULL;
+		if (parser->error_count > 0) {
+			jsimplon_append_str(
+				&stream->error, &stream->error_size,
+				"parser generated %u error(s)\n",
+				parser->error_count
+			);
+		}
+	}
 
-	return JSIMPLON_SUCCESS;
+	if (error != NULL)
+		*error = jsimplon_document_strdup(NULL, stream->error);
+
+	return JSIMPLON_FAILURE;
 }
 
-JSIMPLON_DEF Jsimplon_Object *jsimplon_value_set_object(Jsimplon_Value *value)
+// Whether the token at the lexer's index is all there, strings need their closing quote and numbers and literals
+// need something after them since the next chunk could carry on with more digits or letters
+JSIMPLON_DEF_INTERNAL bool jsimplon_stream_has_token(Jsimplon_StreamParser *stream)
 {
-	if (value == NULL)
-		return NULL;
+	const char *src = stream->buffer;
+	size_t src_len = stream->buffer_count;
+	size_t index = stream->parser.lexer.index;
 
-	jsimplon_value_destroy(value);
-	value->type = JSIMPLON_VALUE_OBJECT;
-	value->object_value = (Jsimplon_Object) { 0 };
+	if (index >= src_len)
+		return false;
 
-	return &value->object_value;
-}
+	size_t i = index + (stream->scan_length > 1 ? stream->scan_length : 1);
 
-JSIMPLON_DEF Jsimplon_Array *jsimplon_value_set_array(Jsimplon_Value *value)
-{
-	if (value == NULL)
-		return NULL;
+	switch (jsimplon_char_classes[(uint8_t)src[index]]) {
+		case JSIMPLON_CHAR_QUOTE:
+			for (; (i = jsimplon_scan_string(src, i, src_len)) < src_len; ++i) {
+				// The closing quote, or a control character, an error the lexer reports so the token is as whole as it will get
+				if (src[i] != '\\')
+					return true;
 
-	jsimplon_value_destroy(value);
-	value->type = JSIMPLON_VALUE_ARRAY;
-	value->array_value = (Jsimplon_Array) { 0 };
+				++i;
+			}
 
-	return &value->array_value;
-}
+			break;
+		case JSIMPLON_CHAR_MINUS:
+		case JSIMPLON_CHAR_ZERO:
+		case JSIMPLON_CHAR_DIGIT:
+		case JSIMPLON_CHAR_EXPONENT:
+		case JSIMPLON_CHAR_LETTER:
+			while (i < src_len && jsimplon_char_classes[(uint8_t)src[i]] >= JSIMPLON_CHAR_MINUS)
+				++i;
 
-JSIMPLON_DEF Jsimplon_Member *jsimplon_object_add_member(Jsimplon_Object *object)
-{
-	if (object == NULL)
-		return NULL;
+			if (i < src_len)
+				return true;
 
-	object->members = realloc(object->members, (object->members_count + 1) * (sizeof *object->members));
-	Jsimplon_Member *member = &object->members[object->members_count++];
-	*member = (Jsimplon_Member) { 0 };
+			break;
+		default:
+			return true;
+	}
 
-	return member;
+	stream->scan_length = i - index;
+
+	return false;
 }
 
-JSIMPLON_DEF Jsimplon_Value *jsimplon_object_add_member_value(Jsimplon_Object *object, const char *key)
+// The SAX driver walks the same tokens as the token engine but only keeps one bit per open container
+JSIMPLON_DEF int jsimplon_sax_parse(char **error, const char *src, size_t src_len, const Jsimplon_SaxHandler *handler, void *context, const Jsimplon_Options *options)
 {
-	if (object == NULL || key == NULL)
-		return NULL;
+	if (src == NULL || handler == NULL)
+		return JSIMPLON_FAILURE;
 
-	Jsimplon_Member *member = jsimplon_object_add_member(object);
-	jsimplon_member_set_key(member, key);
+	size_t error_size = 0;
+	if (error != NULL) {
+		error_size = 1;
+		*error = calloc(error_size, (sizeof *(*error)));
+	}
 
-	return &member->value;
-}
+	Jsimplon_SaxParser sax = {
+		.parser = {
+			.lexer = {
+				.src        = src,
+				.src_len    = src_len,
+				.is_slicing = true,
+				.validate_utf8 = options != NULL && options->validate_utf8,
+				.error      = error,
+				.error_size = &error_size,
+				.line       = 1
+			},
+			.expecting = JSIMPLON_EXPECT_ROOT,
+			.max_depth = options != NULL && options->max_depth != 0 ? options->max_depth : JSIMPLON_DEFAULT_MAX_DEPTH
+		},
+		.handler = handler,
+		.context = context
+	};
 
-JSIMPLON_DEF int jsimplon_object_add_member_str(Jsimplon_Object *object, const char *key, const char *str)
-{
-	if (object == NULL || key == NULL || str == NULL)
-		return JSIMPLON_FAILURE;
+	Jsimplon_Parser *parser = &sax.parser;
+	sax.is_object = calloc(((size_t)parser->max_depth + 63) / 64, sizeof *sax.is_object);
 
-	return jsimplon_value_set_str(jsimplon_object_add_member_value(object, key), str);
-}
+	int status = JSIMPLON_SUCCESS;
 
-JSIMPLON_DEF int jsimplon_object_add_member_number(Jsimplon_Object *object, const char *key, double number)
-{
-	if (object == NULL || key == NULL)
-		return JSIMPLON_FAILURE;
+	while (status == JSIMPLON_SUCCESS && parser->error_count == 0) {
+		parser->token = jsimplon_lexer_next_token(&parser->lexer);
 
-	return jsimplon_value_set_number(jsimplon_object_add_member_value(object, key), number);
-}
+		if (parser->lexer.error_count > 0)
+			break;
 
-JSIMPLON_DEF int jsimplon_object_add_member_bool(Jsimplon_Object *object, const char *key, bool bool_value)
-{
-	if (object == NULL || key == NULL)
-		return JSIMPLON_FAILURE;
+		status = jsimplon_sax_step(&sax);
 
-	return jsimplon_value_set_bool(jsimplon_object_add_member_value(object, key), bool_value);
-}
+		if (parser->token.type == JSIMPLON_TOKEN_END)
+			break;
+	}
 
-JSIMPLON_DEF int jsimplon_object_add_member_null(Jsimplon_Object *object, const char *key)
-{
-	if (object == NULL || key == NULL)
-		return JSIMPLON_FAILURE;
+	free(sax.is_object);
 
-	return jsimplon_value_set_null(jsimplon_object_add_member_value(object, key));
-}
+	if (parser->lexer.error_count > 0 || parser->error_count > 0) {
+		if (parser->lexer.error_count > 0) {
+			jsimplon_append_str(
+				error, &error_size,
+				"lexer generated %u error(s)\n",
+				parser->lexer.error_count
+			);
+		}
 
-JSIMPLON_DEF Jsimplon_Object *jsimplon_object_add_member_object(Jsimplon_Object *object, const char *key)
-{
-	if (object == NULL || key == NULL)
-		return NULL;
+		if (parser->error_count > 0) {
+			jsimplon_append_str(
+				error, &error_size,
+				"parser generated %u error(s)\n",
+				parser->error_count
+			);
+		}
 
-	return jsimplon_value_set_object(jsimplon_object_add_member_value(object, key));
+		return JSIMPLON_FAILURE;
+	}
+
+	if (error != NULL) {
+		free(*error);
+		*error = NULL;
+	}
+
+	return status;
 }
 
-JSIMPLON_DEF Jsimplon_Array *jsimplon_object_add_member_array(Jsimplon_Object *object, const char *key)
+JSIMPLON_DEF double jsimplon_number_from_slice(const char *literal, size_t length)
 {
-	if (object == NULL || key == NULL)
-		return NULL;
+	if (literal == NULL || length == 0)
+		return INFINITY;
 
-	return jsimplon_value_set_array(jsimplon_object_add_member_value(object, key));
+	return jsimplon_number_parse(literal, length);
 }
 
-JSIMPLON_DEF int jsimplon_object_remove_member(Jsimplon_Object *object, const char *key)
+// The same loop as jsimplon_unescape, but the slice may not have come from the lexer so escapes are checked
+JSIMPLON_DEF int jsimplon_string_from_slice(const char *str, size_t length, char *out, size_t *out_len)
 {
-	if (object == NULL || key == NULL)
+	if ((str == NULL && length > 0) || out == NULL)
 		return JSIMPLON_FAILURE;
 
-	for (uint32_t i = 0; i < object->members_count; ++i) {
-		Jsimplon_Member *member = &object->members[i];
+	char *dst = out;
+	size_t index = 0;
 
-		if (strcmp(member->key, key) == 0) {
-			free(member->key);
-			jsimplon_value_destroy(&member->value);
+	while (true) {
+		size_t span = jsimplon_copy_span(dst, str, index, length);
+		dst += span;
+		index += span;
 
-			if (i < object->members_count - 1)
-				memmove(&object->members[i], &object->members[i + 1], (object->members_count - i - 1) * (sizeof *object->members));
+		if (index >= length)
+			break;
 
-			--object->members_count;
+		char decoded[4];
+		size_t escape_length;
+		size_t decoded_length = jsimplon_escape_decode(str, index, length, decoded, &escape_length, false);
 
-			return JSIMPLON_SUCCESS;
-		}
-	}
+		if (decoded_length == 0)
+			return JSIMPLON_FAILURE;
 
-	return JSIMPLON_FAILURE;
-}
+		memcpy(dst, decoded, decoded_length);
+		dst += decoded_length;
+		index += escape_length;
+	}
 
-JSIMPLON_DEF int jsimplon_member_set_key(Jsimplon_Member *member, const char *new_key)
-{
-	if (member == NULL || new_key == NULL)
-		return JSIMPLON_FAILURE;
+	*dst = '\0';
 
-	member->key = malloc(strlen(new_key) + 1);
-	strcpy(member->key, new_key);
+	if (out_len != NULL)
+		*out_len = (size_t)(dst - out);
 
 	return JSIMPLON_SUCCESS;
 }
 
-JSIMPLON_DEF Jsimplon_Value *jsimplon_member_set_value(Jsimplon_Member *member)
+// Same states as jsimplon_parser_step, events go out instead of nodes being built
+JSIMPLON_DEF_INTERNAL int jsimplon_sax_step(Jsimplon_SaxParser *sax)
 {
-	if (member == NULL)
-		return NULL;
+	Jsimplon_Parser *parser = &sax->parser;
+	Jsimplon_TokenType type = parser->token.type;
+	bool is_object = sax->depth > 0 && (sax->is_object[(sax->depth - 1) / 64] >> ((sax->depth - 1) % 64) & 1);
+
+	switch (parser->expecting) {
+		case JSIMPLON_EXPECT_ROOT:
+			if (type != JSIMPLON_TOKEN_LBRACE && type != JSIMPLON_TOKEN_LBRACKET) {
+				jsimplon_parser_expected_token(parser, "'{' or '['");
+				break;
+			}
 
-	return &member->value;
-}
+			return jsimplon_sax_value(sax);
+		case JSIMPLON_EXPECT_ELEMENT:
+			// ']' after a ',' would be a trailing comma
+			if (type == JSIMPLON_TOKEN_RBRACKET && sax->is_empty)
+				return jsimplon_sax_close(sax, false);
+
+			return jsimplon_sax_value(sax);
+		case JSIMPLON_EXPECT_VALUE:
+			return jsimplon_sax_value(sax);
+		case JSIMPLON_EXPECT_KEY:
+			// '}' after a ',' would be a trailing comma
+			if (type == JSIMPLON_TOKEN_RBRACE && sax->is_empty)
+				return jsimplon_sax_close(sax, true);
+
+			if (type != JSIMPLON_TOKEN_STRING_LITERAL) {
+				jsimplon_parser_expected_token(parser, "string literal");
+				break;
+			}
 
-JSIMPLON_DEF int jsimplon_member_set_str(Jsimplon_Member *member, const char *str)
-{
-	if (member == NULL)
-		return JSIMPLON_FAILURE;
+			sax->is_empty = false;
+			parser->expecting = JSIMPLON_EXPECT_COLON;
 
-	return jsimplon_value_set_str(&member->value, str);
-}
+			if (sax->handler->key != NULL)
+				return sax->handler->key(sax->context, parser->token.value, parser->token.length);
 
-JSIMPLON_DEF int jsimplon_member_set_number(Jsimplon_Member *member, double number)
-{
-	if (member == NULL)
-		return JSIMPLON_FAILURE;
+			break;
+		case JSIMPLON_EXPECT_COLON:
+			if (type != JSIMPLON_TOKEN_COLON) {
+				jsimplon_parser_expected_token(parser, "':'");
+				break;
+			}
 
-	return jsimplon_value_set_number(&member->value, number);
-}
+			parser->expecting = JSIMPLON_EXPECT_VALUE;
+			break;
+		case JSIMPLON_EXPECT_NEXT:
+			if (sax->depth == 0) {
+				if (type != JSIMPLON_TOKEN_END)
+					jsimplon_parser_expected_token(parser, "the end of the input");
 
-JSIMPLON_DEF int jsimplon_member_set_bool(Jsimplon_Member *member, bool bool_value)
-{
-	if (member == NULL)
-		return JSIMPLON_FAILURE;
+				break;
+			}
 
-	return jsimplon_value_set_bool(&member->value, bool_value);
-}
+			if (type == JSIMPLON_TOKEN_COMMA)
+				parser->expecting = is_object ? JSIMPLON_EXPECT_KEY : JSIMPLON_EXPECT_ELEMENT;
+			else if (type == (is_object ? JSIMPLON_TOKEN_RBRACE : JSIMPLON_TOKEN_RBRACKET))
+				return jsimplon_sax_close(sax, is_object);
+			else
+				jsimplon_parser_expected_token(parser, is_object ? "',' or '}'" : "',' or ']'");
 
-JSIMPLON_DEF int jsimplon_member_set_null(Jsimplon_Member *member)
-{
-	if (member == NULL)
-		return JSIMPLON_FAILURE;
+			break;
+	}
 
-	return jsimplon_value_set_null(&member->value);
+	return JSIMPLON_SUCCESS;
 }
 
-JSIMPLON_DEF Jsimplon_Object *jsimplon_member_set_object(Jsimplon_Member *member)
+JSIMPLON_DEF_INTERNAL int jsimplon_sax_value(Jsimplon_SaxParser *sax)
 {
-	if (member == NULL)
-		return NULL;
+	Jsimplon_Parser *parser = &sax->parser;
+	const Jsimplon_SaxHandler *handler = sax->handler;
+	Jsimplon_Token *token = &parser->token;
 
-	return jsimplon_value_set_object(&member->value);
-}
+	sax->is_empty = false;
+	parser->expecting = JSIMPLON_EXPECT_NEXT;
 
-JSIMPLON_DEF Jsimplon_Array *jsimplon_member_set_array(Jsimplon_Member *member)
-{
-	if (member == NULL)
-		return NULL;
+	switch (token->type) {
+		case JSIMPLON_TOKEN_LBRACE:
+		case JSIMPLON_TOKEN_LBRACKET: {
+			if (sax->depth == parser->max_depth) {
+				jsimplon_parser_too_deep(parser, token->line, token->column);
+				break;
+			}
 
-	return jsimplon_value_set_array(&member->value);
-}
+			bool is_object = token->type == JSIMPLON_TOKEN_LBRACE;
+			uint64_t bit = 1ULL << (sax->depth % 64);
 
-JSIMPLON_DEF Jsimplon_Value *jsimplon_array_push_value(Jsimplon_Array *array)
-{
-	if (array == NULL)
-		return NULL;
+			if (is_object)
+				sax->is_object[sax->depth / 64] |= bit;
+			else
+				sax->is_object[sax->depth / 64] &= ~bit;
 
-	array->values = realloc(array->values, (array->values_count + 1) * (sizeof *array->values));
-	Jsimplon_Value *value = &array->values[array->values_count++];
-	*value = (Jsimplon_Value) { 0 };
+			++sax->depth;
+			sax->is_empty = true;
+			parser->expecting = is_object ? JSIMPLON_EXPECT_KEY : JSIMPLON_EXPECT_ELEMENT;
 
-	return value;
-}
+			if (is_object && handler->object_begin != NULL)
+				return handler->object_begin(sax->context);
+			if (!is_object && handler->array_begin != NULL)
+				return handler->array_begin(sax->context);
 
-JSIMPLON_DEF int jsimplon_array_push_str(Jsimplon_Array *array, const char *str)
-{
-	return jsimplon_value_set_str(jsimplon_array_push_value(array), str);
-}
+			break;
+		}
+		case JSIMPLON_TOKEN_STRING_LITERAL:
+			if (handler->string != NULL)
+				return handler->string(sax->context, token->value, token->length);
+			break;
+		case JSIMPLON_TOKEN_NUMBER_LITERAL:
+			if (handler->number != NULL)
+				return handler->number(sax->context, token->value, token->length);
+			break;
+		case JSIMPLON_TOKEN_TRUE:
+		case JSIMPLON_TOKEN_FALSE:
+			if (handler->bool_value != NULL)
+				return handler->bool_value(sax->context, token->type == JSIMPLON_TOKEN_TRUE);
+			break;
+		case JSIMPLON_TOKEN_NULL:
+			if (handler->null_value != NULL)
+				return handler->null_value(sax->context);
+			break;
+		default:
+			jsimplon_parser_expected_token(parser, "JSON value");
+			break;
+	}
 
-JSIMPLON_DEF int jsimplon_array_push_number(Jsimplon_Array *array, double number)
-{
-	return jsimplon_value_set_number(jsimplon_array_push_value(array), number);
+	return JSIMPLON_SUCCESS;
 }
 
-JSIMPLON_DEF int jsimplon_array_push_bool(Jsimplon_Array *array, bool bool_value)
+JSIMPLON_DEF_INTERNAL int jsimplon_sax_close(Jsimplon_SaxParser *sax, bool is_object)
 {
-	return jsimplon_value_set_bool(jsimplon_array_push_value(array), bool_value);
-}
+	--sax->depth;
+	sax->is_empty = false;
+	sax->parser.expecting = JSIMPLON_EXPECT_NEXT;
 
-JSIMPLON_DEF int jsimplon_array_push_null(Jsimplon_Array *array)
-{
-	return jsimplon_value_set_null(jsimplon_array_push_value(array));
-}
+	if (is_object && sax->handler->object_end != NULL)
+		return sax->handler->object_end(sax->context);
+	if (!is_object && sax->handler->array_end != NULL)
+		return sax->handler->array_end(sax->context);
 
-JSIMPLON_DEF Jsimplon_Object *jsimplon_array_push_object(Jsimplon_Array *array)
-{
-	return jsimplon_value_set_object(jsimplon_array_push_value(array));
+	return JSIMPLON_SUCCESS;
 }
 
-JSIMPLON_DEF Jsimplon_Array *jsimplon_array_push_array(Jsimplon_Array *array)
+JSIMPLON_DEF int jsimplon_ndjson_parse(char **error, const char *src, size_t src_len, Jsimplon_NdjsonCallback callback, void *context, const Jsimplon_Options *options)
 {
-	return jsimplon_value_set_array(jsimplon_array_push_value(array));
-}
+	if (error != NULL)
+		*error = NULL;
 
-JSIMPLON_DEF Jsimplon_Value *jsimplon_array_insert_value_at_index(Jsimplon_Array *array, size_t index)
-{
-	if (array == NULL)
-		return NULL;
+	if (src == NULL || callback == NULL)
+		return JSIMPLON_FAILURE;
 
-	array->values = realloc(array->values, (array->values_count + 1) * (sizeof *array->values)); 
+	uint32_t thread_count = options != NULL && options->thread_count != 0 ? options->thread_count : jsimplon_cpu_count();
 
-	if (index >= array->values_count)
-		return jsimplon_array_push_value(array);
+	Jsimplon_NdjsonJob job = {
+		.src          = src,
+		.src_len      = src_len,
+		.options      = options,
+		.blocks_count = (size_t)thread_count * 4
+	};
+	job.blocks = calloc(job.blocks_count, sizeof *job.blocks);
 
-	memmove(&array->values[index + 1], &array->values[index], (array->values_count - index) * (sizeof *array->values));
+	// The calling thread only parses when there are no workers
+	Jsimplon_Parser parser = { 0 };
+	size_t parser_error_size = 1;
+	char *parser_error = calloc(parser_error_size, (sizeof *parser_error));
 
-	Jsimplon_Value *value = &array->values[array->values_count++];
-	*value = (Jsimplon_Value) { 0 };
+	uint32_t worker_count = 0;
 
-	return value;
-}
+#ifdef JSIMPLON_THREADS
+	thrd_t *workers = NULL;
 
-JSIMPLON_DEF int jsimplon_array_remove_value_at_index(Jsimplon_Array *array, size_t index)
-{
-	if (array == NULL || index >= array->values_count - 1)
-		return JSIMPLON_FAILURE;
+	if (thread_count > 1 && src_len > JSIMPLON_NDJSON_BLOCK_SIZE) {
+		mtx_init(&job.mutex, mtx_plain);
+		cnd_init(&job.block_done);
+		cnd_init(&job.block_delivered);
 
-	if (index < array->values_count - 1)
-		memmove(&array->values[index], &array->values[index + 1], (array->values_count - index - 1) * (sizeof *array->values));
+		workers = malloc(thread_count * sizeof *workers);
 
-	--array->values_count;
+		while (worker_count < thread_count && thrd_create(&workers[worker_count], jsimplon_ndjson_worker, &job) == thrd_success)
+			++worker_count;
+	}
+#endif
 
-	return JSIMPLON_SUCCESS;
-}
+	size_t line = 1;
+	size_t failed_count = 0;
+	int status = JSIMPLON_SUCCESS;
 
-JSIMPLON_DEF Jsimplon_ValueType jsimplon_value_get_type(Jsimplon_Value *value)
-{
-	return value->type;
-}
+	for (size_t index = 0;; ++index) {
+		Jsimplon_NdjsonBlock *block = &job.blocks[index % job.blocks_count];
 
-JSIMPLON_DEF Jsimplon_Object *jsimplon_value_get_object(Jsimplon_Value *value)
-{
-	if (value == NULL)
-		return NULL;
+		if (worker_count == 0) {
+			if (job.next_offset >= src_len || status != JSIMPLON_SUCCESS)
+				break;
 
-	return &value->object_value;
-}
+			size_t begin = job.next_offset;
+			job.next_offset = jsimplon_ndjson_block_end(src, begin, src_len);
 
-JSIMPLON_DEF Jsimplon_Array *jsimplon_value_get_array(Jsimplon_Value *value)
-{
-	if (value == NULL)
-		return NULL;
+			jsimplon_ndjson_parse_block(&job, block, begin, job.next_offset, &parser, &parser_error, &parser_error_size);
+			jsimplon_ndjson_deliver(block, &line, callback, context, &status, &failed_count);
 
-	return &value->array_value;
-}
+			continue;
+		}
 
-JSIMPLON_DEF const char *jsimplon_value_get_str(Jsimplon_Value *value)
-{
-	if (value == NULL)
-		return NULL;
+#ifdef JSIMPLON_THREADS
+		// Blocks already handed to a worker are waited for even after a stop so that their trees get destroyed
+		mtx_lock(&job.mutex);
+		while (!block->is_done && (index < job.next_block || (!job.is_stopping && job.next_offset < src_len)))
+			cnd_wait(&job.block_done, &job.mutex);
+		mtx_unlock(&job.mutex);
 
-	return value->string_value;
-}
+		if (!block->is_done)
+			break;
 
-JSIMPLON_DEF double jsimplon_value_get_number(Jsimplon_Value *value)
-{
-	if (value == NULL)
-		return INFINITY;
+		jsimplon_ndjson_deliver(block, &line, callback, context, &status, &failed_count);
 
-	return value->number_value;
-}
+		mtx_lock(&job.mutex);
+		block->is_done = false;
+		++job.delivered_count;
+		job.is_stopping = status != JSIMPLON_SUCCESS;
+		cnd_broadcast(&job.block_delivered);
+		mtx_unlock(&job.mutex);
+#endif
+	}
 
-JSIMPLON_DEF int jsimplon_value_get_bool(Jsimplon_Value *value)
-{
-	if (value == NULL)
-		return -1;
+#ifdef JSIMPLON_THREADS
+	for (uint32_t i = 0; i < worker_count; ++i)
+		thrd_join(workers[i], NULL);
 
-	return value->bool_value;
-}
+	if (workers != NULL) {
+		cnd_destroy(&job.block_delivered);
+		cnd_destroy(&job.block_done);
+		mtx_destroy(&job.mutex);
+		free(workers);
+	}
+#endif
 
-JSIMPLON_DEF Jsimplon_Member *jsimplon_object_get_member(Jsimplon_Object *object, const char *key)
-{
-	if (object == NULL || key == NULL)
-		return NULL;
+	for (size_t i = 0; i < job.blocks_count; ++i)
+		free(job.blocks[i].records);
+	free(job.blocks);
+	free(parser.stack);
+	free(parser_error);
 
-	for (size_t i = 0; i < object->members_count; ++i) {
-		Jsimplon_Member *member = &object->members[i];
+	if (status != JSIMPLON_SUCCESS)
+		return status;
 
-		if (strcmp(member->key, key) == 0)
-			return member;
+	if (failed_count > 0) {
+		size_t error_size = 1;
+		if (error != NULL)
+			*error = calloc(error_size, (sizeof *(*error)));
+
+		jsimplon_append_str(
+			error, &error_size,
+			"ndjson error: %zu record(s) failed to parse\n",
+			failed_count
+		);
+
+		return JSIMPLON_FAILURE;
 	}
 
-	return NULL;
+	return JSIMPLON_SUCCESS;
 }
 
-JSIMPLON_DEF size_t jsimplon_object_get_member_count(Jsimplon_Object *object)
+// Blocks end right after a newline, JSON strings can't hold one so a record never straddles two blocks
+JSIMPLON_DEF_INTERNAL size_t jsimplon_ndjson_block_end(const char *src, size_t begin, size_t src_len)
 {
-	if (object == NULL)
-		return 0;
+	if (src_len - begin <= JSIMPLON_NDJSON_BLOCK_SIZE)
+		return src_len;
 
-	return object->members_count;
+	const char *newline = memchr(&src[begin + JSIMPLON_NDJSON_BLOCK_SIZE], '\n', src_len - begin - JSIMPLON_NDJSON_BLOCK_SIZE);
+
+	return newline != NULL ? (size_t)(newline - src) + 1 : src_len;
 }
 
-JSIMPLON_DEF Jsimplon_Member *jsimplon_object_get_member_at_index(Jsimplon_Object *object, size_t index)
+// Lines with nothing but whitespace on them aren't records
+JSIMPLON_DEF_INTERNAL void jsimplon_ndjson_parse_block(Jsimplon_NdjsonJob *job, Jsimplon_NdjsonBlock *block, size_t begin, size_t end, Jsimplon_Parser *parser, char **error, size_t *error_size)
 {
-	if (object == NULL)
-		return NULL;
-
-	if (index >= object->members_count)
-		return NULL;
+	const char *src = job->src;
 
-	return &object->members[index];
-}
+	block->records_count = 0;
+	block->line_count = 0;
 
-JSIMPLON_DEF Jsimplon_ValueType jsimplon_object_member_get_type(Jsimplon_Object *object, const char *key)
-{
-	return jsimplon_value_get_type(jsimplon_object_member_get_value(object, key));
-}
+	for (size_t i = begin; i < end; ++block->line_count) {
+		const char *newline = memchr(&src[i], '\n', end - i);
+		size_t line_end = newline != NULL ? (size_t)(newline - src) : end;
 
-JSIMPLON_DEF Jsimplon_Value *jsimplon_object_member_get_value(Jsimplon_Object *object, const char *key)
-{
-	return &jsimplon_object_get_member(object, key)->value;
-}
+		uint32_t newline_count = 0;
+		size_t last_newline;
 
-JSIMPLON_DEF Jsimplon_Object *jsimplon_object_member_get_object(Jsimplon_Object *object, const char *key)
-{
-	return jsimplon_value_get_object(jsimplon_object_member_get_value(object, key));
-}
+		if (jsimplon_scan_whitespace(src, i, line_end, &newline_count, &last_newline) < line_end) {
+			if (block->records_count == block->records_size) {
+				block->records_size = block->records_size < 64 ? 64 : block->records_size * 2;
+				block->records = realloc(block->records, block->records_size * sizeof *block->records);
+			}
 
-JSIMPLON_DEF Jsimplon_Array *jsimplon_object_member_get_array(Jsimplon_Object *object, const char *key)
-{
-	return jsimplon_value_get_array(jsimplon_object_member_get_value(object, key));
-}
+			Jsimplon_NdjsonRecord *record = &block->records[block->records_count++];
 
-JSIMPLON_DEF const char *jsimplon_object_member_get_str(Jsimplon_Object *object, const char *key)
-{
-	return jsimplon_value_get_str(jsimplon_object_member_get_value(object, key));
-}
+			// A record can be any value, unlike a document
+			(*error)[0] = 0;
+			parser->allows_scalar_root = true;
+			*record = (Jsimplon_NdjsonRecord){
+				.tree = jsimplon_tree_parse_with(parser, error, error_size, &src[i], line_end - i, NULL, job->options),
+				.line = block->line_count
+			};
 
-JSIMPLON_DEF double jsimplon_object_member_get_number(Jsimplon_Object *object, const char *key)
-{
-	return jsimplon_value_get_number(jsimplon_object_member_get_value(object, key));
-}
+			if (record->tree == NULL)
+				record->error = jsimplon_document_strdup(NULL, *error);
+		}
 
-JSIMPLON_DEF int jsimplon_object_member_get_bool(Jsimplon_Object *object, const char *key)
-{
-	return jsimplon_value_get_bool(jsimplon_object_member_get_value(object, key));
+		i = line_end + 1;
+	}
 }
 
-JSIMPLON_DEF const char *jsimplon_member_get_key(Jsimplon_Member *member)
+// After a stop the rest of the trees are only destroyed
+JSIMPLON_DEF_INTERNAL void jsimplon_ndjson_deliver(Jsimplon_NdjsonBlock *block, size_t *line, Jsimplon_NdjsonCallback callback, void *context, int *status, size_t *failed_count)
 {
-	if (member == NULL)
-		return NULL;
+	for (uint32_t i = 0; i < block->records_count; ++i) {
+		Jsimplon_NdjsonRecord *record = &block->records[i];
 
-	return member->key;
-}
+		if (*status == JSIMPLON_SUCCESS) {
+			*failed_count += record->tree == NULL;
+			*status = callback(context, *line + record->line, record->tree, record->error);
+		}
+		else if (record->tree != NULL) {
+			jsimplon_tree_destroy(record->tree);
+		}
 
-JSIMPLON_DEF Jsimplon_Value *jsimplon_member_get_value(Jsimplon_Member *member)
-{
-	if (member == NULL)
-		return NULL;
+		free(record->error);
+	}
 
-	return &member->value;
+	*line += block->line_count;
+	block->records_count = 0;
 }
 
-JSIMPLON_DEF const char *jsimplon_member_get_str(Jsimplon_Member *member)
+#ifdef JSIMPLON_THREADS
+JSIMPLON_DEF_INTERNAL int jsimplon_ndjson_worker(void *job_ptr)
 {
-	if (member == NULL)
-		return NULL;
+	Jsimplon_NdjsonJob *job = job_ptr;
 
-	return jsimplon_value_get_str(&member->value);
-}
+	Jsimplon_Parser parser = { 0 };
+	size_t error_size = 1;
+	char *error = calloc(error_size, (sizeof *error));
 
-JSIMPLON_DEF double jsimplon_member_get_number(Jsimplon_Member *member)
-{
-	if (member == NULL)
-		return INFINITY;
+	mtx_lock(&job->mutex);
 
-	return jsimplon_value_get_number(&member->value);
-}
+	while (true) {
+		while (!job->is_stopping && job->next_offset < job->src_len && job->next_block == job->delivered_count + job->blocks_count)
+			cnd_wait(&job->block_delivered, &job->mutex);
 
-JSIMPLON_DEF int jsimplon_member_get_bool(Jsimplon_Member *member)
-{
-	if (member == NULL)
-		return -1;
+		if (job->is_stopping || job->next_offset >= job->src_len)
+			break;
 
-	return jsimplon_value_get_bool(&member->value);
-}
+		Jsimplon_NdjsonBlock *block = &job->blocks[job->next_block++ % job->blocks_count];
+		size_t begin = job->next_offset;
+		size_t end = jsimplon_ndjson_block_end(job->src, begin, job->src_len);
+		job->next_offset = end;
 
-JSIMPLON_DEF Jsimplon_Object *jsimplon_member_get_object(Jsimplon_Member *member)
-{
-	if (member == NULL)
-		return NULL;
+		mtx_unlock(&job->mutex);
+		jsimplon_ndjson_parse_block(job, block, begin, end, &parser, &error, &error_size);
+		mtx_lock(&job->mutex);
 
-	return jsimplon_value_get_object(&member->value);
-}
+		block->is_done = true;
+		cnd_broadcast(&job->block_done);
+	}
 
-JSIMPLON_DEF Jsimplon_Array *jsimplon_member_get_array(Jsimplon_Member *member)
-{
-	if (member == NULL)
-		return NULL;
+	mtx_unlock(&job->mutex);
 
-	return jsimplon_value_get_array(&member->value);
+	free(parser.stack);
+	free(error);
+
+	return 0;
 }
 
-JSIMPLON_DEF size_t jsimplon_array_get_count(Jsimplon_Array *array)
+// Parses a root array chunk by chunk on several threads and puts the elements back together in order
+JSIMPLON_DEF_INTERNAL Jsimplon_Value *jsimplon_tree_parse_split(const char *src, size_t src_len, const Jsimplon_Options *options)
 {
-	if (array == NULL)
-		return 0;
+	uint32_t thread_count = options->thread_count != 0 ? options->thread_count : jsimplon_cpu_count();
 
-	return array->values_count;
-}
+	size_t chunks_count = (size_t)thread_count * 4;
+	if (chunks_count > src_len / JSIMPLON_SPLIT_CHUNK_SIZE)
+		chunks_count = src_len / JSIMPLON_SPLIT_CHUNK_SIZE;
 
-JSIMPLON_DEF Jsimplon_Value *jsimplon_array_get_value_at_index(Jsimplon_Array *array, size_t index)
-{
-	if (array == NULL)
+	if (thread_count < 2 || chunks_count < 2)
 		return NULL;
 
-	if (index >= array->values_count)
+	size_t *splits = malloc((chunks_count + 1) * sizeof *splits);
+	size_t splits_count = jsimplon_split_root_array(src, src_len, splits, chunks_count + 1);
+
+	// One big element or something that isn't an array at all
+	if (splits_count < 3) {
+		free(splits);
 		return NULL;
+	}
 
-	return &array->values[index];
-}
+	Jsimplon_Value *tree = jsimplon_tree_root_create_ex(options);
+	Jsimplon_Document *document = jsimplon_tag_document(tree->tag);
 
-JSIMPLON_DEF_INTERNAL Jsimplon_Value jsimplon_parser_parse_value(Jsimplon_Parser *parser)
-{
-	Jsimplon_Value value = { 0 };
+	Jsimplon_SplitJob job = {
+		.src          = src,
+		.options      = options,
+		.document     = document,
+		.chunks_count = splits_count - 1
+	};
+	job.chunks = calloc(job.chunks_count, sizeof *job.chunks);
+
+	for (size_t i = 0; i < job.chunks_count; ++i) {
+		job.chunks[i].begin = splits[i] + 1;
+		job.chunks[i].end = splits[i + 1];
+		job.chunks[i].allocator.use_arena = document->use_arena;
+		job.chunks[i].allocator.intern_strings = document->intern_strings;
+		job.chunks[i].elements = (Jsimplon_Value){ .tag = (uintptr_t)document };
+		jsimplon_value_open(&job.chunks[i].elements, &job.chunks[i].allocator, JSIMPLON_VALUE_ARRAY);
+	}
 
-	if (parser->is_at_beginning) {
-		parser->is_at_beginning = false;
+	free(splits);
 
-		if (parser->token.type != JSIMPLON_TOKEN_LBRACE && parser->token.type != JSIMPLON_TOKEN_LBRACKET) {
-			jsimplon_append_str(
-				parser->lexer.error, parser->lexer.error_size,
-				"parser error: %u:%u: expected '{' or '[', got '%s'\n",
-				parser->token.line, parser->token.column,
-				jsimplon_token_to_str(parser->token)
-			);
-			++parser->error_count;
+	// The calling thread works on chunks as well
+	uint32_t worker_count = 0;
+	thrd_t *workers = malloc(thread_count * sizeof *workers);
 
-			return value;
-		}
-	}
+	mtx_init(&job.mutex, mtx_plain);
 
-	switch (parser->token.type) {
-		case JSIMPLON_TOKEN_END:
-			break;
-		case JSIMPLON_TOKEN_STRING_LITERAL:
-			value.type = JSIMPLON_VALUE_STRING;
-			value.string_value = parser->token.value;
-			break;
-		case JSIMPLON_TOKEN_NUMBER_LITERAL:
-			value.type = JSIMPLON_VALUE_NUMBER;
-			value.number_value = strtod(parser->token.value, NULL);
-			free(parser->token.value);
-			break;
-		case JSIMPLON_TOKEN_TRUE:
-			value.type = JSIMPLON_VALUE_BOOL;
-			value.bool_value = true;
-			break;
-		case JSIMPLON_TOKEN_FALSE:
-			value.type = JSIMPLON_VALUE_BOOL;
-			value.bool_value = false;
-			break;
-		case JSIMPLON_TOKEN_NULL:
-			value.type = JSIMPLON_VALUE_NULL;
-			value.null_value = NULL;
-			break;
-		case JSIMPLON_TOKEN_LBRACE:
-			value.type = JSIMPLON_VALUE_OBJECT;
-			value.object_value = jsimplon_parser_parse_object(parser);
-			break;
-		case JSIMPLON_TOKEN_LBRACKET:
-			value.type = JSIMPLON_VALUE_ARRAY;
-			value.array_value = jsimplon_parser_parse_array(parser);
-			break;
-		default:
-			jsimplon_append_str(
-				parser->lexer.error, parser->lexer.error_size,
-				"parser error: %u:%u: unexpected token: '%s'\n",
-				parser->token.line, parser->token.column,
-				jsimplon_token_to_str(parser->token)
-			);
-			++parser->error_count;
-			break;
-	}
+	while (worker_count + 1 < thread_count && worker_count + 1 < job.chunks_count
+		&& thrd_create(&workers[worker_count], jsimplon_split_worker, &job) == thrd_success)
+		++worker_count;
 
-	return value;
-}
+	jsimplon_split_worker(&job);
 
-JSIMPLON_DEF_INTERNAL Jsimplon_Object jsimplon_parser_parse_object(Jsimplon_Parser *parser)
-{
-	Jsimplon_Object object = { 0 };
-	bool expecting_comma = false;
+	for (uint32_t i = 0; i < worker_count; ++i)
+		thrd_join(workers[i], NULL);
 
-	while (true) {
-		parser->token = jsimplon_lexer_next_token(&parser->lexer);
+	mtx_destroy(&job.mutex);
+	free(workers);
 
-		if (parser->token.type == JSIMPLON_TOKEN_RBRACE)
-			break;
+	size_t values_count = 0;
+	for (size_t i = 0; i < job.chunks_count; ++i)
+		values_count += job.chunks[i].elements.array_value->values_count;
 
-		if (expecting_comma) {
-			expecting_comma = false;
+	bool success = !job.is_stopping && values_count <= UINT32_MAX;
 
-			if (parser->token.type != JSIMPLON_TOKEN_COMMA) {
-				jsimplon_append_str(
-					parser->lexer.error, parser->lexer.error_size,
-					"parser error: %u:%u: expected ',', got '%s'\n",
-					parser->token.line, parser->token.column,
-					jsimplon_token_to_str(parser->token)
-				);
-				++parser->error_count;
-			}
+	if (success) {
+		jsimplon_value_open(tree, document, JSIMPLON_VALUE_ARRAY);
+		jsimplon_array_resize(document, tree->array_value, (uint32_t)values_count);
+	}
 
-			continue;
-		}
+	for (size_t i = 0; i < job.chunks_count; ++i) {
+		Jsimplon_SplitChunk *chunk = &job.chunks[i];
+		Jsimplon_Array *elements = chunk->elements.array_value;
 
-		if (parser->token.type != JSIMPLON_TOKEN_STRING_LITERAL) {
-			jsimplon_append_str(
-				parser->lexer.error, parser->lexer.error_size,
-				"parser error: %u:%u: expected string literal, got '%s'\n",
-				parser->token.line, parser->token.column,
-				jsimplon_token_to_str(parser->token)
-			);
-			++parser->error_count;
+		if (success) {
+			Jsimplon_Array *array = tree->array_value;
 
-			continue;
+			if (elements->values_count > 0)
+				memcpy(&array->values[array->values_count], elements->values, elements->values_count * sizeof *elements->values);
+			array->values_count += elements->values_count;
+
+			jsimplon_array_resize(&chunk->allocator, elements, 0);
+			jsimplon_document_free(&chunk->allocator, elements);
 		}
+		else {
+			jsimplon_value_destroy(&chunk->elements);
+		}
+
+		// Chunks intern on their own, their strings stay where they are and only their slots go
+		jsimplon_arena_splice(&document->arena, chunk->allocator.arena);
+		jsimplon_arena_splice(&document->interns.arena, chunk->allocator.interns.arena);
+		free(chunk->allocator.interns.slots);
+	}
 
-		object.members = realloc(object.members, (object.members_count + 1) * (sizeof *object.members));
-		object.members[object.members_count++] = jsimplon_parser_parse_member(parser);
+	free(job.chunks);
 
-		expecting_comma = true;
+	if (!success) {
+		jsimplon_tree_destroy(tree);
+		return NULL;
 	}
 
-	return object;
+	return tree;
 }
 
-JSIMPLON_DEF_INTERNAL Jsimplon_Member jsimplon_parser_parse_member(Jsimplon_Parser *parser)
+// A quote and depth aware scan for where to cut a root array: splits[0] is its '[', the ones in between are ','s
+// between two of its elements, the first found at or after each of the evenly spaced targets, and the last is its ']'.
+// Returns how many there are, 0 if src isn't an array. Whether the pieces are valid is up to the chunk parsers
+JSIMPLON_DEF_INTERNAL size_t jsimplon_split_root_array(const char *src, size_t src_len, size_t *splits, size_t splits_size)
 {
-	Jsimplon_Member member = { 0 };
+	uint32_t newline_count = 0;
+	size_t last_newline;
 
-	member.key = parser->token.value;
-	
-	parser->token = jsimplon_lexer_next_token(&parser->lexer);
+	size_t begin = jsimplon_scan_whitespace(src, 0, src_len, &newline_count, &last_newline);
+	size_t end = src_len;
 
-	if (parser->token.type != JSIMPLON_TOKEN_COLON) {
-		jsimplon_append_str(
-			parser->lexer.error, parser->lexer.error_size,
-			"parser error: %u:%u: expected ':', got '%s'\n",
-			parser->token.line, parser->token.column,
-			jsimplon_token_to_str(parser->token)
-		);
-		++parser->error_count;
-	}
-	else {
-		parser->token = jsimplon_lexer_next_token(&parser->lexer);
-		member.value = jsimplon_parser_parse_value(parser);
-	}
+	// Only whitespace may follow the array, so its ']' is the last thing in src
+	while (end > begin && jsimplon_char_classes[(uint8_t)src[end - 1]] == JSIMPLON_CHAR_WHITESPACE)
+		--end;
 
+	if (end - begin < 2 || src[begin] != '[' || src[end - 1] != ']')
+		return 0;
 
-	return member;
-}
+	--end;
 
-JSIMPLON_DEF_INTERNAL Jsimplon_Array jsimplon_parser_parse_array(Jsimplon_Parser *parser)
-{
-	Jsimplon_Array array = { 0 };
-	bool expecting_comma = false;
+	size_t splits_count = 0;
+	splits[splits_count++] = begin;
 
-	while (true) {
-		parser->token = jsimplon_lexer_next_token(&parser->lexer);
+	uint64_t next_is_escaped = 0;
+	uint64_t prev_in_string = 0;
+	int64_t depth = 0;
 
-		if (parser->token.type == JSIMPLON_TOKEN_RBRACKET)
-			break;
+	size_t target_count = splits_size - 1;
+	size_t target_index = 1;
+	size_t target = begin + (end - begin) / target_count;
 
-		if (parser->token.type == JSIMPLON_TOKEN_END) {
-			jsimplon_append_str(
-				parser->lexer.error, parser->lexer.error_size,
-				"parser error: %u:%u: expected JSON value, got '%s'\n",
-				parser->token.line, parser->token.column,
-				jsimplon_token_to_str(parser->token)
-			);
-			++parser->error_count;
+	for (size_t base = begin; base < end && target_index < target_count; base += 64) {
+		char padded[64];
+		const char *block = &src[base];
 
-			break;
+		if (end - base < 64) {
+			memset(padded, ' ', sizeof padded);
+			memcpy(padded, block, end - base);
+			block = padded;
 		}
 
-		if (expecting_comma) {
-			expecting_comma = false;
-
-			if (parser->token.type != JSIMPLON_TOKEN_COMMA) {
-				jsimplon_append_str(
-					parser->lexer.error, parser->lexer.error_size,
-					"parser error: %u:%u: expected ',', got '%s'\n",
-					parser->token.line, parser->token.column,
-					jsimplon_token_to_str(parser->token)
-				);
-				++parser->error_count;
+		Jsimplon_BlockMasks masks = jsimplon_classify_block(block);
 
-			}
+		uint64_t quote = masks.quote & ~jsimplon_find_escaped(masks.backslash, &next_is_escaped);
+		uint64_t in_string = jsimplon_prefix_xor(quote) ^ prev_in_string;
+		prev_in_string = 0 - (in_string >> 63);
 
+		// Blocks short of the next target only move the depth, so they're counted rather than walked
+		if (base + 64 <= target) {
+			depth += (int64_t)jsimplon_popcount64(masks.open & ~in_string) - (int64_t)jsimplon_popcount64(masks.close & ~in_string);
 			continue;
 		}
 
-		array.values = realloc(array.values, (array.values_count + 1) * (sizeof *array.values));
-		array.values[array.values_count++] = jsimplon_parser_parse_value(parser);
+		for (uint64_t structurals = masks.structural & ~in_string; structurals != 0; structurals &= structurals - 1) {
+			size_t offset = base + jsimplon_ctz64(structurals);
+
+			switch (src[offset]) {
+				case '{':
+				case '[':
+					++depth;
+					break;
+				case '}':
+				case ']':
+					--depth;
+					break;
+				case ',':
+					if (depth != 1 || offset < target || target_index == target_count)
+						break;
+
+					splits[splits_count++] = offset;
 
-		expecting_comma = true;
+					// A long element may have run past more than one target
+					while (target_index < target_count && target <= offset)
+						target = begin + (end - begin) / target_count * ++target_index;
+
+					break;
+				default:
+					break;
+			}
+		}
 	}
 
-	return array;
-}
+	splits[splits_count++] = end;
 
-/*
- ** TODO: Refactor lexer to remove spaghetti code!!! **
+	return splits_count;
+}
 
-JSIMPLON_DEF_INTERNAL Jsimplon_Token jsimplon_lexer_next_token(Jsimplon_Lexer *l)
+// The chunk's elements are parsed into an array of its own as if it was the root, which is all open when it's done
+JSIMPLON_DEF_INTERNAL void jsimplon_split_parse_chunk(Jsimplon_SplitJob *job, Jsimplon_SplitChunk *chunk, Jsimplon_Parser *parser)
 {
-	char c;
-	size_t lexeme_index;
-	Jsimplon_Token token = {
-		.line = l->line,
-		.column = l->index - l->begin_of_line + 1
-	};
+	Jsimplon_Value **stack = parser->stack;
+	uint32_t stack_size = parser->stack_size;
 
-	while (isspace(c = l->src[l->index]))
-		if (c == '\n') {
-			l->begin_of_line = l->index;
-			++l->line;
-		}
+	*parser = (Jsimplon_Parser){
+		.lexer = {
+			.src       = &job->src[chunk->begin],
+			.src_len   = chunk->end - chunk->begin,
+			.validate_utf8 = job->document->validate_utf8,
+			.document  = job->document,
+			.allocator = &chunk->allocator,
+			.line      = 1
+		},
+		.expecting = JSIMPLON_EXPECT_ELEMENT,
+		.stack = stack,
+		.stack_size = stack_size,
+		.max_depth = job->options->max_depth != 0 ? job->options->max_depth : JSIMPLON_DEFAULT_MAX_DEPTH,
+		.is_lazy = job->options->lazy
+	};
 
-		++l->index;
-	}
+	jsimplon_parser_push(parser, &chunk->elements);
 
-	if (c == '\"') {
-		++l->index;
+	// Errors aren't kept, the document is parsed again as a whole to report them
+	while (parser->error_count == 0) {
+		parser->token = jsimplon_lexer_next_token(&parser->lexer);
 
-		while ((c = l->src[l->index]) != '\"') {
-			
+		if (parser->lexer.error_count > 0) {
+			jsimplon_parser_discard_token(parser);
+			break;
 		}
-	}
 
-	switch (c) {
-		case '\0':
-			break;
-		case '{':
-			token.type = JSIMPLON_TOKEN_LBRACE;
+		if (parser->token.type == JSIMPLON_TOKEN_END)
 			break;
-		case '}':
-			token.type = JSIMPLON_TOKEN_RBRACE;
-			break;
-		case '[':
-			token.type = JSIMPLON_TOKEN_LBRACKET;
-			break;
-		case ']':
-			token.type = JSIMPLON_TOKEN_RBRACKET;
-			break;
-		case ':':
-			token.type = JSIMPLON_TOKEN_COLON;
-			break;
-		case ',':
-			token.type = JSIMPLON_TOKEN_COMMA;
-			break;
-		default:
-			jsimplon_append_str(
-				l->error, l->error_size,
-				"lexer error: %u:%u: stray '%c'\n",
-				token.line, token.column,
-				c
-			);
-			++l->error_count;
 
-			break;
+		jsimplon_parser_step(parser);
 	}
 
-	++l->index;
-
-	return token;
+	chunk->has_failed = parser->error_count > 0 || parser->lexer.error_count > 0
+		|| parser->expecting != JSIMPLON_EXPECT_NEXT || parser->stack_count != 1;
 }
-*/
 
-JSIMPLON_DEF_INTERNAL Jsimplon_Token jsimplon_lexer_next_token(Jsimplon_Lexer *lexer)
+JSIMPLON_DEF_INTERNAL int jsimplon_split_worker(void *job_ptr)
 {
-	size_t lexeme_index;
+	Jsimplon_SplitJob *job = job_ptr;
+	Jsimplon_Parser parser = { 0 };
 
-	bool looking_for_string = false;
-	bool escape_in_effect = false;
+	mtx_lock(&job->mutex);
 
-	bool looking_for_tfl = false; // tfl = true, false, null
+	while (!job->is_stopping && job->next_chunk < job->chunks_count) {
+		Jsimplon_SplitChunk *chunk = &job->chunks[job->next_chunk++];
 
-	bool looking_for_number = false;
-	bool dot_in_effect = false;
-	bool exponent_in_effect = false;
-	bool exponent_neg_in_effect = false;
+		mtx_unlock(&job->mutex);
+		jsimplon_split_parse_chunk(job, chunk, &parser);
+		mtx_lock(&job->mutex);
 
-	Jsimplon_Token token = {
-		.line = lexer->line,
-		.column = lexer->index - lexer->begin_of_line
-	};
+		// One failed chunk fails the document, so there's no point in parsing the rest
+		if (chunk->has_failed)
+			job->is_stopping = true;
+	}
 
-	do {
-	 	char c = lexer->src[lexer->index];
+	mtx_unlock(&job->mutex);
 
-		if (c == 0) {
-			token.type = JSIMPLON_TOKEN_END;
-			break;
-		}
+	free(parser.stack);
 
-		++lexer->index;
+	return 0;
+}
+#endif
 
-		if (looking_for_string) {
-			if (c == '\\') {
-				if (!escape_in_effect) {
-					escape_in_effect = true;
-					continue;
-				}
-			}
-			else if (c == '\"') {
-				if (!escape_in_effect) {
-					looking_for_string = false;
+JSIMPLON_DEF_INTERNAL uint32_t jsimplon_cpu_count(void)
+{
+#if defined(_SC_NPROCESSORS_ONLN)
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (uint32_t)count : 1;
+#else
+	return 1;
+#endif
+}
 
-					token.type = JSIMPLON_TOKEN_STRING_LITERAL;
-					token.value = malloc(strlen(lexer->lexeme) + 1);
-					strcpy(token.value, lexer->lexeme);
+JSIMPLON_DEF Jsimplon_Value *jsimplon_tree_from_file(char **error, const char *file_name)
+{
+	return jsimplon_tree_parse_file(error, file_name, false, NULL);
+}
 
-					break;
-				}
-			}
-			else if (c == '\n') {
-				jsimplon_append_str(
-					lexer->error, lexer->error_size,
-					"lexer error: %u:%u: newline character inserted in the middle of string literal %s\n",
+JSIMPLON_DEF Jsimplon_Value *jsimplon_tree_from_file_ex(char **error, const char *file_name, const Jsimplon_Options *options)
+{
+	return jsimplon_tree_parse_file(error, file_name, false, options);
+}
+
+JSIMPLON_DEF Jsimplon_Value *jsimplon_tree_from_file_insitu_ex(char **error, const char *file_name, const Jsimplon_Options *options)
+{
+	return jsimplon_tree_parse_file(error, file_name, true, options);
+}
+
+// The file is parsed straight out of the mapping with its length, so it doesn't need a NUL after it
+JSIMPLON_DEF_INTERNAL Jsimplon_Value *jsimplon_tree_parse_file(char **error, const char *file_name, bool is_insitu, const Jsimplon_Options *options)
+{
+	size_t error_size;
+	if (error != NULL) {
+		error_size = 128;
+		*error = calloc(error_size, sizeof *(*error));
+	}
+
+	size_t length;
+	bool is_mapped;
+	char *src = jsimplon_file_map(error, &error_size, file_name, is_insitu, &length, &is_mapped);
+
+	if (src == NULL)
+		return NULL;
+
+	if (error != NULL && *error != NULL)
+		free(*error);
+
+	Jsimplon_Value *tree = jsimplon_tree_parse(error, src, length, is_insitu ? src : NULL, options);
+
+	// Borrowed strings and lazy containers point into the file
+	if (tree != NULL && (is_insitu || (options != NULL && options->lazy))) {
+		Jsimplon_Document *document = jsimplon_tag_document(tree->tag);
+
+		document->source = src;
+		document->source_length = length;
+		document->is_source_mapped = is_mapped;
+	}
+	else {
+		jsimplon_file_unmap(src, length, is_mapped);
+	}
+
+	return tree;
+}
+
+JSIMPLON_DEF char *jsimplon_tree_to_str(char **error, const Jsimplon_Value *root_value)
+{
+	size_t error_size;
+	if (error != NULL) {
+		error_size = 128;
+		*error = calloc(error_size, sizeof *(*error));
+	}
+
+	bool success = true;
+
+	Jsimplon_Serialiser serialiser = {
+		.error = error,
+		.error_size = &error_size,
+		.str_size = 128
+	};
+	serialiser.str = malloc(serialiser.str_size * (sizeof *serialiser.str));
+
+	jsimplon_value_to_str(&serialiser, root_value);
+	serialiser.str[serialiser.str_count] = '\0';
+
+	if (serialiser.error_count > 0) {
+		success = false;
+
+		jsimplon_append_str(
+			error, &error_size,
+			"serialiser generated %u error(s)\n",
+			serialiser.error_count
+		);
+	}
+
+	if (!success) {
+		free(serialiser.str);
+		return NULL;
+	}
+
+	if (error != NULL) {
+		free(*error);
+		*error = NULL;
+	}
+
+	return serialiser.str;
+}
+
+JSIMPLON_DEF int jsimplon_tree_to_file(char **error, const Jsimplon_Value *root_value, const char *file_name)
+{
+	char *str = jsimplon_tree_to_str(error, root_value);
+
+	size_t error_size;
+
+	if (str == NULL)
+		return JSIMPLON_FAILURE;
+
+	if (error != NULL) {
+		error_size = 128;
+		*error = calloc(error_size, sizeof *(*error));
+	}
+
+	int status = jsimplon_file_write(error, &error_size, file_name, str);
+	free(str);
+
+	if (status == JSIMPLON_SUCCESS && error != NULL) {
+		free(*error);
+		*error = NULL;
+	}
+
+	return status;
+}
+
+JSIMPLON_DEF int jsimplon_tree_destroy(Jsimplon_Value *tree)
+{
+	if (tree == NULL)
+		return JSIMPLON_FAILURE;
+
+	Jsimplon_Document *document = jsimplon_tag_document(tree->tag);
+
+	// Arena documents don't need to be walked, everything in them goes with the arena
+	if (document->use_arena)
+		jsimplon_arena_destroy(document->arena);
+	else
+		jsimplon_value_destroy(tree);
+
+	if (document->source != NULL)
+		jsimplon_file_unmap(document->source, document->source_length, document->is_source_mapped);
+
+	jsimplon_arena_destroy(document->interns.arena);
+	free(document->interns.slots);
+	free(document);
+
+	return JSIMPLON_SUCCESS;
+}
+
+JSIMPLON_DEF Jsimplon_Value *jsimplon_tree_root_create(void)
+{
+	return jsimplon_tree_root_create_ex(NULL);
+}
+
+JSIMPLON_DEF Jsimplon_Value *jsimplon_tree_root_create_ex(const Jsimplon_Options *options)
+{
+	// Rounded up, aligned_alloc only takes whole multiples of the alignment
+	size_t size = (sizeof(Jsimplon_Document) + JSIMPLON_DOCUMENT_ALIGNMENT - 1) & ~(size_t)(JSIMPLON_DOCUMENT_ALIGNMENT - 1);
+	Jsimplon_Document *document = aligned_alloc(JSIMPLON_DOCUMENT_ALIGNMENT, size);
+
+	memset(document, 0, sizeof *document);
+	document->root.tag = (uintptr_t)document;
+	document->use_arena = options != NULL && options->use_arena;
+	document->intern_strings = options != NULL && options->intern_strings;
+	document->validate_utf8 = options != NULL && options->validate_utf8;
+
+	return &document->root;
+}
+
+JSIMPLON_DEF int jsimplon_value_set_str(Jsimplon_Value *value, const char *str)
+{
+	if (value == NULL || str == NULL)
+		return JSIMPLON_FAILURE;
+
+	return jsimplon_value_set_str_len(value, str, strlen(str));
+}
+
+JSIMPLON_DEF int jsimplon_value_set_str_len(Jsimplon_Value *value, const char *str, size_t length)
+{
+	if (value == NULL || str == NULL)
+		return JSIMPLON_FAILURE;
+
+	jsimplon_value_destroy(value);
+	jsimplon_value_store_str(value, jsimplon_tag_document(value->tag), str, length);
+
+	return JSIMPLON_SUCCESS;
+}
+
+JSIMPLON_DEF int jsimplon_value_set_number(Jsimplon_Value *value, double number)
+{
+	if (value == NULL)
+		return JSIMPLON_FAILURE;
+
+	jsimplon_value_destroy(value);
+	jsimplon_value_retag(value, JSIMPLON_VALUE_NUMBER, 0);
+	value->number_value = number;
+
+	return JSIMPLON_SUCCESS;
+}
+
+JSIMPLON_DEF int jsimplon_value_set_int64(Jsimplon_Value *value, int64_t integer)
+{
+	if (value == NULL)
+		return JSIMPLON_FAILURE;
+
+	jsimplon_value_destroy(value);
+	jsimplon_value_retag(value, JSIMPLON_VALUE_INTEGER, 0);
+	value->integer_value = integer;
+
+	return JSIMPLON_SUCCESS;
+}
+
+JSIMPLON_DEF int jsimplon_value_set_uint64(Jsimplon_Value *value, uint64_t integer)
+{
+	if (value == NULL)
+		return JSIMPLON_FAILURE;
+
+	jsimplon_value_destroy(value);
+
+	if (integer > INT64_MAX) {
+		jsimplon_value_retag(value, JSIMPLON_VALUE_INTEGER, JSIMPLON_FLAG_UNSIGNED);
+		value->unsigned_value = integer;
+	}
+	else {
+		jsimplon_value_retag(value, JSIMPLON_VALUE_INTEGER, 0);
+		value->integer_value = (int64_t)integer;
+	}
+
+	return JSIMPLON_SUCCESS;
+}
+
+JSIMPLON_DEF int jsimplon_value_set_bool(Jsimplon_Value *value, bool bool_value)
+{
+	if (value == NULL)
+		return JSIMPLON_FAILURE;
+
+	jsimplon_value_destroy(value);
+	jsimplon_value_retag(value, JSIMPLON_VALUE_BOOL, 0);
+	value->bool_value = bool_value;
+
+	return JSIMPLON_SUCCESS;
+}
+
+JSIMPLON_DEF int jsimplon_value_set_null(Jsimplon_Value *value)
+{
+	if (value == NULL)
+		return JSIMPLON_FAILURE;
+
+	jsimplon_value_destroy(value);
+	jsimplon_value_retag(value, JSIMPLON_VALUE_NULL, 0);
+	value->null_value = NULL;
+
+	return JSIMPLON_SUCCESS;
+}
+
+JSIMPLON_DEF Jsimplon_Object *jsimplon_value_set_object(Jsimplon_Value *value)
+{
+	if (value == NULL)
+		return NULL;
+
+	jsimplon_value_destroy(value);
+	jsimplon_value_open(value, jsimplon_tag_document(value->tag), JSIMPLON_VALUE_OBJECT);
+
+	return value->object_value;
+}
+
+JSIMPLON_DEF Jsimplon_Array *jsimplon_value_set_array(Jsimplon_Value *value)
+{
+	if (value == NULL)
+		return NULL;
+
+	jsimplon_value_destroy(value);
+	jsimplon_value_open(value, jsimplon_tag_document(value->tag), JSIMPLON_VALUE_ARRAY);
+
+	return value->array_value;
+}
+
+JSIMPLON_DEF Jsimplon_Member *jsimplon_object_add_member(Jsimplon_Object *object)
+{
+	if (object == NULL || jsimplon_object_load(object) != JSIMPLON_SUCCESS)
+		return NULL;
+
+	Jsimplon_Document *document = jsimplon_object_document(object);
+
+	if (object->members_count == object->members_size)
+		jsimplon_object_grow(document, object);
+
+	Jsimplon_Member *member = &object->members[object->members_count++];
+	*member = (Jsimplon_Member) { .value.tag = (uintptr_t)document };
+
+	return member;
+}
+
+JSIMPLON_DEF Jsimplon_Value *jsimplon_object_add_member_value(Jsimplon_Object *object, const char *key)
+{
+	if (object == NULL || key == NULL)
+		return NULL;
+
+	return jsimplon_object_add_member_value_len(object, key, strlen(key));
+}
+
+JSIMPLON_DEF Jsimplon_Value *jsimplon_object_add_member_value_len(Jsimplon_Object *object, const char *key, size_t key_length)
+{
+	if (object == NULL || key == NULL || key_length > UINT32_MAX)
+		return NULL;
+
+	Jsimplon_Member *member = jsimplon_object_add_member(object);
+	if (member == NULL)
+		return NULL;
+
+	jsimplon_member_set_key_len(member, key, key_length);
+
+	return &member->value;
+}
+
+JSIMPLON_DEF int jsimplon_object_add_member_str(Jsimplon_Object *object, const char *key, const char *str)
+{
+	if (object == NULL || key == NULL || str == NULL)
+		return JSIMPLON_FAILURE;
+
+	return jsimplon_value_set_str(jsimplon_object_add_member_value(object, key), str);
+}
+
+JSIMPLON_DEF int jsimplon_object_add_member_number(Jsimplon_Object *object, const char *key, double number)
+{
+	if (object == NULL || key == NULL)
+		return JSIMPLON_FAILURE;
+
+	return jsimplon_value_set_number(jsimplon_object_add_member_value(object, key), number);
+}
+
+JSIMPLON_DEF int jsimplon_object_add_member_int64(Jsimplon_Object *object, const char *key, int64_t integer)
+{
+	if (object == NULL || key == NULL)
+		return JSIMPLON_FAILURE;
+
+	return jsimplon_value_set_int64(jsimplon_object_add_member_value(object, key), integer);
+}
+
+JSIMPLON_DEF int jsimplon_object_add_member_bool(Jsimplon_Object *object, const char *key, bool bool_value)
+{
+	if (object == NULL || key == NULL)
+		return JSIMPLON_FAILURE;
+
+	return jsimplon_value_set_bool(jsimplon_object_add_member_value(object, key), bool_value);
+}
+
+JSIMPLON_DEF int jsimplon_object_add_member_null(Jsimplon_Object *object, const char *key)
+{
+	if (object == NULL || key == NULL)
+		return JSIMPLON_FAILURE;
+
+	return jsimplon_value_set_null(jsimplon_object_add_member_value(object, key));
+}
+
+JSIMPLON_DEF Jsimplon_Object *jsimplon_object_add_member_object(Jsimplon_Object *object, const char *key)
+{
+	if (object == NULL || key == NULL)
+		return NULL;
+
+	return jsimplon_value_set_object(jsimplon_object_add_member_value(object, key));
+}
+
+JSIMPLON_DEF Jsimplon_Array *jsimplon_object_add_member_array(Jsimplon_Object *object, const char *key)
+{
+	if (object == NULL || key == NULL)
+		return NULL;
+
+	return jsimplon_value_set_array(jsimplon_object_add_member_value(object, key));
+}
+
+JSIMPLON_DEF int jsimplon_object_remove_member(Jsimplon_Object *object, const char *key)
+{
+	if (object == NULL || key == NULL || jsimplon_object_load(object) != JSIMPLON_SUCCESS)
+		return JSIMPLON_FAILURE;
+
+	Jsimplon_Member *member = jsimplon_object_get_member(object, key);
+	if (member == NULL)
+		return JSIMPLON_FAILURE;
+
+	uint32_t i = (uint32_t)(member - object->members);
+	jsimplon_member_destroy(member);
+
+	if (i < object->members_count - 1)
+		memmove(&object->members[i], &object->members[i + 1], (object->members_count - i - 1) * (sizeof *object->members));
+
+	--object->members_count;
+
+	// Every member after it moved down a slot, which is as much work as indexing them all again
+	Jsimplon_ObjectIndex *index = jsimplon_object_index_update(object);
+	if (index != NULL)
+		jsimplon_object_index_reset(index);
+
+	return JSIMPLON_SUCCESS;
+}
+
+JSIMPLON_DEF int jsimplon_object_reserve(Jsimplon_Object *object, size_t members_size)
+{
+	if (object == NULL || members_size > UINT32_MAX || jsimplon_object_load(object) != JSIMPLON_SUCCESS)
+		return JSIMPLON_FAILURE;
+
+	if (members_size > object->members_size)
+		jsimplon_object_resize(jsimplon_object_document(object), object, (uint32_t)members_size);
+
+	return JSIMPLON_SUCCESS;
+}
+
+JSIMPLON_DEF int jsimplon_object_shrink_to_fit(Jsimplon_Object *object)
+{
+	if (object == NULL || jsimplon_object_load(object) != JSIMPLON_SUCCESS)
+		return JSIMPLON_FAILURE;
+
+	Jsimplon_Document *document = jsimplon_object_document(object);
+
+	if ((document == NULL || !document->use_arena) && object->members_count < object->members_size)
+		jsimplon_object_resize(document, object, object->members_count);
+
+	return JSIMPLON_SUCCESS;
+}
+
+JSIMPLON_DEF int jsimplon_member_set_key(Jsimplon_Member *member, const char *new_key)
+{
+	if (member == NULL || new_key == NULL)
+		return JSIMPLON_FAILURE;
+
+	return jsimplon_member_set_key_len(member, new_key, strlen(new_key));
+}
+
+JSIMPLON_DEF int jsimplon_member_set_key_len(Jsimplon_Member *member, const char *new_key, size_t length)
+{
+	if (member == NULL || new_key == NULL || length > UINT32_MAX)
+		return JSIMPLON_FAILURE;
+
+	Jsimplon_Document *document = jsimplon_tag_document(member->value.tag);
+
+	// Only a member that had a key can be in an index
+	if (jsimplon_member_key(member) != NULL) {
+		if (document != NULL)
+			document->renamed_keys[document->keys_version++ % JSIMPLON_RENAMED_KEYS_COUNT] = member;
+
+		if (!(member->key_flags & (JSIMPLON_FLAG_BORROWED | JSIMPLON_FLAG_INLINE)))
+			jsimplon_document_free(document, jsimplon_string(member->key));
+	}
+
+	jsimplon_member_store_key(member, document, new_key, length);
+
+	return JSIMPLON_SUCCESS;
+}
+
+JSIMPLON_DEF Jsimplon_Value *jsimplon_member_set_value(Jsimplon_Member *member)
+{
+	if (member == NULL)
+		return NULL;
+
+	return &member->value;
+}
+
+JSIMPLON_DEF int jsimplon_member_set_str(Jsimplon_Member *member, const char *str)
+{
+	if (member == NULL)
+		return JSIMPLON_FAILURE;
+
+	return jsimplon_value_set_str(&member->value, str);
+}
+
+JSIMPLON_DEF int jsimplon_member_set_number(Jsimplon_Member *member, double number)
+{
+	if (member == NULL)
+		return JSIMPLON_FAILURE;
+
+	return jsimplon_value_set_number(&member->value, number);
+}
+
+JSIMPLON_DEF int jsimplon_member_set_int64(Jsimplon_Member *member, int64_t integer)
+{
+	if (member == NULL)
+		return JSIMPLON_FAILURE;
+
+	return jsimplon_value_set_int64(&member->value, integer);
+}
+
+JSIMPLON_DEF int jsimplon_member_set_bool(Jsimplon_Member *member, bool bool_value)
+{
+	if (member == NULL)
+		return JSIMPLON_FAILURE;
+
+	return jsimplon_value_set_bool(&member->value, bool_value);
+}
+
+JSIMPLON_DEF int jsimplon_member_set_null(Jsimplon_Member *member)
+{
+	if (member == NULL)
+		return JSIMPLON_FAILURE;
+
+	return jsimplon_value_set_null(&member->value);
+}
+
+JSIMPLON_DEF Jsimplon_Object *jsimplon_member_set_object(Jsimplon_Member *member)
+{
+	if (member == NULL)
+		return NULL;
+
+	return jsimplon_value_set_object(&member->value);
+}
+
+JSIMPLON_DEF Jsimplon_Array *jsimplon_member_set_array(Jsimplon_Member *member)
+{
+	if (member == NULL)
+		return NULL;
+
+	return jsimplon_value_set_array(&member->value);
+}
+
+JSIMPLON_DEF Jsimplon_Value *jsimplon_array_push_value(Jsimplon_Array *array)
+{
+	if (array == NULL || jsimplon_array_load(array) != JSIMPLON_SUCCESS)
+		return NULL;
+
+	Jsimplon_Document *document = jsimplon_array_document(array);
+
+	if (array->values_count == array->values_size)
+		jsimplon_array_grow(document, array);
+
+	Jsimplon_Value *value = &array->values[array->values_count++];
+	*value = (Jsimplon_Value) { .tag = (uintptr_t)document };
+
+	return value;
+}
+
+JSIMPLON_DEF int jsimplon_array_push_str(Jsimplon_Array *array, const char *str)
+{
+	return jsimplon_value_set_str(jsimplon_array_push_value(array), str);
+}
+
+JSIMPLON_DEF int jsimplon_array_push_number(Jsimplon_Array *array, double number)
+{
+	return jsimplon_value_set_number(jsimplon_array_push_value(array), number);
+}
+
+JSIMPLON_DEF int jsimplon_array_push_int64(Jsimplon_Array *array, int64_t integer)
+{
+	return jsimplon_value_set_int64(jsimplon_array_push_value(array), integer);
+}
+
+JSIMPLON_DEF int jsimplon_array_push_bool(Jsimplon_Array *array, bool bool_value)
+{
+	return jsimplon_value_set_bool(jsimplon_array_push_value(array), bool_value);
+}
+
+JSIMPLON_DEF int jsimplon_array_push_null(Jsimplon_Array *array)
+{
+	return jsimplon_value_set_null(jsimplon_array_push_value(array));
+}
+
+JSIMPLON_DEF Jsimplon_Object *jsimplon_array_push_object(Jsimplon_Array *array)
+{
+	return jsimplon_value_set_object(jsimplon_array_push_value(array));
+}
+
+JSIMPLON_DEF Jsimplon_Array *jsimplon_array_push_array(Jsimplon_Array *array)
+{
+	return jsimplon_value_set_array(jsimplon_array_push_value(array));
+}
+
+JSIMPLON_DEF Jsimplon_Value *jsimplon_array_insert_value_at_index(Jsimplon_Array *array, size_t index)
+{
+	if (array == NULL || jsimplon_array_load(array) != JSIMPLON_SUCCESS)
+		return NULL;
+
+	if (index >= array->values_count)
+		return jsimplon_array_push_value(array);
+
+	Jsimplon_Document *document = jsimplon_array_document(array);
+
+	if (array->values_count == array->values_size)
+		jsimplon_array_grow(document, array);
+
+	memmove(&array->values[index + 1], &array->values[index], (array->values_count - index) * (sizeof *array->values));
+	++array->values_count;
+
+	Jsimplon_Value *value = &array->values[index];
+	*value = (Jsimplon_Value) { .tag = (uintptr_t)document };
+
+	return value;
+}
+
+JSIMPLON_DEF int jsimplon_array_remove_value_at_index(Jsimplon_Array *array, size_t index)
+{
+	if (array == NULL || jsimplon_array_load(array) != JSIMPLON_SUCCESS || index >= array->values_count)
+		return JSIMPLON_FAILURE;
+
+	jsimplon_value_destroy(&array->values[index]);
+
+	if (index < array->values_count - 1)
+		memmove(&array->values[index], &array->values[index + 1], (array->values_count - index - 1) * (sizeof *array->values));
+
+	--array->values_count;
+
+	return JSIMPLON_SUCCESS;
+}
+
+JSIMPLON_DEF int jsimplon_array_reserve(Jsimplon_Array *array, size_t values_size)
+{
+	if (array == NULL || values_size > UINT32_MAX || jsimplon_array_load(array) != JSIMPLON_SUCCESS)
+		return JSIMPLON_FAILURE;
+
+	if (values_size > array->values_size)
+		jsimplon_array_resize(jsimplon_array_document(array), array, (uint32_t)values_size);
+
+	return JSIMPLON_SUCCESS;
+}
+
+JSIMPLON_DEF int jsimplon_array_shrink_to_fit(Jsimplon_Array *array)
+{
+	if (array == NULL || jsimplon_array_load(array) != JSIMPLON_SUCCESS)
+		return JSIMPLON_FAILURE;
+
+	Jsimplon_Document *document = jsimplon_array_document(array);
+
+	if ((document == NULL || !document->use_arena) && array->values_count < array->values_size)
+		jsimplon_array_resize(document, array, array->values_count);
+
+	return JSIMPLON_SUCCESS;
+}
+
+JSIMPLON_DEF Jsimplon_ValueType jsimplon_value_get_type(Jsimplon_Value *value)
+{
+	return jsimplon_tag_type(value->tag);
+}
+
+// The payload of anything else is no pointer to a header
+JSIMPLON_DEF Jsimplon_Object *jsimplon_value_get_object(Jsimplon_Value *value)
+{
+	if (value == NULL || jsimplon_tag_type(value->tag) != JSIMPLON_VALUE_OBJECT || jsimplon_object_load(value->object_value) != JSIMPLON_SUCCESS)
+		return NULL;
+
+	return value->object_value;
+}
+
+JSIMPLON_DEF Jsimplon_Array *jsimplon_value_get_array(Jsimplon_Value *value)
+{
+	if (value == NULL || jsimplon_tag_type(value->tag) != JSIMPLON_VALUE_ARRAY || jsimplon_array_load(value->array_value) != JSIMPLON_SUCCESS)
+		return NULL;
+
+	return value->array_value;
+}
+
+JSIMPLON_DEF const char *jsimplon_value_get_str(Jsimplon_Value *value)
+{
+	if (value == NULL || jsimplon_tag_type(value->tag) != JSIMPLON_VALUE_STRING)
+		return NULL;
+
+	return jsimplon_value_str(value);
+}
+
+JSIMPLON_DEF size_t jsimplon_value_get_str_len(Jsimplon_Value *value)
+{
+	if (value == NULL || jsimplon_tag_type(value->tag) != JSIMPLON_VALUE_STRING)
+		return 0;
+
+	return jsimplon_value_str_length(value);
+}
+
+JSIMPLON_DEF double jsimplon_value_get_number(Jsimplon_Value *value)
+{
+	if (value == NULL)
+		return INFINITY;
+
+	if (jsimplon_tag_type(value->tag) == JSIMPLON_VALUE_INTEGER)
+		return jsimplon_tag_flags(value->tag) & JSIMPLON_FLAG_UNSIGNED ? (double)value->unsigned_value : (double)value->integer_value;
+
+	return value->number_value;
+}
+
+JSIMPLON_DEF int64_t jsimplon_value_get_int64(Jsimplon_Value *value)
+{
+	if (value == NULL)
+		return INT64_MIN;
+
+	if (jsimplon_tag_type(value->tag) == JSIMPLON_VALUE_INTEGER)
+		return jsimplon_tag_flags(value->tag) & JSIMPLON_FLAG_UNSIGNED ? INT64_MIN : value->integer_value;
+
+	// 2^63 is exact as a double, INT64_MAX isn't
+	double number = value->number_value;
+	if (jsimplon_tag_type(value->tag) == JSIMPLON_VALUE_NUMBER && number == trunc(number) && number >= -0x1p63 && number < 0x1p63)
+		return (int64_t)number;
+
+	return INT64_MIN;
+}
+
+JSIMPLON_DEF uint64_t jsimplon_value_get_uint64(Jsimplon_Value *value)
+{
+	if (value == NULL)
+		return UINT64_MAX;
+
+	if (jsimplon_tag_type(value->tag) == JSIMPLON_VALUE_INTEGER) {
+		if (jsimplon_tag_flags(value->tag) & JSIMPLON_FLAG_UNSIGNED)
+			return value->unsigned_value;
+
+		return value->integer_value >= 0 ? (uint64_t)value->integer_value : UINT64_MAX;
+	}
+
+	double number = value->number_value;
+	if (jsimplon_tag_type(value->tag) == JSIMPLON_VALUE_NUMBER && number == trunc(number) && number >= 0 && number < 0x1p64)
+		return (uint64_t)number;
+
+	return UINT64_MAX;
+}
+
+JSIMPLON_DEF int jsimplon_value_get_bool(Jsimplon_Value *value)
+{
+	if (value == NULL)
+		return -1;
+
+	return value->bool_value;
+}
+
+JSIMPLON_DEF Jsimplon_Member *jsimplon_object_get_member(Jsimplon_Object *object, const char *key)
+{
+	if (object == NULL || key == NULL)
+		return NULL;
+
+	return jsimplon_object_get_member_len(object, key, strlen(key));
+}
+
+JSIMPLON_DEF Jsimplon_Member *jsimplon_object_get_member_len(Jsimplon_Object *object, const char *key, size_t key_length)
+{
+	if (object == NULL || key == NULL || jsimplon_object_load(object) != JSIMPLON_SUCCESS)
+		return NULL;
+
+	Jsimplon_ObjectIndex *index = jsimplon_object_index_update(object);
+	if (index != NULL)
+		return jsimplon_object_index_find(object, index, key, key_length, jsimplon_hash(key, key_length));
+
+	for (size_t i = 0; i < object->members_count; ++i) {
+		if (jsimplon_member_key_equals(&object->members[i], key, key_length))
+			return &object->members[i];
+	}
+
+	return NULL;
+}
+
+JSIMPLON_DEF size_t jsimplon_object_get_member_count(Jsimplon_Object *object)
+{
+	if (object == NULL || jsimplon_object_load(object) != JSIMPLON_SUCCESS)
+		return 0;
+
+	return object->members_count;
+}
+
+JSIMPLON_DEF Jsimplon_Member *jsimplon_object_get_member_at_index(Jsimplon_Object *object, size_t index)
+{
+	if (object == NULL || jsimplon_object_load(object) != JSIMPLON_SUCCESS)
+		return NULL;
+
+	if (index >= object->members_count)
+		return NULL;
+
+	return &object->members[index];
+}
+
+JSIMPLON_DEF Jsimplon_ValueType jsimplon_object_member_get_type(Jsimplon_Object *object, const char *key)
+{
+	return jsimplon_value_get_type(jsimplon_object_member_get_value(object, key));
+}
+
+JSIMPLON_DEF Jsimplon_Value *jsimplon_object_member_get_value(Jsimplon_Object *object, const char *key)
+{
+	Jsimplon_Member *member = jsimplon_object_get_member(object, key);
+
+	if (member == NULL)
+		return NULL;
+
+	return &member->value;
+}
+
+JSIMPLON_DEF Jsimplon_Object *jsimplon_object_member_get_object(Jsimplon_Object *object, const char *key)
+{
+	return jsimplon_value_get_object(jsimplon_object_member_get_value(object, key));
+}
+
+JSIMPLON_DEF Jsimplon_Array *jsimplon_object_member_get_array(Jsimplon_Object *object, const char *key)
+{
+	return jsimplon_value_get_array(jsimplon_object_member_get_value(object, key));
+}
+
+JSIMPLON_DEF const char *jsimplon_object_member_get_str(Jsimplon_Object *object, const char *key)
+{
+	return jsimplon_value_get_str(jsimplon_object_member_get_value(object, key));
+}
+
+JSIMPLON_DEF double jsimplon_object_member_get_number(Jsimplon_Object *object, const char *key)
+{
+	return jsimplon_value_get_number(jsimplon_object_member_get_value(object, key));
+}
+
+JSIMPLON_DEF int64_t jsimplon_object_member_get_int64(Jsimplon_Object *object, const char *key)
+{
+	return jsimplon_value_get_int64(jsimplon_object_member_get_value(object, key));
+}
+
+JSIMPLON_DEF int jsimplon_object_member_get_bool(Jsimplon_Object *object, const char *key)
+{
+	return jsimplon_value_get_bool(jsimplon_object_member_get_value(object, key));
+}
+
+JSIMPLON_DEF const char *jsimplon_member_get_key(Jsimplon_Member *member)
+{
+	if (member == NULL)
+		return NULL;
+
+	return jsimplon_member_key(member);
+}
+
+JSIMPLON_DEF size_t jsimplon_member_get_key_len(Jsimplon_Member *member)
+{
+	if (member == NULL || jsimplon_member_key(member) == NULL)
+		return 0;
+
+	return jsimplon_member_key_length(member);
+}
+
+JSIMPLON_DEF Jsimplon_Value *jsimplon_member_get_value(Jsimplon_Member *member)
+{
+	if (member == NULL)
+		return NULL;
+
+	return &member->value;
+}
+
+JSIMPLON_DEF const char *jsimplon_member_get_str(Jsimplon_Member *member)
+{
+	if (member == NULL)
+		return NULL;
+
+	return jsimplon_value_get_str(&member->value);
+}
+
+JSIMPLON_DEF double jsimplon_member_get_number(Jsimplon_Member *member)
+{
+	if (member == NULL)
+		return INFINITY;
+
+	return jsimplon_value_get_number(&member->value);
+}
+
+JSIMPLON_DEF int64_t jsimplon_member_get_int64(Jsimplon_Member *member)
+{
+	if (member == NULL)
+		return INT64_MIN;
+
+	return jsimplon_value_get_int64(&member->value);
+}
+
+JSIMPLON_DEF int jsimplon_member_get_bool(Jsimplon_Member *member)
+{
+	if (member == NULL)
+		return -1;
+
+	return jsimplon_value_get_bool(&member->value);
+}
+
+JSIMPLON_DEF Jsimplon_Object *jsimplon_member_get_object(Jsimplon_Member *member)
+{
+	if (member == NULL)
+		return NULL;
+
+	return jsimplon_value_get_object(&member->value);
+}
+
+JSIMPLON_DEF Jsimplon_Array *jsimplon_member_get_array(Jsimplon_Member *member)
+{
+	if (member == NULL)
+		return NULL;
+
+	return jsimplon_value_get_array(&member->value);
+}
+
+JSIMPLON_DEF size_t jsimplon_array_get_count(Jsimplon_Array *array)
+{
+	if (array == NULL || jsimplon_array_load(array) != JSIMPLON_SUCCESS)
+		return 0;
+
+	return array->values_count;
+}
+
+JSIMPLON_DEF Jsimplon_Value *jsimplon_array_get_value_at_index(Jsimplon_Array *array, size_t index)
+{
+	if (array == NULL || jsimplon_array_load(array) != JSIMPLON_SUCCESS)
+		return NULL;
+
+	if (index >= array->values_count)
+		return NULL;
+
+	return &array->values[index];
+}
+
+JSIMPLON_DEF Jsimplon_Path *jsimplon_path_compile(char **error, const char *pointer)
+{
+	size_t error_size;
+	if (error != NULL) {
+		error_size = 128;
+		*error = calloc(error_size, sizeof *(*error));
+	}
+
+	if (pointer == NULL) {
+		jsimplon_append_str(error, &error_size, "path error: no path was given\n");
+		return NULL;
+	}
+
+	if (pointer[0] != '\0' && pointer[0] != '/') {
+		jsimplon_append_str(error, &error_size, "path error: 1: expected '/', got '%c'\n", pointer[0]);
+		return NULL;
+	}
+
+	uint32_t segments_count = 0;
+	size_t pointer_len = 0;
+	for (; pointer[pointer_len] != '\0'; ++pointer_len) {
+		if (pointer[pointer_len] == '/')
+			++segments_count;
+	}
+
+	// Unescaping only ever shortens a token, and each one gives up its '/' for a NUL
+	Jsimplon_Path *path = malloc(sizeof *path + segments_count * sizeof *path->segments + pointer_len);
+	path->segments_count = segments_count;
+
+	char *key = (char *)&path->segments[segments_count];
+	const char *c = pointer;
+
+	for (uint32_t i = 0; i < segments_count; ++i) {
+		Jsimplon_PathSegment *segment = &path->segments[i];
+		segment->key = key;
+
+		for (++c; *c != '\0' && *c != '/'; ++c) {
+			if (*c != '~') {
+				*key++ = *c;
+				continue;
+			}
+
+			if (c[1] != '0' && c[1] != '1') {
+				if (c[1] == '\0') {
+					jsimplon_append_str(
+						error, &error_size,
+						"path error: %zu: expected '0' or '1' after '~', got the end of the path\n",
+						(size_t)(c - pointer) + 2
+					);
+				}
+				else {
+					jsimplon_append_str(
+						error, &error_size,
+						"path error: %zu: expected '0' or '1' after '~', got '%c'\n",
+						(size_t)(c - pointer) + 2, c[1]
+					);
+				}
+
+				free(path);
+				return NULL;
+			}
+
+			*key++ = c[1] == '0' ? '~' : '/';
+			++c;
+		}
+
+		segment->length = (size_t)(key - segment->key);
+		segment->hash = jsimplon_hash(segment->key, segment->length);
+		*key++ = '\0';
+
+		// Leading zeros aren't indexes, so "01" is only ever a key
+		segment->index = SIZE_MAX;
+		if (segment->length > 0 && (segment->key[0] != '0' || segment->length == 1)) {
+			size_t index = 0;
+			size_t j = 0;
+
+			for (; j < segment->length && segment->key[j] >= '0' && segment->key[j] <= '9'; ++j) {
+				size_t digit = (size_t)(segment->key[j] - '0');
+				if (index > (SIZE_MAX - 1 - digit) / 10)
+					break;
+
+				index = index * 10 + digit;
+			}
+
+			if (j == segment->length)
+				segment->index = index;
+		}
+	}
+
+	if (error != NULL) {
+		free(*error);
+		*error = NULL;
+	}
+
+	return path;
+}
+
+JSIMPLON_DEF Jsimplon_Value *jsimplon_path_get(Jsimplon_Value *root, const Jsimplon_Path *path)
+{
+	if (path == NULL)
+		return NULL;
+
+	Jsimplon_Value *value = root;
+	for (uint32_t i = 0; i < path->segments_count && value != NULL; ++i)
+		value = jsimplon_path_step(value, &path->segments[i]);
+
+	return value;
+}
+
+JSIMPLON_DEF size_t jsimplon_path_get_many(Jsimplon_Value *root, const Jsimplon_Path *const *paths, size_t paths_count, Jsimplon_Value **values)
+{
+	if (paths_count == 0)
+		return 0;
+
+	// Sorted, paths that share a prefix end up next to each other and each one only walks past where the one
+	// before it stopped sharing
+	Jsimplon_PathOrder *order = malloc(paths_count * sizeof *order);
+	uint32_t max_segments_count = 0;
+
+	for (size_t i = 0; i < paths_count; ++i) {
+		order[i] = (Jsimplon_PathOrder){ paths[i], i };
+
+		if (paths[i] != NULL && paths[i]->segments_count > max_segments_count)
+			max_segments_count = paths[i]->segments_count;
+	}
+
+	qsort(order, paths_count, sizeof *order, jsimplon_path_order_compare);
+
+	// resolved[i] is what the first i segments of the previous path resolved to
+	Jsimplon_Value **resolved = malloc(((size_t)max_segments_count + 1) * sizeof *resolved);
+	resolved[0] = root;
+	uint32_t resolved_count = 1;
+
+	const Jsimplon_Path *previous = NULL;
+	size_t found_count = 0;
+
+	for (size_t i = 0; i < paths_count; ++i) {
+		const Jsimplon_Path *path = order[i].path;
+
+		if (path == NULL) {
+			values[order[i].index] = NULL;
+			continue;
+		}
+
+		uint32_t depth = 0;
+		if (previous != NULL) {
+			while (
+				depth + 1 < resolved_count && depth < path->segments_count &&
+				jsimplon_path_segment_equals(&path->segments[depth], &previous->segments[depth])
+			) {
+				++depth;
+			}
+		}
+
+		Jsimplon_Value *value = resolved[depth];
+		while (depth < path->segments_count && value != NULL) {
+			value = jsimplon_path_step(value, &path->segments[depth]);
+			resolved[++depth] = value;
+		}
+
+		resolved_count = depth + 1;
+		previous = path;
+
+		values[order[i].index] = value;
+		if (value != NULL)
+			++found_count;
+	}
+
+	free(resolved);
+	free(order);
+
+	return found_count;
+}
+
+JSIMPLON_DEF void jsimplon_path_destroy(Jsimplon_Path *path)
+{
+	free(path);
+}
+
+JSIMPLON_DEF_INTERNAL Jsimplon_Value *jsimplon_path_step(Jsimplon_Value *value, const Jsimplon_PathSegment *segment)
+{
+	if (jsimplon_value_load(value) != JSIMPLON_SUCCESS)
+		return NULL;
+
+	if (jsimplon_tag_type(value->tag) == JSIMPLON_VALUE_ARRAY) {
+		Jsimplon_Array *array = value->array_value;
+		return segment->index < array->values_count ? &array->values[segment->index] : NULL;
+	}
+
+	if (jsimplon_tag_type(value->tag) != JSIMPLON_VALUE_OBJECT)
+		return NULL;
+
+	Jsimplon_Object *object = value->object_value;
+
+	Jsimplon_ObjectIndex *index = jsimplon_object_index_update(object);
+	if (index != NULL) {
+		Jsimplon_Member *member = jsimplon_object_index_find(object, index, segment->key, segment->length, segment->hash);
+		return member != NULL ? &member->value : NULL;
+	}
+
+	for (uint32_t i = 0; i < object->members_count; ++i) {
+		if (jsimplon_member_key_equals(&object->members[i], segment->key, segment->length))
+			return &object->members[i].value;
+	}
+
+	return NULL;
+}
+
+JSIMPLON_DEF_INTERNAL bool jsimplon_path_segment_equals(const Jsimplon_PathSegment *a, const Jsimplon_PathSegment *b)
+{
+	return a->hash == b->hash && a->length == b->length && memcmp(a->key, b->key, a->length) == 0;
+}
+
+JSIMPLON_DEF_INTERNAL int jsimplon_path_order_compare(const void *a, const void *b)
+{
+	const Jsimplon_PathOrder *order_a = a;
+	const Jsimplon_PathOrder *order_b = b;
+	const Jsimplon_Path *path_a = order_a->path;
+	const Jsimplon_Path *path_b = order_b->path;
+
+	// Any order does as long as equal prefixes are kept together, NULL paths go last
+	if (path_a == NULL || path_b == NULL) {
+		if (path_a != path_b)
+			return path_a == NULL ? 1 : -1;
+	}
+	else {
+		uint32_t count = path_a->segments_count < path_b->segments_count ? path_a->segments_count : path_b->segments_count;
+
+		for (uint32_t i = 0; i < count; ++i) {
+			const Jsimplon_PathSegment *segment_a = &path_a->segments[i];
+			const Jsimplon_PathSegment *segment_b = &path_b->segments[i];
+
+			if (segment_a->length != segment_b->length)
+				return segment_a->length < segment_b->length ? -1 : 1;
+
+			int comparison = memcmp(segment_a->key, segment_b->key, segment_a->length);
+			if (comparison != 0)
+				return comparison;
+		}
+
+		if (path_a->segments_count != path_b->segments_count)
+			return path_a->segments_count < path_b->segments_count ? -1 : 1;
+	}
+
+	return (order_a->index > order_b->index) - (order_a->index < order_b->index);
+}
+
+// The token engine, one token at a time: containers are built in place under the parser's stack of open ones,
+// so nesting costs a pointer of heap per level instead of a call frame and stops at max_depth
+JSIMPLON_DEF_INTERNAL void jsimplon_parser_parse_tokens(Jsimplon_Parser *parser)
+{
+	while (parser->error_count == 0) {
+		// The lexer reports what it skipped and still hands over the token after it
+		if (parser->lexer.error_count > 0) {
+			jsimplon_parser_discard_token(parser);
+			break;
+		}
+
+		jsimplon_parser_step(parser);
+
+		if (parser->token.type == JSIMPLON_TOKEN_END || parser->error_count > 0)
+			break;
+
+		parser->token = jsimplon_lexer_next_token(&parser->lexer);
+	}
+}
+
+// Moves the token engine on by parser->token, everything it needs to pick up again is kept in the parser
+JSIMPLON_DEF_INTERNAL void jsimplon_parser_step(Jsimplon_Parser *parser)
+{
+	Jsimplon_Document *document = parser->lexer.document;
+	Jsimplon_Document *allocator = parser->lexer.allocator;
+	Jsimplon_TokenType type = parser->token.type;
+	Jsimplon_Value *container = parser->stack_count > 0 ? parser->stack[parser->stack_count - 1] : NULL;
+	uint32_t error_count = parser->error_count;
+
+	// An element gets its slot and is then parsed like any other value, only an empty array may close instead
+	if (parser->expecting == JSIMPLON_EXPECT_ELEMENT && !(type == JSIMPLON_TOKEN_RBRACKET && container->array_value->values_count == 0)) {
+		Jsimplon_Array *array = container->array_value;
+
+		if (array->values_count == array->values_size)
+			jsimplon_array_grow(allocator, array);
+
+		parser->value = &array->values[array->values_count++];
+		*parser->value = (Jsimplon_Value){ .tag = (uintptr_t)document };
+		parser->expecting = JSIMPLON_EXPECT_VALUE;
+	}
+
+	switch (parser->expecting) {
+		case JSIMPLON_EXPECT_ELEMENT:
+			--parser->stack_count;
+			parser->expecting = JSIMPLON_EXPECT_NEXT;
+			break;
+		case JSIMPLON_EXPECT_ROOT:
+			if (!parser->allows_scalar_root && type != JSIMPLON_TOKEN_LBRACE && type != JSIMPLON_TOKEN_LBRACKET) {
+				jsimplon_parser_expected_token(parser, "'{' or '['");
+				break;
+			}
+			// fallthrough
+		case JSIMPLON_EXPECT_VALUE:
+			if (type == JSIMPLON_TOKEN_LBRACE || type == JSIMPLON_TOKEN_LBRACKET) {
+				jsimplon_value_open(parser->value, allocator, type == JSIMPLON_TOKEN_LBRACE ? JSIMPLON_VALUE_OBJECT : JSIMPLON_VALUE_ARRAY);
+
+				if (parser->is_lazy && parser->stack_count > 0) {
+					if (jsimplon_parser_skip(parser, parser->value) == JSIMPLON_SUCCESS)
+						parser->expecting = JSIMPLON_EXPECT_NEXT;
+
+					break;
+				}
+
+				if (jsimplon_parser_push(parser, parser->value) != JSIMPLON_SUCCESS) {
+					jsimplon_parser_too_deep(parser, parser->token.line, parser->token.column);
+					break;
+				}
+
+				parser->expecting = type == JSIMPLON_TOKEN_LBRACE ? JSIMPLON_EXPECT_KEY : JSIMPLON_EXPECT_ELEMENT;
+			}
+			else if (jsimplon_parser_parse_scalar(parser, parser->value) == JSIMPLON_SUCCESS) {
+				parser->expecting = JSIMPLON_EXPECT_NEXT;
+			}
+			else {
+				jsimplon_parser_expected_token(parser, "JSON value");
+			}
+
+			break;
+		case JSIMPLON_EXPECT_KEY: {
+			// '}' after a ',' would be a trailing comma
+			if (type == JSIMPLON_TOKEN_RBRACE && container->object_value->members_count == 0) {
+				--parser->stack_count;
+				parser->expecting = JSIMPLON_EXPECT_NEXT;
+				break;
+			}
+
+			if (type != JSIMPLON_TOKEN_STRING_LITERAL) {
+				jsimplon_parser_expected_token(parser, "string literal");
+				break;
+			}
+
+			Jsimplon_Object *object = container->object_value;
+
+			if (object->members_count == object->members_size)
+				jsimplon_object_grow(allocator, object);
+
+			Jsimplon_Member *member = &object->members[object->members_count++];
+			*member = (Jsimplon_Member){ .value.tag = (uintptr_t)document };
+			jsimplon_member_take_key(member, &parser->lexer, &parser->token);
+
+			parser->value = &member->value;
+			parser->expecting = JSIMPLON_EXPECT_COLON;
+			break;
+		}
+		case JSIMPLON_EXPECT_COLON:
+			if (type != JSIMPLON_TOKEN_COLON) {
+				jsimplon_parser_expected_token(parser, "':'");
+				break;
+			}
+
+			parser->expecting = JSIMPLON_EXPECT_VALUE;
+			break;
+		case JSIMPLON_EXPECT_NEXT: {
+			if (container == NULL) {
+				if (type != JSIMPLON_TOKEN_END)
+					jsimplon_parser_expected_token(parser, "the end of the input");
+
+				break;
+			}
+
+			bool is_object = jsimplon_tag_type(container->tag) == JSIMPLON_VALUE_OBJECT;
+
+			if (type == JSIMPLON_TOKEN_COMMA) {
+				parser->expecting = is_object ? JSIMPLON_EXPECT_KEY : JSIMPLON_EXPECT_ELEMENT;
+			}
+			else if (type == (is_object ? JSIMPLON_TOKEN_RBRACE : JSIMPLON_TOKEN_RBRACKET)) {
+				// Indexed as soon as it's complete, so reading a parsed tree never writes to it
+				if (is_object)
+					jsimplon_object_index_update(container->object_value);
+
+				--parser->stack_count;
+			}
+			else
+				jsimplon_parser_expected_token(parser, is_object ? "',' or '}'" : "',' or ']'");
+
+			break;
+		}
+	}
+
+	// The string the error is about never made it into the tree
+	if (parser->error_count > error_count)
+		jsimplon_parser_discard_token(parser);
+}
+
+JSIMPLON_DEF_INTERNAL void jsimplon_parser_discard_token(Jsimplon_Parser *parser)
+{
+	if (parser->token.type != JSIMPLON_TOKEN_STRING_LITERAL)
+		return;
+
+	Jsimplon_Value orphan = { .tag = (uintptr_t)parser->lexer.document };
+
+	jsimplon_parser_parse_scalar(parser, &orphan);
+	jsimplon_value_destroy(&orphan);
+}
+
+// Strings are owned by the value they're moved into, anything else fails without reporting
+JSIMPLON_DEF_INTERNAL int jsimplon_parser_parse_scalar(Jsimplon_Parser *parser, Jsimplon_Value *value)
+{
+	switch (parser->token.type) {
+		case JSIMPLON_TOKEN_STRING_LITERAL:
+			jsimplon_value_take_str(value, &parser->lexer, &parser->token);
+			break;
+		case JSIMPLON_TOKEN_NUMBER_LITERAL:
+			jsimplon_value_retag(value, JSIMPLON_VALUE_NUMBER, 0);
+			value->number_value = parser->token.number;
+			break;
+		case JSIMPLON_TOKEN_INTEGER_LITERAL:
+			jsimplon_value_retag(value, JSIMPLON_VALUE_INTEGER, parser->token.is_unsigned ? JSIMPLON_FLAG_UNSIGNED : 0);
+			value->integer_value = parser->token.integer;
+			break;
+		case JSIMPLON_TOKEN_TRUE:
+			jsimplon_value_retag(value, JSIMPLON_VALUE_BOOL, 0);
+			value->bool_value = true;
+			break;
+		case JSIMPLON_TOKEN_FALSE:
+			jsimplon_value_retag(value, JSIMPLON_VALUE_BOOL, 0);
+			value->bool_value = false;
+			break;
+		case JSIMPLON_TOKEN_NULL:
+			jsimplon_value_retag(value, JSIMPLON_VALUE_NULL, 0);
+			value->null_value = NULL;
+			break;
+		default:
+			return JSIMPLON_FAILURE;
+	}
+
+	return JSIMPLON_SUCCESS;
+}
+
+// Fails once the stack is max_depth deep, the caller reports it since only it knows where it is
+JSIMPLON_DEF_INTERNAL int jsimplon_parser_push(Jsimplon_Parser *parser, Jsimplon_Value *container)
+{
+	if (parser->stack_count == parser->max_depth)
+		return JSIMPLON_FAILURE;
+
+	if (parser->stack_count == parser->stack_size) {
+		parser->stack_size = parser->stack_size == 0 ? 32 : parser->stack_size * 2;
+		parser->stack = realloc(parser->stack, parser->stack_size * sizeof *parser->stack);
+	}
+
+	parser->stack[parser->stack_count++] = container;
+
+	return JSIMPLON_SUCCESS;
+}
+
+// The container whose opening token was just lexed, and which has just been opened, is made lazy and the lexer moves on
+// past its end
+JSIMPLON_DEF_INTERNAL int jsimplon_parser_skip(Jsimplon_Parser *parser, Jsimplon_Value *container)
+{
+	Jsimplon_Lexer *lexer = &parser->lexer;
+	size_t begin = lexer->index - 1;
+	size_t too_deep;
+	// The container itself isn't pushed, it would be one level below the innermost open one
+	size_t end = jsimplon_skip_container(lexer->src, lexer->index, lexer->src_len, (uint64_t)parser->max_depth - parser->stack_count, &too_deep);
+
+	if (too_deep != SIZE_MAX) {
+		Jsimplon_Token token = { 0 };
+		jsimplon_lexer_locate(lexer, &token, too_deep);
+		jsimplon_parser_too_deep(parser, token.line, token.column);
+
+		return JSIMPLON_FAILURE;
+	}
+
+	if (end == SIZE_MAX) {
+		jsimplon_append_str(
+			lexer->error, lexer->error_size,
+			"parser error: %u:%u: '%c' is never closed\n",
+			parser->token.line, parser->token.column,
+			lexer->src[begin]
+		);
+		++parser->error_count;
+
+		return JSIMPLON_FAILURE;
+	}
+
+	for (const char *newline; (newline = memchr(&lexer->src[lexer->index], '\n', end - lexer->index)) != NULL;) {
+		lexer->index = newline - lexer->src + 1;
+		lexer->begin_of_line = lexer->index;
+		++lexer->line;
+	}
+
+	lexer->index = end;
+
+	Jsimplon_Lazy lazy = {
+		.src = lexer->insitu_src != NULL ? &lexer->insitu_src[begin] : (char *)&lexer->src[begin],
+		.length = end - begin
+	};
+	uint32_t flags = JSIMPLON_FLAG_LAZY | (lexer->insitu_src != NULL ? JSIMPLON_FLAG_BORROWED : 0);
+
+	if (jsimplon_tag_type(container->tag) == JSIMPLON_VALUE_OBJECT) {
+		container->object_value->lazy = lazy;
+		container->object_value->tag |= (uintptr_t)flags << JSIMPLON_TAG_TYPE_BITS;
+	}
+	else {
+		container->array_value->lazy = lazy;
+		container->array_value->tag |= (uintptr_t)flags << JSIMPLON_TAG_TYPE_BITS;
+	}
+
+	return JSIMPLON_SUCCESS;
+}
+
+JSIMPLON_DEF_INTERNAL int jsimplon_value_load(Jsimplon_Value *value)
+{
+	switch (jsimplon_tag_type(value->tag)) {
+		case JSIMPLON_VALUE_OBJECT:
+			return jsimplon_object_load(value->object_value);
+		case JSIMPLON_VALUE_ARRAY:
+			return jsimplon_array_load(value->array_value);
+		default:
+			return JSIMPLON_SUCCESS;
+	}
+}
+
+// The header that's been handed out stays, the one the members were parsed into gives them up to it
+JSIMPLON_DEF_INTERNAL int jsimplon_object_load(Jsimplon_Object *object)
+{
+	if (!(jsimplon_tag_flags(object->tag) & JSIMPLON_FLAG_LAZY))
+		return JSIMPLON_SUCCESS;
+
+	Jsimplon_Value loaded;
+	if (jsimplon_lazy_parse(&object->lazy, object->tag, &loaded) != JSIMPLON_SUCCESS)
+		return JSIMPLON_FAILURE;
+
+	*object = *loaded.object_value;
+	jsimplon_document_free(jsimplon_tag_document(object->tag), loaded.object_value);
+
+	return JSIMPLON_SUCCESS;
+}
+
+JSIMPLON_DEF_INTERNAL int jsimplon_array_load(Jsimplon_Array *array)
+{
+	if (!(jsimplon_tag_flags(array->tag) & JSIMPLON_FLAG_LAZY))
+		return JSIMPLON_SUCCESS;
+
+	Jsimplon_Value loaded;
+	if (jsimplon_lazy_parse(&array->lazy, array->tag, &loaded) != JSIMPLON_SUCCESS)
+		return JSIMPLON_FAILURE;
+
+	*array = *loaded.array_value;
+	jsimplon_document_free(jsimplon_tag_document(array->tag), loaded.array_value);
+
+	return JSIMPLON_SUCCESS;
+}
+
+// Only one level is parsed, the containers in it are skipped over again. A container that fails is left as it was,
+// there's no one to tell why
+JSIMPLON_DEF_INTERNAL int jsimplon_lazy_parse(const Jsimplon_Lazy *lazy, uintptr_t tag, Jsimplon_Value *loaded)
+{
+	Jsimplon_Document *document = jsimplon_tag_document(tag);
+	bool is_insitu = jsimplon_tag_flags(tag) & JSIMPLON_FLAG_BORROWED;
+
+	*loaded = (Jsimplon_Value){ .tag = (uintptr_t)document };
+
+	Jsimplon_Parser parser = {
+		.lexer = {
+			.src        = lazy->src,
+			.src_len    = lazy->length,
+			.insitu_src = is_insitu ? lazy->src : NULL,
+			.validate_utf8 = document->validate_utf8,
+			.document   = document,
+			.allocator  = document,
+			.line       = 1
+		},
+		.value = loaded,
+		.expecting = JSIMPLON_EXPECT_VALUE,
+		// Only the container itself is pushed, how deep everything in it goes was checked when it was skipped over
+		.max_depth = UINT32_MAX,
+		.is_lazy = true
+	};
+
+	parser.token = jsimplon_lexer_next_token(&parser.lexer);
+	jsimplon_parser_parse_tokens(&parser);
+
+	free(parser.stack);
+
+	if (parser.error_count > 0 || parser.lexer.error_count > 0) {
+		jsimplon_value_destroy(loaded);
+		return JSIMPLON_FAILURE;
+	}
+
+	return JSIMPLON_SUCCESS;
+}
+
+JSIMPLON_DEF_INTERNAL void jsimplon_parser_too_deep(Jsimplon_Parser *parser, uint32_t line, uint32_t column)
+{
+	jsimplon_append_str(
+		parser->lexer.error, parser->lexer.error_size,
+		"parser error: %u:%u: nesting is deeper than %u levels\n",
+		line, column,
+		parser->max_depth
+	);
+	++parser->error_count;
+}
+
+JSIMPLON_DEF_INTERNAL void jsimplon_parser_expected_token(Jsimplon_Parser *parser, const char *expected)
+{
+	if (parser->token.type == JSIMPLON_TOKEN_END) {
+		jsimplon_append_str(
+			parser->lexer.error, parser->lexer.error_size,
+			"parser error: %u:%u: expected %s, got the end of the input\n",
+			parser->token.line, parser->token.column,
+			expected
+		);
+	}
+	else if (parser->token.type == JSIMPLON_TOKEN_STRING_LITERAL) {
+		jsimplon_append_str(
+			parser->lexer.error, parser->lexer.error_size,
+			"parser error: %u:%u: expected %s, got '%.*s'\n",
+			parser->token.line, parser->token.column,
+			expected, (int)parser->token.length, parser->token.value
+		);
+	}
+	else {
+		jsimplon_append_str(
+			parser->lexer.error, parser->lexer.error_size,
+			"parser error: %u:%u: expected %s, got '%s'\n",
+			parser->token.line, parser->token.column,
+			expected, jsimplon_token_to_str(parser->token)
+		);
+	}
+
+	++parser->error_count;
+}
+
+// Stage two of the structural engine: the index says where every value and punctuation mark starts, so the tree is
+// built in a single loop over it with an explicit stack of open containers and the lexer is only used for scalars
+JSIMPLON_DEF_INTERNAL Jsimplon_Value jsimplon_parser_parse_structural(Jsimplon_Parser *parser)
+{
+	Jsimplon_Lexer *lexer = &parser->lexer;
+	Jsimplon_Document *document = lexer->document;
+	Jsimplon_Document *allocator = lexer->allocator;
+	Jsimplon_Value root = { .tag = (uintptr_t)document };
+
+	const char *src = lexer->src;
+	size_t count;
+	uint32_t *index = jsimplon_structural_index(src, lexer->src_len, &count);
+
+	// Tokens start out unlocated, see jsimplon_lexer_locate
+	lexer->line = 0;
+
+	Jsimplon_Expecting expecting = JSIMPLON_EXPECT_VALUE;
+
+	Jsimplon_Value *value = &root;
+	size_t scalar_end = 0;
+
+	if (count == 0 || (!parser->allows_scalar_root && src[index[0]] != '{' && src[index[0]] != '[')) {
+		jsimplon_parser_expected(parser, count > 0 ? index[0] : lexer->src_len, "'{' or '['");
+		count = 0;
+	}
+
+	for (size_t i = 0; count > 0 && parser->error_count == 0 && lexer->error_count == 0;) {
+		size_t offset = i < count ? index[i++] : lexer->src_len;
+
+		// Nothing but whitespace may follow a scalar up to the next structural character
+		if (scalar_end != 0) {
+			uint32_t newline_count = 0;
+			size_t last_newline;
+
+			offset = jsimplon_scan_whitespace(src, scalar_end, offset, &newline_count, &last_newline);
+			scalar_end = 0;
+		}
+
+		char c = offset < lexer->src_len ? src[offset] : 0;
+
+		if (expecting == JSIMPLON_EXPECT_VALUE) {
+			Jsimplon_Token token = { 0 };
+			lexer->index = offset;
+
+			switch (offset < lexer->src_len ? jsimplon_char_classes[(uint8_t)c] : JSIMPLON_CHAR_OTHER) {
+				case JSIMPLON_CHAR_QUOTE:
+					token = jsimplon_lexer_lex_string(lexer, token);
+					break;
+				case JSIMPLON_CHAR_MINUS:
+				case JSIMPLON_CHAR_ZERO:
+				case JSIMPLON_CHAR_DIGIT:
+					token = jsimplon_lexer_lex_number(lexer, token);
+					break;
+				case JSIMPLON_CHAR_EXPONENT:
+				case JSIMPLON_CHAR_LETTER:
+					token = jsimplon_lexer_lex_literal(lexer, token);
+					break;
+				default:
+					if (c != '{' && c != '[') {
+						jsimplon_parser_expected(parser, offset, "JSON value");
+						break;
+					}
+
+					jsimplon_value_open(value, allocator, c == '{' ? JSIMPLON_VALUE_OBJECT : JSIMPLON_VALUE_ARRAY);
+
+					// An empty container counts as a level too, so the limit is checked before it can be closed
+					if (parser->stack_count == parser->max_depth) {
+						jsimplon_lexer_locate(lexer, &token, offset);
+						jsimplon_parser_too_deep(parser, token.line, token.column);
+						token = (Jsimplon_Token){ 0 };
+						break;
+					}
+
+					// Empty containers are closed right away
+					if (i < count && src[index[i]] == c + 2) {
+						++i;
+						expecting = JSIMPLON_EXPECT_NEXT;
+						break;
+					}
+
+					jsimplon_parser_push(parser, value);
+
+					if (c == '{') {
+						expecting = JSIMPLON_EXPECT_KEY;
+					}
+					else {
+						Jsimplon_Array *array = value->array_value;
+
+						if (array->values_count == array->values_size)
+							jsimplon_array_grow(allocator, array);
+
+						value = &array->values[array->values_count++];
+						*value = (Jsimplon_Value){ .tag = (uintptr_t)document };
+					}
+
+					break;
+			}
+
+			if (token.type != JSIMPLON_TOKEN_END) {
+				parser->token = token;
+				jsimplon_parser_parse_scalar(parser, value);
+
+				scalar_end = lexer->index;
+				expecting = JSIMPLON_EXPECT_NEXT;
+			}
+		}
+		else if (expecting == JSIMPLON_EXPECT_KEY) {
+			if (c != '\"') {
+				jsimplon_parser_expected(parser, offset, "string literal");
+				break;
+			}
+
+			lexer->index = offset;
+			Jsimplon_Token token = jsimplon_lexer_lex_string(lexer, (Jsimplon_Token){ 0 });
+
+			if (token.type == JSIMPLON_TOKEN_END)
+				break;
+
+			Jsimplon_Object *object = parser->stack[parser->stack_count - 1]->object_value;
+
+			if (object->members_count == object->members_size)
+				jsimplon_object_grow(allocator, object);
+
+			Jsimplon_Member *member = &object->members[object->members_count++];
+			*member = (Jsimplon_Member){ .value.tag = (uintptr_t)document };
+			jsimplon_member_take_key(member, lexer, &token);
+
+			value = &member->value;
+			scalar_end = lexer->index;
+			expecting = JSIMPLON_EXPECT_COLON;
+		}
+		else if (expecting == JSIMPLON_EXPECT_COLON) {
+			if (c != ':') {
+				jsimplon_parser_expected(parser, offset, "':'");
+				break;
+			}
+
+			expecting = JSIMPLON_EXPECT_VALUE;
+		}
+		else if (parser->stack_count == 0) {
+			if (offset < lexer->src_len)
+				jsimplon_parser_expected(parser, offset, "the end of the input");
+
+			break;
+		}
+		else {
+			Jsimplon_Value *container = parser->stack[parser->stack_count - 1];
+			bool is_object = jsimplon_tag_type(container->tag) == JSIMPLON_VALUE_OBJECT;
+
+			if (c == ',') {
+				if (is_object) {
+					expecting = JSIMPLON_EXPECT_KEY;
+				}
+				else {
+					Jsimplon_Array *array = container->array_value;
+
+					if (array->values_count == array->values_size)
+						jsimplon_array_grow(allocator, array);
+
+					value = &array->values[array->values_count++];
+					*value = (Jsimplon_Value){ .tag = (uintptr_t)document };
+					expecting = JSIMPLON_EXPECT_VALUE;
+				}
+			}
+			else if (c == (is_object ? '}' : ']')) {
+				if (is_object)
+					jsimplon_object_index_update(container->object_value);
+
+				--parser->stack_count;
+			}
+			else {
+				jsimplon_parser_expected(parser, offset, is_object ? "',' or '}'" : "',' or ']'");
+			}
+		}
+	}
+
+	free(index);
+
+	return root;
+}
+
+JSIMPLON_DEF_INTERNAL void jsimplon_parser_expected(Jsimplon_Parser *parser, size_t offset, const char *expected)
+{
+	Jsimplon_Token token = { 0 };
+	jsimplon_lexer_locate(&parser->lexer, &token, offset);
+
+	if (offset < parser->lexer.src_len) {
+		jsimplon_append_str(
+			parser->lexer.error, parser->lexer.error_size,
+			"parser error: %u:%u: expected %s, got '%c'\n",
+			token.line, token.column,
+			expected, parser->lexer.src[offset]
+		);
+	}
+	else {
+		jsimplon_append_str(
+			parser->lexer.error, parser->lexer.error_size,
+			"parser error: %u:%u: expected %s, got the end of the input\n",
+			token.line, token.column,
+			expected
+		);
+	}
+
+	++parser->error_count;
+}
+
+/*
+ ** TODO: Refactor lexer to remove spaghetti code!!! **
+
+JSIMPLON_DEF_INTERNAL Jsimplon_Token jsimplon_lexer_next_token(Jsimplon_Lexer *l)
+{
+	char c;
+	size_t lexeme_index;
+	Jsimplon_Token token = {
+		.line = l->line,
+		.column = l->index - l->begin_of_line + 1
+	};
+
+	while (isspace(c = l->src[l->index]))
+		if (c == '\n') {
+			l->begin_of_line = l->index;
+			++l->line;
+		}
+
+		++l->index;
+	}
+
+	if (c == '\"') {
+		++l->index;
+
+		while ((c = l->src[l->index]) != '\"') {
+			
+		}
+	}
+
+	switch (c) {
+		case '\0':
+			break;
+		case '{':
+			token.type = JSIMPLON_TOKEN_LBRACE;
+			break;
+		case '}':
+			token.type = JSIMPLON_TOKEN_RBRACE;
+			break;
+		case '[':
+			token.type = JSIMPLON_TOKEN_LBRACKET;
+			break;
+		case ']':
+			token.type = JSIMPLON_TOKEN_RBRACKET;
+			break;
+		case ':':
+			token.type = JSIMPLON_TOKEN_COLON;
+			break;
+		case ',':
+			token.type = JSIMPLON_TOKEN_COMMA;
+			break;
+		default:
+			jsimplon_append_str(
+				l->error, l->error_size,
+				"lexer error: %u:%u: stray '%c'\n",
+				token.line, token.column,
+				c
+			);
+			++l->error_count;
+
+			break;
+	}
+
+	++l->index;
+
+	return token;
+}
+*/
+
+JSIMPLON_DEF_INTERNAL Jsimplon_Token jsimplon_lexer_next_token(Jsimplon_Lexer *lexer)
+{
+	while (true) {
+		jsimplon_lexer_skip_whitespace(lexer);
+
+		Jsimplon_Token token = {
+			.line = lexer->line,
+			.column = lexer->index - lexer->begin_of_line + 1
+		};
+
+		if (lexer->index >= lexer->src_len)
+			return token;
+
+		char c = lexer->src[lexer->index];
+
+		switch (jsimplon_char_classes[(uint8_t)c]) {
+			case JSIMPLON_CHAR_QUOTE:
+				return jsimplon_lexer_lex_string(lexer, token);
+			case JSIMPLON_CHAR_MINUS:
+			case JSIMPLON_CHAR_ZERO:
+			case JSIMPLON_CHAR_DIGIT:
+				token = jsimplon_lexer_lex_number(lexer, token);
+				break;
+			case JSIMPLON_CHAR_EXPONENT:
+			case JSIMPLON_CHAR_LETTER:
+				token = jsimplon_lexer_lex_literal(lexer, token);
+				break;
+			case JSIMPLON_CHAR_STRUCTURAL:
+				++lexer->index;
+
+				switch (c) {
+					case '{':
+						token.type = JSIMPLON_TOKEN_LBRACE;
+						break;
+					case '}':
+						token.type = JSIMPLON_TOKEN_RBRACE;
+						break;
+					case '[':
+						token.type = JSIMPLON_TOKEN_LBRACKET;
+						break;
+					case ']':
+						token.type = JSIMPLON_TOKEN_RBRACKET;
+						break;
+					case ':':
+						token.type = JSIMPLON_TOKEN_COLON;
+						break;
+					default:
+						token.type = JSIMPLON_TOKEN_COMMA;
+						break;
+				}
+
+				break;
+			default:
+				jsimplon_lexer_locate(lexer, &token, lexer->index);
+				jsimplon_append_str(
+					lexer->error, lexer->error_size,
+					"lexer error: %u:%u: stray '%c'\n",
+					token.line, token.column,
+					c
+				);
+				++lexer->error_count;
+				++lexer->index;
+
+				break;
+		}
+
+		// Malformed numbers and literals have been reported and skipped, carry on with the next token
+		if (token.type != JSIMPLON_TOKEN_END)
+			return token;
+	}
+}
+
+JSIMPLON_DEF_INTERNAL Jsimplon_Token jsimplon_lexer_lex_number(Jsimplon_Lexer *lexer, Jsimplon_Token token)
+{
+	const char *src = lexer->src;
+	size_t begin = lexer->index;
+	size_t end = begin;
+
+	uint8_t state = JSIMPLON_NUMBER_START;
+	uint8_t next_state;
+	uint8_t char_class;
+
+	while (true) {
+		char_class = end < lexer->src_len ? jsimplon_char_classes[(uint8_t)src[end]] : JSIMPLON_CHAR_OTHER;
+		next_state = jsimplon_number_transitions[state][char_class];
+
+		if (next_state >= JSIMPLON_NUMBER_DONE)
+			break;
+
+		state = next_state;
+		++end;
+	}
+
+	if (next_state == JSIMPLON_NUMBER_ERROR) {
+		jsimplon_lexer_locate(lexer, &token, begin);
+		jsimplon_append_str(
+			lexer->error, lexer->error_size,
+			"lexer error: %u:%u: malformed number literal '%.*s', %s\n",
+			token.line, token.column,
+			(int)(end - begin + (char_class >= JSIMPLON_CHAR_MINUS)), &src[begin],
+			jsimplon_number_expectations[state]
+		);
+		++lexer->error_count;
+
+		// Skip whatever is left of the malformed literal
+		while (end < lexer->src_len && jsimplon_char_classes[(uint8_t)src[end]] >= JSIMPLON_CHAR_MINUS)
+			++end;
+
+		lexer->index = end;
+
+		return token;
+	}
+
+	lexer->index = end;
+
+	if (lexer->is_slicing) {
+		token.type = JSIMPLON_TOKEN_NUMBER_LITERAL;
+		token.value = (char *)&src[begin];
+		token.length = end - begin;
+
+		return token;
+	}
+
+	// Integers that fit in 64 bits never touch floating point, 19 digits always fit and 20 only sometimes do
+	if (state == JSIMPLON_NUMBER_ZERO || state == JSIMPLON_NUMBER_INTEGER) {
+		bool negative = src[begin] == '-';
+		size_t digits_begin = begin + negative;
+		uint64_t magnitude = 0;
+		bool overflow = end - digits_begin > 20;
+
+		for (size_t i = digits_begin; i < end && !overflow; ++i) {
+			uint8_t digit = src[i] - '0';
+
+			overflow = magnitude > (UINT64_MAX - digit) / 10;
+			magnitude = magnitude * 10 + digit;
+		}
+
+		// -0 stays a double so its sign survives
+		if (!overflow && (!negative || (magnitude != 0 && magnitude <= (uint64_t)INT64_MAX + 1))) {
+			token.type = JSIMPLON_TOKEN_INTEGER_LITERAL;
+
+			if (negative)
+				token.integer = -(int64_t)(magnitude - 1) - 1;
+			else if (magnitude > INT64_MAX)
+				token.unsigned_integer = magnitude;
+			else
+				token.integer = (int64_t)magnitude;
+
+			token.is_unsigned = !negative && magnitude > INT64_MAX;
+
+			return token;
+		}
+	}
+
+	token.type = JSIMPLON_TOKEN_NUMBER_LITERAL;
+	token.number = jsimplon_number_parse(&src[begin], end - begin);
+
+	return token;
+}
+
+JSIMPLON_DEF_INTERNAL Jsimplon_Token jsimplon_lexer_lex_literal(Jsimplon_Lexer *lexer, Jsimplon_Token token)
+{
+	const char *lexeme = &lexer->src[lexer->index];
+	size_t remaining = lexer->src_len - lexer->index;
+	size_t length = 0;
+
+	// Every literal is matched with a single four byte compare
+	if (remaining >= 4 && jsimplon_load32(lexeme) == jsimplon_load32("true")) {
+		token.type = JSIMPLON_TOKEN_TRUE;
+		length = 4;
+	}
+	else if (remaining >= 5 && lexeme[0] == 'f' && jsimplon_load32(&lexeme[1]) == jsimplon_load32("alse")) {
+		token.type = JSIMPLON_TOKEN_FALSE;
+		length = 5;
+	}
+	else if (remaining >= 4 && jsimplon_load32(lexeme) == jsimplon_load32("null")) {
+		token.type = JSIMPLON_TOKEN_NULL;
+		length = 4;
+	}
+
+	// A literal has to end where the word ends, 'nullable' is not 'null'
+	size_t word_length = length;
+	while (word_length < remaining && jsimplon_char_classes[(uint8_t)lexeme[word_length]] >= JSIMPLON_CHAR_ZERO)
+		++word_length;
+
+	if (word_length != length || token.type == JSIMPLON_TOKEN_END) {
+		jsimplon_lexer_locate(lexer, &token, lexer->index);
+		jsimplon_append_str(
+			lexer->error, lexer->error_size,
+			"lexer error: %u:%u: unknown character sequence '%.*s'\n",
+			token.line, token.column,
+			(int)word_length, lexeme
+		);
+		++lexer->error_count;
+
+		token.type = JSIMPLON_TOKEN_END;
+	}
+
+	lexer->index += word_length;
+
+	return token;
+}
+
+// The structural engine doesn't keep track of lines, its tokens are located from their offset only once something goes wrong
+JSIMPLON_DEF_INTERNAL void jsimplon_lexer_locate(const Jsimplon_Lexer *lexer, Jsimplon_Token *token, size_t offset)
+{
+	if (token->line != 0)
+		return;
+
+	size_t begin_of_line = 0;
+	token->line = 1;
+
+	for (const char *newline; (newline = memchr(&lexer->src[begin_of_line], '\n', offset - begin_of_line)) != NULL;) {
+		begin_of_line = newline - lexer->src + 1;
+		++token->line;
+	}
+
+	token->column = offset - begin_of_line + 1;
+}
+
+JSIMPLON_DEF_INTERNAL void jsimplon_lexer_skip_whitespace(Jsimplon_Lexer *lexer)
+{
+	uint32_t newline_count = 0;
+	size_t last_newline;
+
+	lexer->index = jsimplon_scan_whitespace(lexer->src, lexer->index, lexer->src_len, &newline_count, &last_newline);
+
+	if (newline_count > 0) {
+		lexer->line += newline_count;
+		lexer->begin_of_line = last_newline + 1;
+	}
+}
+
+JSIMPLON_DEF_INTERNAL Jsimplon_Token jsimplon_lexer_lex_string(Jsimplon_Lexer *lexer, Jsimplon_Token token)
+{
+	const char *src = lexer->src;
+	size_t begin = ++lexer->index;
+	size_t end = begin;
+	size_t escape_overhead = 0; // How much shorter the escapes are decoded
+	bool has_nul = false;
+
+	// Find the closing quote first so the literal can be copied in one go, the escapes are checked on the way
+	while (true) {
+		end = jsimplon_scan_string(src, end, lexer->src_len);
+
+		if (end >= lexer->src_len || (src[end] == '\\' && end + 1 >= lexer->src_len)) {
+			jsimplon_lexer_locate(lexer, &token, begin - 1);
+			jsimplon_append_str(
+				lexer->error, lexer->error_size,
+				"lexer error: %u:%u: unterminated string literal\n",
+				token.line, token.column
+			);
+			++lexer->error_count;
+
+			lexer->index = lexer->src_len;
+
+			return token;
+		}
+
+		char c = src[end];
+
+		if (c == '\"')
+			break;
+
+		if (c == '\\') {
+			char decoded[4];
+			size_t escape_length;
+			size_t decoded_length = jsimplon_escape_decode(src, end, lexer->src_len, decoded, &escape_length, lexer->validate_utf8);
+
+			uint32_t code;
+			if (decoded_length == 0 && src[end + 1] == 'u' && jsimplon_hex4(src, end + 2, lexer->src_len, &code)) {
+				// Only strict decoding turns down a well-formed \u, for half a surrogate pair
+				jsimplon_lexer_locate(lexer, &token, begin - 1);
+				jsimplon_append_str(
+					lexer->error, lexer->error_size,
+					"lexer error: %u:%u: unpaired surrogate \\u%.4s in string literal\n",
+					token.line, token.column,
+					&src[end + 2]
+				);
+				++lexer->error_count;
+
+				lexer->index = end + 6;
+
+				return token;
+			}
+
+			if (decoded_length == 0) {
+				jsimplon_lexer_locate(lexer, &token, begin - 1);
+				jsimplon_append_str(
+					lexer->error, lexer->error_size,
+					"lexer error: %u:%u: invalid escape sequence in string literal %.*s\n",
 					token.line, token.column,
-					lexer->lexeme
+					(int)(end + 2 - begin), &src[begin]
+				);
+				++lexer->error_count;
+
+				lexer->index = end + 1;
+
+				return token;
+			}
+
+			escape_overhead += escape_length - decoded_length;
+			has_nul |= decoded_length == 1 && decoded[0] == '\0';
+			end += escape_length;
+
+			continue;
+		}
+
+		if (c == '\n') {
+			jsimplon_lexer_locate(lexer, &token, begin - 1);
+			jsimplon_append_str(
+				lexer->error, lexer->error_size,
+				"lexer error: %u:%u: newline character inserted in the middle of string literal %.*s\n",
+				token.line, token.column,
+				(int)(end - begin), &src[begin]
+			);
+			++lexer->error_count;
+
+			lexer->index = end + 1;
+
+			return token;
+		}
+
+		// Every other control character has to be escaped as well
+		jsimplon_lexer_locate(lexer, &token, begin - 1);
+		jsimplon_append_str(
+			lexer->error, lexer->error_size,
+			"lexer error: %u:%u: unescaped control character 0x%02X in string literal %.*s\n",
+			token.line, token.column,
+			(unsigned)(uint8_t)c,
+			(int)(end - begin), &src[begin]
+		);
+		++lexer->error_count;
+
+		lexer->index = end + 1;
+
+		return token;
+	}
+
+	size_t length = end - begin;
+
+	// Escapes are ASCII and decode to well-formed UTF-8, so the literal as written is what's checked
+	if (lexer->validate_utf8 && !jsimplon_utf8_validate(&src[begin], length)) {
+		jsimplon_lexer_locate(lexer, &token, begin - 1);
+		jsimplon_append_str(
+			lexer->error, lexer->error_size,
+			"lexer error: %u:%u: string literal is not valid UTF-8\n",
+			token.line, token.column
+		);
+		++lexer->error_count;
+
+		lexer->index = end + 1;
+
+		return token;
+	}
+
+	token.type = JSIMPLON_TOKEN_STRING_LITERAL;
+
+	if (lexer->is_slicing) {
+		token.value = (char *)&src[begin];
+		token.length = length;
+		lexer->index = end + 1;
+
+		return token;
+	}
+
+	// In place the literal is unescaped over itself and the closing quote makes room for the NUL, unless it decodes to
+	// a NUL, in place strings have nowhere to keep their length. Short ones are left in the lexer for the value or
+	// member to take in, the ones that are going to be interned are unescaped on the stack and looked up after
+	char buffer[JSIMPLON_INTERN_MAX_LENGTH + 1];
+	bool is_insitu = lexer->insitu_src != NULL && !has_nul;
+	bool is_short = lexer->insitu_src == NULL && length - escape_overhead < JSIMPLON_INLINE_STR_SIZE;
+	bool is_interned = lexer->insitu_src == NULL && !is_short && lexer->allocator != NULL && lexer->allocator->intern_strings
+		&& length - escape_overhead <= JSIMPLON_INTERN_MAX_LENGTH;
+
+	if (is_insitu)
+		token.value = &lexer->insitu_src[begin];
+	else if (is_short)
+		token.value = lexer->short_str;
+	else if (is_interned)
+		token.value = buffer;
+	else
+		token.value = jsimplon_document_string(lexer->allocator, length - escape_overhead);
+
+	if (escape_overhead == 0) {
+		if (!is_insitu)
+			memcpy(token.value, &src[begin], length);
+	}
+	else {
+		jsimplon_unescape(token.value, src, begin, end);
+	}
+
+	token.length = length - escape_overhead;
+	token.value[token.length] = 0;
+	lexer->index = end + 1;
+
+	if (is_interned) {
+		token.value = jsimplon_intern(&lexer->allocator->interns, buffer, token.length);
+		token.is_interned = true;
+	}
+
+	token.is_short = is_short;
+	token.is_copied = lexer->insitu_src != NULL && !is_insitu;
+
+	return token;
+}
+
+// 5^q for q in [-342, 308], normalised to 128 bits and truncated, high half first
+#define JSIMPLON_POWER_OF_FIVE_MIN (-342)
+#define JSIMPLON_POWER_OF_FIVE_MAX 308
+
+static const uint64_t jsimplon_powers_of_five[JSIMPLON_POWER_OF_FIVE_MAX - JSIMPLON_POWER_OF_FIVE_MIN + 1][2] = {
+	{ 0xEEF453D6923BD65AULL, 0x113FAA2906A13B3FULL }, { 0x9558B4661B6565F8ULL, 0x4AC7CA59A424C507ULL },
+	{ 0xBAAEE17FA23EBF76ULL, 0x5D79BCF00D2DF649ULL }, { 0xE95A99DF8ACE6F53ULL, 0xF4D82C2C107973DCULL },
+	{ 0x91D8A02BB6C10594ULL, 0x79071B9B8A4BE869ULL }, { 0xB64EC836A47146F9ULL, 0x9748E2826CDEE284ULL },
+	{ 0xE3E27A444D8D98B7ULL, 0xFD1B1B2308169B25ULL }, { 0x8E6D8C6AB0787F72ULL, 0xFE30F0F5E50E20F7ULL },
+	{ 0xB208EF855C969F4FULL, 0xBDBD2D335E51A935ULL }, { 0xDE8B2B66B3BC4723ULL, 0xAD2C788035E61382ULL },
+	{ 0x8B16FB203055AC76ULL, 0x4C3BCB5021AFCC31ULL }, { 0xADDCB9E83C6B1793ULL, 0xDF4ABE242A1BBF3DULL },
+	{ 0xD953E8624B85DD78ULL, 0xD71D6DAD34A2AF0DULL }, { 0x87D4713D6F33AA6BULL, 0x8672648C40E5AD68ULL },
+	{ 0xA9C98D8CCB009506ULL, 0x680EFDAF511F18C2ULL }, { 0xD43BF0EFFDC0BA48ULL, 0x0212BD1B2566DEF2ULL },
+	{ 0x84A57695FE98746DULL, 0x014BB630F7604B57ULL }, { 0xA5CED43B7E3E9188ULL, 0x419EA3BD35385E2DULL },
+	{ 0xCF42894A5DCE35EAULL, 0x52064CAC828675B9ULL }, { 0x818995CE7AA0E1B2ULL, 0x7343EFEBD1940993ULL },
+	{ 0xA1EBFB4219491A1FULL, 0x1014EBE6C5F90BF8ULL }, { 0xCA66FA129F9B60A6ULL, 0xD41A26E077774EF6ULL },
+	{ 0xFD00B897478238D0ULL, 0x8920B098955522B4ULL }, { 0x9E20735E8CB16382ULL, 0x55B46E5F5D5535B0ULL },
+	{ 0xC5A890362FDDBC62ULL, 0xEB2189F734AA831DULL }, { 0xF712B443BBD52B7BULL, 0xA5E9EC7501D523E4ULL },
+	{ 0x9A6BB0AA55653B2DULL, 0x47B233C92125366EULL }, { 0xC1069CD4EABE89F8ULL, 0x999EC0BB696E840AULL },
+	{ 0xF148440A256E2C76ULL, 0xC00670EA43CA250DULL }, { 0x96CD2A865764DBCAULL, 0x380406926A5E5728ULL },
+	{ 0xBC807527ED3E12BCULL, 0xC605083704F5ECF2ULL }, { 0xEBA09271E88D976BULL, 0xF7864A44C633682EULL },
+	{ 0x93445B8731587EA3ULL, 0x7AB3EE6AFBE0211DULL }, { 0xB8157268FDAE9E4CULL, 0x5960EA05BAD82964ULL },
+	{ 0xE61ACF033D1A45DFULL, 0x6FB92487298E33BDULL }, { 0x8FD0C16206306BABULL, 0xA5D3B6D479F8E056ULL },
+	{ 0xB3C4F1BA87BC8696ULL, 0x8F48A4899877186CULL }, { 0xE0B62E2929ABA83CULL, 0x331ACDABFE94DE87ULL },
+	{ 0x8C71DCD9BA0B4925ULL, 0x9FF0C08B7F1D0B14ULL }, { 0xAF8E5410288E1B6FULL, 0x07ECF0AE5EE44DD9ULL },
+	{ 0xDB71E91432B1A24AULL, 0xC9E82CD9F69D6150ULL }, { 0x892731AC9FAF056EULL, 0xBE311C083A225CD2ULL },
+	{ 0xAB70FE17C79AC6CAULL, 0x6DBD630A48AAF406ULL }, { 0xD64D3D9DB981787DULL, 0x092CBBCCDAD5B108ULL },
+	{ 0x85F0468293F0EB4EULL, 0x25BBF56008C58EA5ULL }, { 0xA76C582338ED2621ULL, 0xAF2AF2B80AF6F24EULL },
+	{ 0xD1476E2C07286FAAULL, 0x1AF5AF660DB4AEE1ULL }, { 0x82CCA4DB847945CAULL, 0x50D98D9FC890ED4DULL },
+	{ 0xA37FCE126597973CULL, 0xE50FF107BAB528A0ULL }, { 0xCC5FC196FEFD7D0CULL, 0x1E53ED49A96272C8ULL },
+	{ 0xFF77B1FCBEBCDC4FULL, 0x25E8E89C13BB0F7AULL }, { 0x9FAACF3DF73609B1ULL, 0x77B191618C54E9ACULL },
+	{ 0xC795830D75038C1DULL, 0xD59DF5B9EF6A2417ULL }, { 0xF97AE3D0D2446F25ULL, 0x4B0573286B44AD1DULL },
+	{ 0x9BECCE62836AC577ULL, 0x4EE367F9430AEC32ULL }, { 0xC2E801FB244576D5ULL, 0x229C41F793CDA73FULL },
+	{ 0xF3A20279ED56D48AULL, 0x6B43527578C1110FULL }, { 0x9845418C345644D6ULL, 0x830A13896B78AAA9ULL },
+	{ 0xBE5691EF416BD60CULL, 0x23CC986BC656D553ULL }, { 0xEDEC366B11C6CB8FULL, 0x2CBFBE86B7EC8AA8ULL },
+	{ 0x94B3A202EB1C3F39ULL, 0x7BF7D71432F3D6A9ULL }, { 0xB9E08A83A5E34F07ULL, 0xDAF5CCD93FB0CC53ULL },
+	{ 0xE858AD248F5C22C9ULL, 0xD1B3400F8F9CFF68ULL }, { 0x91376C36D99995BEULL, 0x23100809B9C21FA1ULL },
+	{ 0xB58547448FFFFB2DULL, 0xABD40A0C2832A78AULL }, { 0xE2E69915B3FFF9F9ULL, 0x16C90C8F323F516CULL },
+	{ 0x8DD01FAD907FFC3BULL, 0xAE3DA7D97F6792E3ULL }, { 0xB1442798F49FFB4AULL, 0x99CD11CFDF41779CULL },
+	{ 0xDD95317F31C7FA1DULL, 0x40405643D711D583ULL }, { 0x8A7D3EEF7F1CFC52ULL, 0x482835EA666B2572ULL },
+	{ 0xAD1C8EAB5EE43B66ULL, 0xDA3243650005EECFULL }, { 0xD863B256369D4A40ULL, 0x90BED43E40076A82ULL },
+	{ 0x873E4F75E2224E68ULL, 0x5A7744A6E804A291ULL }, { 0xA90DE3535AAAE202ULL, 0x711515D0A205CB36ULL },
+	{ 0xD3515C2831559A83ULL, 0x0D5A5B44CA873E03ULL }, { 0x8412D9991ED58091ULL, 0xE858790AFE9486C2ULL },
+	{ 0xA5178FFF668AE0B6ULL, 0x626E974DBE39A872ULL }, { 0xCE5D73FF402D98E3ULL, 0xFB0A3D212DC8128FULL },
+	{ 0x80FA687F881C7F8EULL, 0x7CE66634BC9D0B99ULL }, { 0xA139029F6A239F72ULL, 0x1C1FFFC1EBC44E80ULL },
+	{ 0xC987434744AC874EULL, 0xA327FFB266B56220ULL }, { 0xFBE9141915D7A922ULL, 0x4BF1FF9F0062BAA8ULL },
+	{ 0x9D71AC8FADA6C9B5ULL, 0x6F773FC3603DB4A9ULL }, { 0xC4CE17B399107C22ULL, 0xCB550FB4384D21D3ULL },
+	{ 0xF6019DA07F549B2BULL, 0x7E2A53A146606A48ULL }, { 0x99C102844F94E0FBULL, 0x2EDA7444CBFC426DULL },
+	{ 0xC0314325637A1939ULL, 0xFA911155FEFB5308ULL }, { 0xF03D93EEBC589F88ULL, 0x793555AB7EBA27CAULL },
+	{ 0x96267C7535B763B5ULL, 0x4BC1558B2F3458DEULL }, { 0xBBB01B9283253CA2ULL, 0x9EB1AAEDFB016F16ULL },
+	{ 0xEA9C227723EE8BCBULL, 0x465E15A979C1CADCULL }, { 0x92A1958A7675175FULL, 0x0BFACD89EC191EC9ULL },
+	{ 0xB749FAED14125D36ULL, 0xCEF980EC671F667BULL }, { 0xE51C79A85916F484ULL, 0x82B7E12780E7401AULL },
+	{ 0x8F31CC0937AE58D2ULL, 0xD1B2ECB8B0908810ULL }, { 0xB2FE3F0B8599EF07ULL, 0x861FA7E6DCB4AA15ULL },
+	{ 0xDFBDCECE67006AC9ULL, 0x67A791E093E1D49AULL }, { 0x8BD6A141006042BDULL, 0xE0C8BB2C5C6D24E0ULL },
+	{ 0xAECC49914078536DULL, 0x58FAE9F773886E18ULL }, { 0xDA7F5BF590966848ULL, 0xAF39A475506A899EULL },
+	{ 0x888F99797A5E012DULL, 0x6D8406C952429603ULL }, { 0xAAB37FD7D8F58178ULL, 0xC8E5087BA6D33B83ULL },
+	{ 0xD5605FCDCF32E1D6ULL, 0xFB1E4A9A90880A64ULL }, { 0x855C3BE0A17FCD26ULL, 0x5CF2EEA09A55067FULL },
+	{ 0xA6B34AD8C9DFC06FULL, 0xF42FAA48C0EA481EULL }, { 0xD0601D8EFC57B08BULL, 0xF13B94DAF124DA26ULL },
+	{ 0x823C12795DB6CE57ULL, 0x76C53D08D6B70858ULL }, { 0xA2CB1717B52481EDULL, 0x54768C4B0C64CA6EULL },
+	{ 0xCB7DDCDDA26DA268ULL, 0xA9942F5DCF7DFD09ULL }, { 0xFE5D54150B090B02ULL, 0xD3F93B35435D7C4CULL },
+	{ 0x9EFA548D26E5A6E1ULL, 0xC47BC5014A1A6DAFULL }, { 0xC6B8E9B0709F109AULL, 0x359AB6419CA1091BULL },
+	{ 0xF867241C8CC6D4C0ULL, 0xC30163D203C94B62ULL }, { 0x9B407691D7FC44F8ULL, 0x79E0DE63425DCF1DULL },
+	{ 0xC21094364DFB5636ULL, 0x985915FC12F542E4ULL }, { 0xF294B943E17A2BC4ULL, 0x3E6F5B7B17B2939DULL },
+	{ 0x979CF3CA6CEC5B5AULL, 0xA705992CEECF9C42ULL }, { 0xBD8430BD08277231ULL, 0x50C6FF782A838353ULL },
+	{ 0xECE53CEC4A314EBDULL, 0xA4F8BF5635246428ULL }, { 0x940F4613AE5ED136ULL, 0x871B7795E136BE99ULL },
+	{ 0xB913179899F68584ULL, 0x28E2557B59846E3FULL }, { 0xE757DD7EC07426E5ULL, 0x331AEADA2FE589CFULL },
+	{ 0x9096EA6F3848984FULL, 0x3FF0D2C85DEF7621ULL }, { 0xB4BCA50B065ABE63ULL, 0x0FED077A756B53A9ULL },
+	{ 0xE1EBCE4DC7F16DFBULL, 0xD3E8495912C62894ULL }, { 0x8D3360F09CF6E4BDULL, 0x64712DD7ABBBD95CULL },
+	{ 0xB080392CC4349DECULL, 0xBD8D794D96AACFB3ULL }, { 0xDCA04777F541C567ULL, 0xECF0D7A0FC5583A0ULL },
+	{ 0x89E42CAAF9491B60ULL, 0xF41686C49DB57244ULL }, { 0xAC5D37D5B79B6239ULL, 0x311C2875C522CED5ULL },
+	{ 0xD77485CB25823AC7ULL, 0x7D633293366B828BULL }, { 0x86A8D39EF77164BCULL, 0xAE5DFF9C02033197ULL },
+	{ 0xA8530886B54DBDEBULL, 0xD9F57F830283FDFCULL }, { 0xD267CAA862A12D66ULL, 0xD072DF63C324FD7BULL },
+	{ 0x8380DEA93DA4BC60ULL, 0x4247CB9E59F71E6DULL }, { 0xA46116538D0DEB78ULL, 0x52D9BE85F074E608ULL },
+	{ 0xCD795BE870516656ULL, 0x67902E276C921F8BULL }, { 0x806BD9714632DFF6ULL, 0x00BA1CD8A3DB53B6ULL },
+	{ 0xA086CFCD97BF97F3ULL, 0x80E8A40ECCD228A4ULL }, { 0xC8A883C0FDAF7DF0ULL, 0x6122CD128006B2CDULL },
+	{ 0xFAD2A4B13D1B5D6CULL, 0x796B805720085F81ULL }, { 0x9CC3A6EEC6311A63ULL, 0xCBE3303674053BB0ULL },
+	{ 0xC3F490AA77BD60FCULL, 0xBEDBFC4411068A9CULL }, { 0xF4F1B4D515ACB93BULL, 0xEE92FB5515482D44ULL },
+	{ 0x991711052D8BF3C5ULL, 0x751BDD152D4D1C4AULL }, { 0xBF5CD54678EEF0B6ULL, 0xD262D45A78A0635DULL },
+	{ 0xEF340A98172AACE4ULL, 0x86FB897116C87C34ULL }, { 0x9580869F0E7AAC0EULL, 0xD45D35E6AE3D4DA0ULL },
+	{ 0xBAE0A846D2195712ULL, 0x8974836059CCA109ULL }, { 0xE998D258869FACD7ULL, 0x2BD1A438703FC94BULL },
+	{ 0x91FF83775423CC06ULL, 0x7B6306A34627DDCFULL }, { 0xB67F6455292CBF08ULL, 0x1A3BC84C17B1D542ULL },
+	{ 0xE41F3D6A7377EECAULL, 0x20CABA5F1D9E4A93ULL }, { 0x8E938662882AF53EULL, 0x547EB47B7282EE9CULL },
+	{ 0xB23867FB2A35B28DULL, 0xE99E619A4F23AA43ULL }, { 0xDEC681F9F4C31F31ULL, 0x6405FA00E2EC94D4ULL },
+	{ 0x8B3C113C38F9F37EULL, 0xDE83BC408DD3DD04ULL }, { 0xAE0B158B4738705EULL, 0x9624AB50B148D445ULL },
+	{ 0xD98DDAEE19068C76ULL, 0x3BADD624DD9B0957ULL }, { 0x87F8A8D4CFA417C9ULL, 0xE54CA5D70A80E5D6ULL },
+	{ 0xA9F6D30A038D1DBCULL, 0x5E9FCF4CCD211F4CULL }, { 0xD47487CC8470652BULL, 0x7647C3200069671FULL },
+	{ 0x84C8D4DFD2C63F3BULL, 0x29ECD9F40041E073ULL }, { 0xA5FB0A17C777CF09ULL, 0xF468107100525890ULL },
+	{ 0xCF79CC9DB955C2CCULL, 0x7182148D4066EEB4ULL }, { 0x81AC1FE293D599BFULL, 0xC6F14CD848405530ULL },
+	{ 0xA21727DB38CB002FULL, 0xB8ADA00E5A506A7CULL }, { 0xCA9CF1D206FDC03BULL, 0xA6D90811F0E4851CULL },
+	{ 0xFD442E4688BD304AULL, 0x908F4A166D1DA663ULL }, { 0x9E4A9CEC15763E2EULL, 0x9A598E4E043287FEULL },
+	{ 0xC5DD44271AD3CDBAULL, 0x40EFF1E1853F29FDULL }, { 0xF7549530E188C128ULL, 0xD12BEE59E68EF47CULL },
+	{ 0x9A94DD3E8CF578B9ULL, 0x82BB74F8301958CEULL }, { 0xC13A148E3032D6E7ULL, 0xE36A52363C1FAF01ULL },
+	{ 0xF18899B1BC3F8CA1ULL, 0xDC44E6C3CB279AC1ULL }, { 0x96F5600F15A7B7E5ULL, 0x29AB103A5EF8C0B9ULL },
+	{ 0xBCB2B812DB11A5DEULL, 0x7415D448F6B6F0E7ULL }, { 0xEBDF661791D60F56ULL, 0x111B495B3464AD21ULL },
+	{ 0x936B9FCEBB25C995ULL, 0xCAB10DD900BEEC34ULL }, { 0xB84687C269EF3BFBULL, 0x3D5D514F40EEA742ULL },
+	{ 0xE65829B3046B0AFAULL, 0x0CB4A5A3112A5112ULL }, { 0x8FF71A0FE2C2E6DCULL, 0x47F0E785EABA72ABULL },
+	{ 0xB3F4E093DB73A093ULL, 0x59ED216765690F56ULL }, { 0xE0F218B8D25088B8ULL, 0x306869C13EC3532CULL },
+	{ 0x8C974F7383725573ULL, 0x1E414218C73A13FBULL }, { 0xAFBD2350644EEACFULL, 0xE5D1929EF90898FAULL },
+	{ 0xDBAC6C247D62A583ULL, 0xDF45F746B74ABF39ULL }, { 0x894BC396CE5DA772ULL, 0x6B8BBA8C328EB783ULL },
+	{ 0xAB9EB47C81F5114FULL, 0x066EA92F3F326564ULL }, { 0xD686619BA27255A2ULL, 0xC80A537B0EFEFEBDULL },
+	{ 0x8613FD0145877585ULL, 0xBD06742CE95F5F36ULL }, { 0xA798FC4196E952E7ULL, 0x2C48113823B73704ULL },
+	{ 0xD17F3B51FCA3A7A0ULL, 0xF75A15862CA504C5ULL }, { 0x82EF85133DE648C4ULL, 0x9A984D73DBE722FBULL },
+	{ 0xA3AB66580D5FDAF5ULL, 0xC13E60D0D2E0EBBAULL }, { 0xCC963FEE10B7D1B3ULL, 0x318DF905079926A8ULL },
+	{ 0xFFBBCFE994E5C61FULL, 0xFDF17746497F7052ULL }, { 0x9FD561F1FD0F9BD3ULL, 0xFEB6EA8BEDEFA633ULL },
+	{ 0xC7CABA6E7C5382C8ULL, 0xFE64A52EE96B8FC0ULL }, { 0xF9BD690A1B68637BULL, 0x3DFDCE7AA3C673B0ULL },
+	{ 0x9C1661A651213E2DULL, 0x06BEA10CA65C084EULL }, { 0xC31BFA0FE5698DB8ULL, 0x486E494FCFF30A62ULL },
+	{ 0xF3E2F893DEC3F126ULL, 0x5A89DBA3C3EFCCFAULL }, { 0x986DDB5C6B3A76B7ULL, 0xF89629465A75E01CULL },
+	{ 0xBE89523386091465ULL, 0xF6BBB397F1135823ULL }, { 0xEE2BA6C0678B597FULL, 0x746AA07DED582E2CULL },
+	{ 0x94DB483840B717EFULL, 0xA8C2A44EB4571CDCULL }, { 0xBA121A4650E4DDEBULL, 0x92F34D62616CE413ULL },
+	{ 0xE896A0D7E51E1566ULL, 0x77B020BAF9C81D17ULL }, { 0x915E2486EF32CD60ULL, 0x0ACE1474DC1D122EULL },
+	{ 0xB5B5ADA8AAFF80B8ULL, 0x0D819992132456BAULL }, { 0xE3231912D5BF60E6ULL, 0x10E1FFF697ED6C69ULL },
+	{ 0x8DF5EFABC5979C8FULL, 0xCA8D3FFA1EF463C1ULL }, { 0xB1736B96B6FD83B3ULL, 0xBD308FF8A6B17CB2ULL },
+	{ 0xDDD0467C64BCE4A0ULL, 0xAC7CB3F6D05DDBDEULL }, { 0x8AA22C0DBEF60EE4ULL, 0x6BCDF07A423AA96BULL },
+	{ 0xAD4AB7112EB3929DULL, 0x86C16C98D2C953C6ULL }, { 0xD89D64D57A607744ULL, 0xE871C7BF077BA8B7ULL },
+	{ 0x87625F056C7C4A8BULL, 0x11471CD764AD4972ULL }, { 0xA93AF6C6C79B5D2DULL, 0xD598E40D3DD89BCFULL },
+	{ 0xD389B47879823479ULL, 0x4AFF1D108D4EC2C3ULL }, { 0x843610CB4BF160CBULL, 0xCEDF722A585139BAULL },
+	{ 0xA54394FE1EEDB8FEULL, 0xC2974EB4EE658828ULL }, { 0xCE947A3DA6A9273EULL, 0x733D226229FEEA32ULL },
+	{ 0x811CCC668829B887ULL, 0x0806357D5A3F525FULL }, { 0xA163FF802A3426A8ULL, 0xCA07C2DCB0CF26F7ULL },
+	{ 0xC9BCFF6034C13052ULL, 0xFC89B393DD02F0B5ULL }, { 0xFC2C3F3841F17C67ULL, 0xBBAC2078D443ACE2ULL },
+	{ 0x9D9BA7832936EDC0ULL, 0xD54B944B84AA4C0DULL }, { 0xC5029163F384A931ULL, 0x0A9E795E65D4DF11ULL },
+	{ 0xF64335BCF065D37DULL, 0x4D4617B5FF4A16D5ULL }, { 0x99EA0196163FA42EULL, 0x504BCED1BF8E4E45ULL },
+	{ 0xC06481FB9BCF8D39ULL, 0xE45EC2862F71E1D6ULL }, { 0xF07DA27A82C37088ULL, 0x5D767327BB4E5A4CULL },
+	{ 0x964E858C91BA2655ULL, 0x3A6A07F8D510F86FULL }, { 0xBBE226EFB628AFEAULL, 0x890489F70A55368BULL },
+	{ 0xEADAB0ABA3B2DBE5ULL, 0x2B45AC74CCEA842EULL }, { 0x92C8AE6B464FC96FULL, 0x3B0B8BC90012929DULL },
+	{ 0xB77ADA0617E3BBCBULL, 0x09CE6EBB40173744ULL }, { 0xE55990879DDCAABDULL, 0xCC420A6A101D0515ULL },
+	{ 0x8F57FA54C2A9EAB6ULL, 0x9FA946824A12232DULL }, { 0xB32DF8E9F3546564ULL, 0x47939822DC96ABF9ULL },
+	{ 0xDFF9772470297EBDULL, 0x59787E2B93BC56F7ULL }, { 0x8BFBEA76C619EF36ULL, 0x57EB4EDB3C55B65AULL },
+	{ 0xAEFAE51477A06B03ULL, 0xEDE622920B6B23F1ULL }, { 0xDAB99E59958885C4ULL, 0xE95FAB368E45ECEDULL },
+	{ 0x88B402F7FD75539BULL, 0x11DBCB0218EBB414ULL }, { 0xAAE103B5FCD2A881ULL, 0xD652BDC29F26A119ULL },
+	{ 0xD59944A37C0752A2ULL, 0x4BE76D3346F0495FULL }, { 0x857FCAE62D8493A5ULL, 0x6F70A4400C562DDBULL },
+	{ 0xA6DFBD9FB8E5B88EULL, 0xCB4CCD500F6BB952ULL }, { 0xD097AD07A71F26B2ULL, 0x7E2000A41346A7A7ULL },
+	{ 0x825ECC24C873782FULL, 0x8ED400668C0C28C8ULL }, { 0xA2F67F2DFA90563BULL, 0x728900802F0F32FAULL },
+	{ 0xCBB41EF979346BCAULL, 0x4F2B40A03AD2FFB9ULL }, { 0xFEA126B7D78186BCULL, 0xE2F610C84987BFA8ULL },
+	{ 0x9F24B832E6B0F436ULL, 0x0DD9CA7D2DF4D7C9ULL }, { 0xC6EDE63FA05D3143ULL, 0x91503D1C79720DBBULL },
+	{ 0xF8A95FCF88747D94ULL, 0x75A44C6397CE912AULL }, { 0x9B69DBE1B548CE7CULL, 0xC986AFBE3EE11ABAULL },
+	{ 0xC24452DA229B021BULL, 0xFBE85BADCE996168ULL }, { 0xF2D56790AB41C2A2ULL, 0xFAE27299423FB9C3ULL },
+	{ 0x97C560BA6B0919A5ULL, 0xDCCD879FC967D41AULL }, { 0xBDB6B8E905CB600FULL, 0x5400E987BBC1C920ULL },
+	{ 0xED246723473E3813ULL, 0x290123E9AAB23B68ULL }, { 0x9436C0760C86E30BULL, 0xF9A0B6720AAF6521ULL },
+	{ 0xB94470938FA89BCEULL, 0xF808E40E8D5B3E69ULL }, { 0xE7958CB87392C2C2ULL, 0xB60B1D1230B20E04ULL },
+	{ 0x90BD77F3483BB9B9ULL, 0xB1C6F22B5E6F48C2ULL }, { 0xB4ECD5F01A4AA828ULL, 0x1E38AEB6360B1AF3ULL },
+	{ 0xE2280B6C20DD5232ULL, 0x25C6DA63C38DE1B0ULL }, { 0x8D590723948A535FULL, 0x579C487E5A38AD0EULL },
+	{ 0xB0AF48EC79ACE837ULL, 0x2D835A9DF0C6D851ULL }, { 0xDCDB1B2798182244ULL, 0xF8E431456CF88E65ULL },
+	{ 0x8A08F0F8BF0F156BULL, 0x1B8E9ECB641B58FFULL }, { 0xAC8B2D36EED2DAC5ULL, 0xE272467E3D222F3FULL },
+	{ 0xD7ADF884AA879177ULL, 0x5B0ED81DCC6ABB0FULL }, { 0x86CCBB52EA94BAEAULL, 0x98E947129FC2B4E9ULL },
+	{ 0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL }, { 0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL },
+	{ 0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL }, { 0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL },
+	{ 0xCDB02555653131B6ULL, 0x3792F412CB06794DULL }, { 0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL },
+	{ 0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL }, { 0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL },
+	{ 0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL }, { 0x9CED737BB6C4183DULL, 0x55464DD69685606BULL },
+	{ 0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL }, { 0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL },
+	{ 0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL }, { 0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL },
+	{ 0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL }, { 0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL },
+	{ 0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL }, { 0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL },
+	{ 0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL }, { 0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL },
+	{ 0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL }, { 0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL },
+	{ 0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL }, { 0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL },
+	{ 0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL }, { 0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL },
+	{ 0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL }, { 0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL },
+	{ 0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL }, { 0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL },
+	{ 0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL }, { 0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL },
+	{ 0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL }, { 0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL },
+	{ 0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL }, { 0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL },
+	{ 0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL }, { 0x9E74D1B791E07E48ULL, 0x775EA264CF55347EULL },
+	{ 0xC612062576589DDAULL, 0x95364AFE032A819EULL }, { 0xF79687AED3EEC551ULL, 0x3A83DDBD83F52205ULL },
+	{ 0x9ABE14CD44753B52ULL, 0xC4926A9672793543ULL }, { 0xC16D9A0095928A27ULL, 0x75B7053C0F178294ULL },
+	{ 0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6339ULL }, { 0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E04ULL },
+	{ 0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF585ULL }, { 0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E6ULL },
+	{ 0x9392EE8E921D5D07ULL, 0x3AFF322E62439FD0ULL }, { 0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C3ULL },
+	{ 0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B4ULL }, { 0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A11ULL },
+	{ 0xB424DC35095CD80FULL, 0x538484C19EF38C95ULL }, { 0xE12E13424BB40E13ULL, 0x2865A5F206B06FBAULL },
+	{ 0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D4ULL }, { 0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D749ULL },
+	{ 0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1CULL }, { 0x89705F4136B4A597ULL, 0x31680A88F8953031ULL },
+	{ 0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3EULL }, { 0xD6BF94D5E57A42BCULL, 0x3D32907604691B4DULL },
+	{ 0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B110ULL }, { 0xA7C5AC471B478423ULL, 0x0FCF80DC33721D54ULL },
+	{ 0xD1B71758E219652BULL, 0xD3C36113404EA4A9ULL }, { 0x83126E978D4FDF3BULL, 0x645A1CAC083126EAULL },
+	{ 0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A4ULL }, { 0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCDULL },
+	{ 0x8000000000000000ULL, 0x0000000000000000ULL }, { 0xA000000000000000ULL, 0x0000000000000000ULL },
+	{ 0xC800000000000000ULL, 0x0000000000000000ULL }, { 0xFA00000000000000ULL, 0x0000000000000000ULL },
+	{ 0x9C40000000000000ULL, 0x0000000000000000ULL }, { 0xC350000000000000ULL, 0x0000000000000000ULL },
+	{ 0xF424000000000000ULL, 0x0000000000000000ULL }, { 0x9896800000000000ULL, 0x0000000000000000ULL },
+	{ 0xBEBC200000000000ULL, 0x0000000000000000ULL }, { 0xEE6B280000000000ULL, 0x0000000000000000ULL },
+	{ 0x9502F90000000000ULL, 0x0000000000000000ULL }, { 0xBA43B74000000000ULL, 0x0000000000000000ULL },
+	{ 0xE8D4A51000000000ULL, 0x0000000000000000ULL }, { 0x9184E72A00000000ULL, 0x0000000000000000ULL },
+	{ 0xB5E620F480000000ULL, 0x0000000000000000ULL }, { 0xE35FA931A0000000ULL, 0x0000000000000000ULL },
+	{ 0x8E1BC9BF04000000ULL, 0x0000000000000000ULL }, { 0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL },
+	{ 0xDE0B6B3A76400000ULL, 0x0000000000000000ULL }, { 0x8AC7230489E80000ULL, 0x0000000000000000ULL },
+	{ 0xAD78EBC5AC620000ULL, 0x0000000000000000ULL }, { 0xD8D726B7177A8000ULL, 0x0000000000000000ULL },
+	{ 0x878678326EAC9000ULL, 0x0000000000000000ULL }, { 0xA968163F0A57B400ULL, 0x0000000000000000ULL },
+	{ 0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL }, { 0x84595161401484A0ULL, 0x0000000000000000ULL },
+	{ 0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL }, { 0xCECB8F27F4200F3AULL, 0x0000000000000000ULL },
+	{ 0x813F3978F8940984ULL, 0x4000000000000000ULL }, { 0xA18F07D736B90BE5ULL, 0x5000000000000000ULL },
+	{ 0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL }, { 0xFC6F7C4045812296ULL, 0x4D00000000000000ULL },
+	{ 0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL }, { 0xC5371912364CE305ULL, 0x6C28000000000000ULL },
+	{ 0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL }, { 0x9A130B963A6C115CULL, 0x3C7F400000000000ULL },
+	{ 0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL }, { 0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL },
+	{ 0x96769950B50D88F4ULL, 0x1314448000000000ULL }, { 0xBC143FA4E250EB31ULL, 0x17D955A000000000ULL },
+	{ 0xEB194F8E1AE525FDULL, 0x5DCFAB0800000000ULL }, { 0x92EFD1B8D0CF37BEULL, 0x5AA1CAE500000000ULL },
+	{ 0xB7ABC627050305ADULL, 0xF14A3D9E40000000ULL }, { 0xE596B7B0C643C719ULL, 0x6D9CCD05D0000000ULL },
+	{ 0x8F7E32CE7BEA5C6FULL, 0xE4820023A2000000ULL }, { 0xB35DBF821AE4F38BULL, 0xDDA2802C8A800000ULL },
+	{ 0xE0352F62A19E306EULL, 0xD50B2037AD200000ULL }, { 0x8C213D9DA502DE45ULL, 0x4526F422CC340000ULL },
+	{ 0xAF298D050E4395D6ULL, 0x9670B12B7F410000ULL }, { 0xDAF3F04651D47B4CULL, 0x3C0CDD765F114000ULL },
+	{ 0x88D8762BF324CD0FULL, 0xA5880A69FB6AC800ULL }, { 0xAB0E93B6EFEE0053ULL, 0x8EEA0D047A457A00ULL },
+	{ 0xD5D238A4ABE98068ULL, 0x72A4904598D6D880ULL }, { 0x85A36366EB71F041ULL, 0x47A6DA2B7F864750ULL },
+	{ 0xA70C3C40A64E6C51ULL, 0x999090B65F67D924ULL }, { 0xD0CF4B50CFE20765ULL, 0xFFF4B4E3F741CF6DULL },
+	{ 0x82818F1281ED449FULL, 0xBFF8F10E7A8921A4ULL }, { 0xA321F2D7226895C7ULL, 0xAFF72D52192B6A0DULL },
+	{ 0xCBEA6F8CEB02BB39ULL, 0x9BF4F8A69F764490ULL }, { 0xFEE50B7025C36A08ULL, 0x02F236D04753D5B4ULL },
+	{ 0x9F4F2726179A2245ULL, 0x01D762422C946590ULL }, { 0xC722F0EF9D80AAD6ULL, 0x424D3AD2B7B97EF5ULL },
+	{ 0xF8EBAD2B84E0D58BULL, 0xD2E0898765A7DEB2ULL }, { 0x9B934C3B330C8577ULL, 0x63CC55F49F88EB2FULL },
+	{ 0xC2781F49FFCFA6D5ULL, 0x3CBF6B71C76B25FBULL }, { 0xF316271C7FC3908AULL, 0x8BEF464E3945EF7AULL },
+	{ 0x97EDD871CFDA3A56ULL, 0x97758BF0E3CBB5ACULL }, { 0xBDE94E8E43D0C8ECULL, 0x3D52EEED1CBEA317ULL },
+	{ 0xED63A231D4C4FB27ULL, 0x4CA7AAA863EE4BDDULL }, { 0x945E455F24FB1CF8ULL, 0x8FE8CAA93E74EF6AULL },
+	{ 0xB975D6B6EE39E436ULL, 0xB3E2FD538E122B44ULL }, { 0xE7D34C64A9C85D44ULL, 0x60DBBCA87196B616ULL },
+	{ 0x90E40FBEEA1D3A4AULL, 0xBC8955E946FE31CDULL }, { 0xB51D13AEA4A488DDULL, 0x6BABAB6398BDBE41ULL },
+	{ 0xE264589A4DCDAB14ULL, 0xC696963C7EED2DD1ULL }, { 0x8D7EB76070A08AECULL, 0xFC1E1DE5CF543CA2ULL },
+	{ 0xB0DE65388CC8ADA8ULL, 0x3B25A55F43294BCBULL }, { 0xDD15FE86AFFAD912ULL, 0x49EF0EB713F39EBEULL },
+	{ 0x8A2DBF142DFCC7ABULL, 0x6E3569326C784337ULL }, { 0xACB92ED9397BF996ULL, 0x49C2C37F07965404ULL },
+	{ 0xD7E77A8F87DAF7FBULL, 0xDC33745EC97BE906ULL }, { 0x86F0AC99B4E8DAFDULL, 0x69A028BB3DED71A3ULL },
+	{ 0xA8ACD7C0222311BCULL, 0xC40832EA0D68CE0CULL }, { 0xD2D80DB02AABD62BULL, 0xF50A3FA490C30190ULL },
+	{ 0x83C7088E1AAB65DBULL, 0x792667C6DA79E0FAULL }, { 0xA4B8CAB1A1563F52ULL, 0x577001B891185938ULL },
+	{ 0xCDE6FD5E09ABCF26ULL, 0xED4C0226B55E6F86ULL }, { 0x80B05E5AC60B6178ULL, 0x544F8158315B05B4ULL },
+	{ 0xA0DC75F1778E39D6ULL, 0x696361AE3DB1C721ULL }, { 0xC913936DD571C84CULL, 0x03BC3A19CD1E38E9ULL },
+	{ 0xFB5878494ACE3A5FULL, 0x04AB48A04065C723ULL }, { 0x9D174B2DCEC0E47BULL, 0x62EB0D64283F9C76ULL },
+	{ 0xC45D1DF942711D9AULL, 0x3BA5D0BD324F8394ULL }, { 0xF5746577930D6500ULL, 0xCA8F44EC7EE36479ULL },
+	{ 0x9968BF6ABBE85F20ULL, 0x7E998B13CF4E1ECBULL }, { 0xBFC2EF456AE276E8ULL, 0x9E3FEDD8C321A67EULL },
+	{ 0xEFB3AB16C59B14A2ULL, 0xC5CFE94EF3EA101EULL }, { 0x95D04AEE3B80ECE5ULL, 0xBBA1F1D158724A12ULL },
+	{ 0xBB445DA9CA61281FULL, 0x2A8A6E45AE8EDC97ULL }, { 0xEA1575143CF97226ULL, 0xF52D09D71A3293BDULL },
+	{ 0x924D692CA61BE758ULL, 0x593C2626705F9C56ULL }, { 0xB6E0C377CFA2E12EULL, 0x6F8B2FB00C77836CULL },
+	{ 0xE498F455C38B997AULL, 0x0B6DFB9C0F956447ULL }, { 0x8EDF98B59A373FECULL, 0x4724BD4189BD5EACULL },
+	{ 0xB2977EE300C50FE7ULL, 0x58EDEC91EC2CB657ULL }, { 0xDF3D5E9BC0F653E1ULL, 0x2F2967B66737E3EDULL },
+	{ 0x8B865B215899F46CULL, 0xBD79E0D20082EE74ULL }, { 0xAE67F1E9AEC07187ULL, 0xECD8590680A3AA11ULL },
+	{ 0xDA01EE641A708DE9ULL, 0xE80E6F4820CC9495ULL }, { 0x884134FE908658B2ULL, 0x3109058D147FDCDDULL },
+	{ 0xAA51823E34A7EEDEULL, 0xBD4B46F0599FD415ULL }, { 0xD4E5E2CDC1D1EA96ULL, 0x6C9E18AC7007C91AULL },
+	{ 0x850FADC09923329EULL, 0x03E2CF6BC604DDB0ULL }, { 0xA6539930BF6BFF45ULL, 0x84DB8346B786151CULL },
+	{ 0xCFE87F7CEF46FF16ULL, 0xE612641865679A63ULL }, { 0x81F14FAE158C5F6EULL, 0x4FCB7E8F3F60C07EULL },
+	{ 0xA26DA3999AEF7749ULL, 0xE3BE5E330F38F09DULL }, { 0xCB090C8001AB551CULL, 0x5CADF5BFD3072CC5ULL },
+	{ 0xFDCB4FA002162A63ULL, 0x73D9732FC7C8F7F6ULL }, { 0x9E9F11C4014DDA7EULL, 0x2867E7FDDCDD9AFAULL },
+	{ 0xC646D63501A1511DULL, 0xB281E1FD541501B8ULL }, { 0xF7D88BC24209A565ULL, 0x1F225A7CA91A4226ULL },
+	{ 0x9AE757596946075FULL, 0x3375788DE9B06958ULL }, { 0xC1A12D2FC3978937ULL, 0x0052D6B1641C83AEULL },
+	{ 0xF209787BB47D6B84ULL, 0xC0678C5DBD23A49AULL }, { 0x9745EB4D50CE6332ULL, 0xF840B7BA963646E0ULL },
+	{ 0xBD176620A501FBFFULL, 0xB650E5A93BC3D898ULL }, { 0xEC5D3FA8CE427AFFULL, 0xA3E51F138AB4CEBEULL },
+	{ 0x93BA47C980E98CDFULL, 0xC66F336C36B10137ULL }, { 0xB8A8D9BBE123F017ULL, 0xB80B0047445D4184ULL },
+	{ 0xE6D3102AD96CEC1DULL, 0xA60DC059157491E5ULL }, { 0x9043EA1AC7E41392ULL, 0x87C89837AD68DB2FULL },
+	{ 0xB454E4A179DD1877ULL, 0x29BABE4598C311FBULL }, { 0xE16A1DC9D8545E94ULL, 0xF4296DD6FEF3D67AULL },
+	{ 0x8CE2529E2734BB1DULL, 0x1899E4A65F58660CULL }, { 0xB01AE745B101E9E4ULL, 0x5EC05DCFF72E7F8FULL },
+	{ 0xDC21A1171D42645DULL, 0x76707543F4FA1F73ULL }, { 0x899504AE72497EBAULL, 0x6A06494A791C53A8ULL },
+	{ 0xABFA45DA0EDBDE69ULL, 0x0487DB9D17636892ULL }, { 0xD6F8D7509292D603ULL, 0x45A9D2845D3C42B6ULL },
+	{ 0x865B86925B9BC5C2ULL, 0x0B8A2392BA45A9B2ULL }, { 0xA7F26836F282B732ULL, 0x8E6CAC7768D7141EULL },
+	{ 0xD1EF0244AF2364FFULL, 0x3207D795430CD926ULL }, { 0x8335616AED761F1FULL, 0x7F44E6BD49E807B8ULL },
+	{ 0xA402B9C5A8D3A6E7ULL, 0x5F16206C9C6209A6ULL }, { 0xCD036837130890A1ULL, 0x36DBA887C37A8C0FULL },
+	{ 0x802221226BE55A64ULL, 0xC2494954DA2C9789ULL }, { 0xA02AA96B06DEB0FDULL, 0xF2DB9BAA10B7BD6CULL },
+	{ 0xC83553C5C8965D3DULL, 0x6F92829494E5ACC7ULL }, { 0xFA42A8B73ABBF48CULL, 0xCB772339BA1F17F9ULL },
+	{ 0x9C69A97284B578D7ULL, 0xFF2A760414536EFBULL }, { 0xC38413CF25E2D70DULL, 0xFEF5138519684ABAULL },
+	{ 0xF46518C2EF5B8CD1ULL, 0x7EB258665FC25D69ULL }, { 0x98BF2F79D5993802ULL, 0xEF2F773FFBD97A61ULL },
+	{ 0xBEEEFB584AFF8603ULL, 0xAAFB550FFACFD8FAULL }, { 0xEEAABA2E5DBF6784ULL, 0x95BA2A53F983CF38ULL },
+	{ 0x952AB45CFA97A0B2ULL, 0xDD945A747BF26183ULL }, { 0xBA756174393D88DFULL, 0x94F971119AEEF9E4ULL },
+	{ 0xE912B9D1478CEB17ULL, 0x7A37CD5601AAB85DULL }, { 0x91ABB422CCB812EEULL, 0xAC62E055C10AB33AULL },
+	{ 0xB616A12B7FE617AAULL, 0x577B986B314D6009ULL }, { 0xE39C49765FDF9D94ULL, 0xED5A7E85FDA0B80BULL },
+	{ 0x8E41ADE9FBEBC27DULL, 0x14588F13BE847307ULL }, { 0xB1D219647AE6B31CULL, 0x596EB2D8AE258FC8ULL },
+	{ 0xDE469FBD99A05FE3ULL, 0x6FCA5F8ED9AEF3BBULL }, { 0x8AEC23D680043BEEULL, 0x25DE7BB9480D5854ULL },
+	{ 0xADA72CCC20054AE9ULL, 0xAF561AA79A10AE6AULL }, { 0xD910F7FF28069DA4ULL, 0x1B2BA1518094DA04ULL },
+	{ 0x87AA9AFF79042286ULL, 0x90FB44D2F05D0842ULL }, { 0xA99541BF57452B28ULL, 0x353A1607AC744A53ULL },
+	{ 0xD3FA922F2D1675F2ULL, 0x42889B8997915CE8ULL }, { 0x847C9B5D7C2E09B7ULL, 0x69956135FEBADA11ULL },
+	{ 0xA59BC234DB398C25ULL, 0x43FAB9837E699095ULL }, { 0xCF02B2C21207EF2EULL, 0x94F967E45E03F4BBULL },
+	{ 0x8161AFB94B44F57DULL, 0x1D1BE0EEBAC278F5ULL }, { 0xA1BA1BA79E1632DCULL, 0x6462D92A69731732ULL },
+	{ 0xCA28A291859BBF93ULL, 0x7D7B8F7503CFDCFEULL }, { 0xFCB2CB35E702AF78ULL, 0x5CDA735244C3D43EULL },
+	{ 0x9DEFBF01B061ADABULL, 0x3A0888136AFA64A7ULL }, { 0xC56BAEC21C7A1916ULL, 0x088AAA1845B8FDD0ULL },
+	{ 0xF6C69A72A3989F5BULL, 0x8AAD549E57273D45ULL }, { 0x9A3C2087A63F6399ULL, 0x36AC54E2F678864BULL },
+	{ 0xC0CB28A98FCF3C7FULL, 0x84576A1BB416A7DDULL }, { 0xF0FDF2D3F3C30B9FULL, 0x656D44A2A11C51D5ULL },
+	{ 0x969EB7C47859E743ULL, 0x9F644AE5A4B1B325ULL }, { 0xBC4665B596706114ULL, 0x873D5D9F0DDE1FEEULL },
+	{ 0xEB57FF22FC0C7959ULL, 0xA90CB506D155A7EAULL }, { 0x9316FF75DD87CBD8ULL, 0x09A7F12442D588F2ULL },
+	{ 0xB7DCBF5354E9BECEULL, 0x0C11ED6D538AEB2FULL }, { 0xE5D3EF282A242E81ULL, 0x8F1668C8A86DA5FAULL },
+	{ 0x8FA475791A569D10ULL, 0xF96E017D694487BCULL }, { 0xB38D92D760EC4455ULL, 0x37C981DCC395A9ACULL },
+	{ 0xE070F78D3927556AULL, 0x85BBE253F47B1417ULL }, { 0x8C469AB843B89562ULL, 0x93956D7478CCEC8EULL },
+	{ 0xAF58416654A6BABBULL, 0x387AC8D1970027B2ULL }, { 0xDB2E51BFE9D0696AULL, 0x06997B05FCC0319EULL },
+	{ 0x88FCF317F22241E2ULL, 0x441FECE3BDF81F03ULL }, { 0xAB3C2FDDEEAAD25AULL, 0xD527E81CAD7626C3ULL },
+	{ 0xD60B3BD56A5586F1ULL, 0x8A71E223D8D3B074ULL }, { 0x85C7056562757456ULL, 0xF6872D5667844E49ULL },
+	{ 0xA738C6BEBB12D16CULL, 0xB428F8AC016561DBULL }, { 0xD106F86E69D785C7ULL, 0xE13336D701BEBA52ULL },
+	{ 0x82A45B450226B39CULL, 0xECC0024661173473ULL }, { 0xA34D721642B06084ULL, 0x27F002D7F95D0190ULL },
+	{ 0xCC20CE9BD35C78A5ULL, 0x31EC038DF7B441F4ULL }, { 0xFF290242C83396CEULL, 0x7E67047175A15271ULL },
+	{ 0x9F79A169BD203E41ULL, 0x0F0062C6E984D386ULL }, { 0xC75809C42C684DD1ULL, 0x52C07B78A3E60868ULL },
+	{ 0xF92E0C3537826145ULL, 0xA7709A56CCDF8A82ULL }, { 0x9BBCC7A142B17CCBULL, 0x88A66076400BB691ULL },
+	{ 0xC2ABF989935DDBFEULL, 0x6ACFF893D00EA435ULL }, { 0xF356F7EBF83552FEULL, 0x0583F6B8C4124D43ULL },
+	{ 0x98165AF37B2153DEULL, 0xC3727A337A8B704AULL }, { 0xBE1BF1B059E9A8D6ULL, 0x744F18C0592E4C5CULL },
+	{ 0xEDA2EE1C7064130CULL, 0x1162DEF06F79DF73ULL }, { 0x9485D4D1C63E8BE7ULL, 0x8ADDCB5645AC2BA8ULL },
+	{ 0xB9A74A0637CE2EE1ULL, 0x6D953E2BD7173692ULL }, { 0xE8111C87C5C1BA99ULL, 0xC8FA8DB6CCDD0437ULL },
+	{ 0x910AB1D4DB9914A0ULL, 0x1D9C9892400A22A2ULL }, { 0xB54D5E4A127F59C8ULL, 0x2503BEB6D00CAB4BULL },
+	{ 0xE2A0B5DC971F303AULL, 0x2E44AE64840FD61DULL }, { 0x8DA471A9DE737E24ULL, 0x5CEAECFED289E5D2ULL },
+	{ 0xB10D8E1456105DADULL, 0x7425A83E872C5F47ULL }, { 0xDD50F1996B947518ULL, 0xD12F124E28F77719ULL },
+	{ 0x8A5296FFE33CC92FULL, 0x82BD6B70D99AAA6FULL }, { 0xACE73CBFDC0BFB7BULL, 0x636CC64D1001550BULL },
+	{ 0xD8210BEFD30EFA5AULL, 0x3C47F7E05401AA4EULL }, { 0x8714A775E3E95C78ULL, 0x65ACFAEC34810A71ULL },
+	{ 0xA8D9D1535CE3B396ULL, 0x7F1839A741A14D0DULL }, { 0xD31045A8341CA07CULL, 0x1EDE48111209A050ULL },
+	{ 0x83EA2B892091E44DULL, 0x934AED0AAB460432ULL }, { 0xA4E4B66B68B65D60ULL, 0xF81DA84D5617853FULL },
+	{ 0xCE1DE40642E3F4B9ULL, 0x36251260AB9D668EULL }, { 0x80D2AE83E9CE78F3ULL, 0xC1D72B7C6B426019ULL },
+	{ 0xA1075A24E4421730ULL, 0xB24CF65B8612F81FULL }, { 0xC94930AE1D529CFCULL, 0xDEE033F26797B627ULL },
+	{ 0xFB9B7CD9A4A7443CULL, 0x169840EF017DA3B1ULL }, { 0x9D412E0806E88AA5ULL, 0x8E1F289560EE864EULL },
+	{ 0xC491798A08A2AD4EULL, 0xF1A6F2BAB92A27E2ULL }, { 0xF5B5D7EC8ACB58A2ULL, 0xAE10AF696774B1DBULL },
+	{ 0x9991A6F3D6BF1765ULL, 0xACCA6DA1E0A8EF29ULL }, { 0xBFF610B0CC6EDD3FULL, 0x17FD090A58D32AF3ULL },
+	{ 0xEFF394DCFF8A948EULL, 0xDDFC4B4CEF07F5B0ULL }, { 0x95F83D0A1FB69CD9ULL, 0x4ABDAF101564F98EULL },
+	{ 0xBB764C4CA7A4440FULL, 0x9D6D1AD41ABE37F1ULL }, { 0xEA53DF5FD18D5513ULL, 0x84C86189216DC5EDULL },
+	{ 0x92746B9BE2F8552CULL, 0x32FD3CF5B4E49BB4ULL }, { 0xB7118682DBB66A77ULL, 0x3FBC8C33221DC2A1ULL },
+	{ 0xE4D5E82392A40515ULL, 0x0FABAF3FEAA5334AULL }, { 0x8F05B1163BA6832DULL, 0x29CB4D87F2A7400EULL },
+	{ 0xB2C71D5BCA9023F8ULL, 0x743E20E9EF511012ULL }, { 0xDF78E4B2BD342CF6ULL, 0x914DA9246B255416ULL },
+	{ 0x8BAB8EEFB6409C1AULL, 0x1AD089B6C2F7548EULL }, { 0xAE9672ABA3D0C320ULL, 0xA184AC2473B529B1ULL },
+	{ 0xDA3C0F568CC4F3E8ULL, 0xC9E5D72D90A2741EULL }, { 0x8865899617FB1871ULL, 0x7E2FA67C7A658892ULL },
+	{ 0xAA7EEBFB9DF9DE8DULL, 0xDDBB901B98FEEAB7ULL }, { 0xD51EA6FA85785631ULL, 0x552A74227F3EA565ULL },
+	{ 0x8533285C936B35DEULL, 0xD53A88958F87275FULL }, { 0xA67FF273B8460356ULL, 0x8A892ABAF368F137ULL },
+	{ 0xD01FEF10A657842CULL, 0x2D2B7569B0432D85ULL }, { 0x8213F56A67F6B29BULL, 0x9C3B29620E29FC73ULL },
+	{ 0xA298F2C501F45F42ULL, 0x8349F3BA91B47B8FULL }, { 0xCB3F2F7642717713ULL, 0x241C70A936219A73ULL },
+	{ 0xFE0EFB53D30DD4D7ULL, 0xED238CD383AA0110ULL }, { 0x9EC95D1463E8A506ULL, 0xF4363804324A40AAULL },
+	{ 0xC67BB4597CE2CE48ULL, 0xB143C6053EDCD0D5ULL }, { 0xF81AA16FDC1B81DAULL, 0xDD94B7868E94050AULL },
+	{ 0x9B10A4E5E9913128ULL, 0xCA7CF2B4191C8326ULL }, { 0xC1D4CE1F63F57D72ULL, 0xFD1C2F611F63A3F0ULL },
+	{ 0xF24A01A73CF2DCCFULL, 0xBC633B39673C8CECULL }, { 0x976E41088617CA01ULL, 0xD5BE0503E085D813ULL },
+	{ 0xBD49D14AA79DBC82ULL, 0x4B2D8644D8A74E18ULL }, { 0xEC9C459D51852BA2ULL, 0xDDF8E7D60ED1219EULL },
+	{ 0x93E1AB8252F33B45ULL, 0xCABB90E5C942B503ULL }, { 0xB8DA1662E7B00A17ULL, 0x3D6A751F3B936243ULL },
+	{ 0xE7109BFBA19C0C9DULL, 0x0CC512670A783AD4ULL }, { 0x906A617D450187E2ULL, 0x27FB2B80668B24C5ULL },
+	{ 0xB484F9DC9641E9DAULL, 0xB1F9F660802DEDF6ULL }, { 0xE1A63853BBD26451ULL, 0x5E7873F8A0396973ULL },
+	{ 0x8D07E33455637EB2ULL, 0xDB0B487B6423E1E8ULL }, { 0xB049DC016ABC5E5FULL, 0x91CE1A9A3D2CDA62ULL },
+	{ 0xDC5C5301C56B75F7ULL, 0x7641A140CC7810FBULL }, { 0x89B9B3E11B6329BAULL, 0xA9E904C87FCB0A9DULL },
+	{ 0xAC2820D9623BF429ULL, 0x546345FA9FBDCD44ULL }, { 0xD732290FBACAF133ULL, 0xA97C177947AD4095ULL },
+	{ 0x867F59A9D4BED6C0ULL, 0x49ED8EABCCCC485DULL }, { 0xA81F301449EE8C70ULL, 0x5C68F256BFFF5A74ULL },
+	{ 0xD226FC195C6A2F8CULL, 0x73832EEC6FFF3111ULL }, { 0x83585D8FD9C25DB7ULL, 0xC831FD53C5FF7EABULL },
+	{ 0xA42E74F3D032F525ULL, 0xBA3E7CA8B77F5E55ULL }, { 0xCD3A1230C43FB26FULL, 0x28CE1BD2E55F35EBULL },
+	{ 0x80444B5E7AA7CF85ULL, 0x7980D163CF5B81B3ULL }, { 0xA0555E361951C366ULL, 0xD7E105BCC332621FULL },
+	{ 0xC86AB5C39FA63440ULL, 0x8DD9472BF3FEFAA7ULL }, { 0xFA856334878FC150ULL, 0xB14F98F6F0FEB951ULL },
+	{ 0x9C935E00D4B9D8D2ULL, 0x6ED1BF9A569F33D3ULL }, { 0xC3B8358109E84F07ULL, 0x0A862F80EC4700C8ULL },
+	{ 0xF4A642E14C6262C8ULL, 0xCD27BB612758C0FAULL }, { 0x98E7E9CCCFBD7DBDULL, 0x8038D51CB897789CULL },
+	{ 0xBF21E44003ACDD2CULL, 0xE0470A63E6BD56C3ULL }, { 0xEEEA5D5004981478ULL, 0x1858CCFCE06CAC74ULL },
+	{ 0x95527A5202DF0CCBULL, 0x0F37801E0C43EBC8ULL }, { 0xBAA718E68396CFFDULL, 0xD30560258F54E6BAULL },
+	{ 0xE950DF20247C83FDULL, 0x47C6B82EF32A2069ULL }, { 0x91D28B7416CDD27EULL, 0x4CDC331D57FA5441ULL },
+	{ 0xB6472E511C81471DULL, 0xE0133FE4ADF8E952ULL }, { 0xE3D8F9E563A198E5ULL, 0x58180FDDD97723A6ULL },
+	{ 0x8E679C2F5E44FF8FULL, 0x570F09EAA7EA7648ULL }
+};
+
+// Exactly representable powers of ten for the fast path
+static const double jsimplon_exact_powers_of_ten[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Correctly rounded, never allocates and doesn't care about the locale:
+// the first 19 significant digits go through Clinger's fast path or Eisel-Lemire,
+// only literals with more digits than that whose rounding is still ambiguous take the slow path
+JSIMPLON_DEF_INTERNAL double jsimplon_number_parse(const char *src, size_t length)
+{
+	const char *literal = src;
+	const char *end = &src[length];
+	bool negative = *src == '-';
+	src += negative;
+
+	uint64_t mantissa = 0;
+	int64_t exponent = 0;
+	uint32_t digit_count = 0;
+	bool truncated = false;
+
+	for (bool fraction = false; src < end; ++src) {
+		if (*src == '.') {
+			fraction = true;
+			continue;
+		}
+
+		if (*src == 'e' || *src == 'E')
+			break;
+
+		uint8_t digit = *src - '0';
+
+		if (digit_count < 19) {
+			mantissa = mantissa * 10 + digit;
+			digit_count += mantissa != 0; // Leading zeros don't count
+			exponent -= fraction;
+		}
+		else {
+			truncated |= digit != 0;
+			exponent += !fraction;
+		}
+	}
+
+	if (src < end) {
+		bool negative_exponent = *++src == '-';
+		src += *src == '-' || *src == '+';
+
+		// Anything past this is zero or infinity no matter the mantissa
+		int64_t value = 0;
+		for (; src < end; ++src)
+			if (value < 100000)
+				value = value * 10 + (*src - '0');
+
+		exponent += negative_exponent ? -value : value;
+	}
+
+	uint64_t bits;
+
+	if (mantissa == 0) {
+		bits = 0;
+	}
+#if FLT_EVAL_METHOD == 0
+	else if (!truncated && mantissa <= (UINT64_C(1) << 53) && exponent >= -22 && exponent <= 22) {
+		double value = (double)mantissa;
+		value = exponent < 0 ? value / jsimplon_exact_powers_of_ten[-exponent] : value * jsimplon_exact_powers_of_ten[exponent];
+
+		return negative ? -value : value;
+	}
+#endif
+	else {
+		bits = jsimplon_number_eisel_lemire(mantissa, exponent);
+
+		// The dropped digits put the exact value somewhere between mantissa and mantissa + 1
+		if (truncated && bits != jsimplon_number_eisel_lemire(mantissa + 1, exponent))
+			bits = jsimplon_number_slow_path(&literal[negative], length - negative);
+	}
+
+	bits |= (uint64_t)negative << 63;
+
+	double value;
+	memcpy(&value, &bits, sizeof value);
+
+	return value;
+}
+
+// Lemire, "Number Parsing at a Gigabyte per Second", with the fallback-free product of
+// Mushtak and Lemire, "Fast Number Parsing Without Fallback": mantissa * 10^exponent rounded to the nearest double
+JSIMPLON_DEF_INTERNAL uint64_t jsimplon_number_eisel_lemire(uint64_t mantissa, int64_t exponent)
+{
+	if (exponent < JSIMPLON_POWER_OF_FIVE_MIN)
+		return 0;
+
+	if (exponent > JSIMPLON_POWER_OF_FIVE_MAX)
+		return UINT64_C(0x7FF) << 52;
+
+	uint32_t leading_zeros = jsimplon_clz64(mantissa);
+	mantissa <<= leading_zeros;
+
+	const uint64_t *power = jsimplon_powers_of_five[exponent - JSIMPLON_POWER_OF_FIVE_MIN];
+	uint64_t high;
+	uint64_t low = jsimplon_mul128(mantissa, power[0], &high);
+
+	// Only the 55 bits on top matter, the low half of the power is needed when they could still carry
+	const uint64_t precision_mask = UINT64_MAX >> 55;
+	if ((high & precision_mask) == precision_mask) {
+		uint64_t second_high;
+		jsimplon_mul128(mantissa, power[1], &second_high);
+
+		low += second_high;
+		high += second_high > low;
+	}
+
+	uint32_t upper_bit = (uint32_t)(high >> 63);
+	uint64_t result = high >> (upper_bit + 9);
+	int64_t power2 = (((152170 + 65536) * exponent) >> 16) + 63 + upper_bit - leading_zeros + 1023;
+
+	// Subnormal
+	if (power2 <= 0) {
+		if (-power2 + 1 >= 64)
+			return 0;
+
+		result >>= -power2 + 1;
+		result += result & 1;
+		result >>= 1;
+
+		// Rounding up can make it the smallest normal number
+		return result;
+	}
+
+	// Exactly halfway between two doubles has to round to even, which the truncated product can't see on its own
+	if (low <= 1 && exponent >= -4 && exponent <= 23 && (result & 3) == 1 && (result << (upper_bit + 9)) == high)
+		result &= ~UINT64_C(1);
+
+	result += result & 1;
+	result >>= 1;
+
+	if (result >= (UINT64_C(2) << 52)) {
+		result = UINT64_C(1) << 52;
+		++power2;
+	}
+
+	if (power2 >= 0x7FF)
+		return UINT64_C(0x7FF) << 52;
+
+	return (result & ~(UINT64_C(1) << 52)) | (uint64_t)power2 << 52;
+}
+
+// Exact decimal to binary conversion with big decimal shifts, as done by Go's strconv
+JSIMPLON_DEF_INTERNAL uint64_t jsimplon_number_slow_path(const char *src, size_t length)
+{
+	// How far to shift when the decimal point is at a given position, and the most a single shift can do
+	static const uint8_t shifts[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+	const uint32_t scale_shift = 27;
+	const uint32_t max_shift = 60;
+
+	Jsimplon_Decimal decimal = { .count = 0 };
+	const char *end = &src[length];
+
+	for (bool fraction = false; src < end && *src != 'e' && *src != 'E'; ++src) {
+		if (*src == '.') {
+			fraction = true;
+			continue;
+		}
+
+		if (decimal.count == 0 && *src == '0') {
+			decimal.decimal_point -= fraction;
+			continue;
+		}
+
+		if (decimal.count < JSIMPLON_DECIMAL_MAX_DIGITS)
+			decimal.digits[decimal.count++] = *src - '0';
+		else
+			decimal.truncated |= *src != '0';
+
+		decimal.decimal_point += !fraction;
+	}
+
+	if (src < end) {
+		bool negative_exponent = *++src == '-';
+		src += *src == '-' || *src == '+';
+
+		int32_t value = 0;
+		for (; src < end; ++src)
+			if (value < 100000)
+				value = value * 10 + (*src - '0');
+
+		decimal.decimal_point += negative_exponent ? -value : value;
+	}
+
+	while (decimal.count > 0 && decimal.digits[decimal.count - 1] == 0)
+		--decimal.count;
+
+	if (decimal.count == 0 || decimal.decimal_point < -330)
+		return 0;
+
+	if (decimal.decimal_point > 310)
+		return UINT64_C(0x7FF) << 52;
+
+	// Scale into [0.5, 1) while keeping track of the binary exponent
+	int32_t power2 = 0;
+
+	while (decimal.decimal_point > 0) {
+		uint32_t shift = (size_t)decimal.decimal_point < sizeof shifts ? shifts[decimal.decimal_point] : scale_shift;
+		jsimplon_decimal_shift_right(&decimal, shift);
+		power2 += shift;
+	}
+
+	while (decimal.decimal_point < 0 || (decimal.decimal_point == 0 && decimal.digits[0] < 5)) {
+		uint32_t shift = (size_t)-decimal.decimal_point < sizeof shifts ? shifts[-decimal.decimal_point] : scale_shift;
+		jsimplon_decimal_shift_left(&decimal, shift);
+		power2 -= shift;
+	}
+
+	// [0.5, 1) to [1, 2)
+	--power2;
+
+	// Below the smallest normal exponent the number becomes subnormal
+	if (power2 < -1022) {
+		uint32_t shift = -1022 - power2;
+
+		while (shift > 0) {
+			uint32_t step = shift < max_shift ? shift : max_shift;
+			jsimplon_decimal_shift_right(&decimal, step);
+			shift -= step;
+		}
+
+		power2 = -1022;
+	}
+
+	if (power2 + 1023 >= 0x7FF)
+		return UINT64_C(0x7FF) << 52;
+
+	jsimplon_decimal_shift_left(&decimal, 53);
+	uint64_t result = jsimplon_decimal_rounded_integer(&decimal);
+
+	if (result == UINT64_C(2) << 52) {
+		result >>= 1;
+
+		if (++power2 + 1023 >= 0x7FF)
+			return UINT64_C(0x7FF) << 52;
+	}
+
+	// No implicit bit means a subnormal
+	if ((result & (UINT64_C(1) << 52)) == 0)
+		power2 = -1023;
+
+	return (result & ((UINT64_C(1) << 52) - 1)) | (uint64_t)(power2 + 1023) << 52;
+}
+
+JSIMPLON_DEF_INTERNAL void jsimplon_decimal_shift_left(Jsimplon_Decimal *decimal, uint32_t shift)
+{
+	// Written back to front, a digit shifted by at most 60 bits carries into at most 19 more
+	uint8_t digits[JSIMPLON_DECIMAL_MAX_DIGITS + 20];
+	size_t write = sizeof digits;
+	uint64_t carry = 0;
+
+	for (size_t read = decimal->count; read-- > 0;) {
+		carry += (uint64_t)decimal->digits[read] << shift;
+		digits[--write] = carry % 10;
+		carry /= 10;
+	}
+
+	for (; carry > 0; carry /= 10)
+		digits[--write] = carry % 10;
+
+	size_t count = sizeof digits - write;
+	decimal->decimal_point += (int32_t)(count - decimal->count);
+
+	if (count > JSIMPLON_DECIMAL_MAX_DIGITS) {
+		for (size_t i = write + JSIMPLON_DECIMAL_MAX_DIGITS; i < sizeof digits; ++i)
+			decimal->truncated |= digits[i] != 0;
+
+		count = JSIMPLON_DECIMAL_MAX_DIGITS;
+	}
+
+	while (count > 0 && digits[write + count - 1] == 0)
+		--count;
+
+	memcpy(decimal->digits, &digits[write], count);
+	decimal->count = count;
+}
+
+JSIMPLON_DEF_INTERNAL void jsimplon_decimal_shift_right(Jsimplon_Decimal *decimal, uint32_t shift)
+{
+	const uint64_t mask = (UINT64_C(1) << shift) - 1;
+	size_t read = 0;
+	size_t write = 0;
+	uint64_t remainder = 0;
+
+	// Pick up enough leading digits to produce the first one
+	for (; (remainder >> shift) == 0; ++read) {
+		if (read >= decimal->count) {
+			if (remainder == 0) {
+				decimal->count = 0;
+				return;
+			}
+
+			while ((remainder >> shift) == 0) {
+				remainder *= 10;
+				++read;
+			}
+
+			break;
+		}
+
+		remainder = remainder * 10 + decimal->digits[read];
+	}
+
+	decimal->decimal_point -= (int32_t)read - 1;
+
+	for (; read < decimal->count; ++read) {
+		uint8_t digit = decimal->digits[read];
+
+		decimal->digits[write++] = remainder >> shift;
+		remainder = (remainder & mask) * 10 + digit;
+	}
+
+	for (; remainder > 0; remainder = (remainder & mask) * 10) {
+		if (write < JSIMPLON_DECIMAL_MAX_DIGITS)
+			decimal->digits[write++] = remainder >> shift;
+		else if ((remainder >> shift) != 0)
+			decimal->truncated = true;
+	}
+
+	while (write > 0 && decimal->digits[write - 1] == 0)
+		--write;
+
+	decimal->count = write;
+}
+
+JSIMPLON_DEF_INTERNAL uint64_t jsimplon_decimal_rounded_integer(const Jsimplon_Decimal *decimal)
+{
+	if (decimal->decimal_point > 20)
+		return UINT64_MAX;
+
+	uint64_t result = 0;
+	int32_t i = 0;
+
+	for (; i < decimal->decimal_point && (uint32_t)i < decimal->count; ++i)
+		result = result * 10 + decimal->digits[i];
+
+	for (; i < decimal->decimal_point; ++i)
+		result *= 10;
+
+	// Round half to even, unless digits were dropped and it's really a little above half
+	int32_t point = decimal->decimal_point;
+	if (point >= 0 && (uint32_t)point < decimal->count) {
+		uint8_t digit = decimal->digits[point];
+
+		if (digit == 5 && (uint32_t)point + 1 == decimal->count)
+			result += decimal->truncated || (point > 0 && decimal->digits[point - 1] % 2 == 1);
+		else
+			result += digit >= 5;
+	}
+
+	return result;
+}
+
+// Shortest digits that read back as the same double, laid out the way JavaScript does:
+// integers up to 21 digits in full and without a fraction, plain decimals down to 1e-6, exponents otherwise
+JSIMPLON_DEF_INTERNAL size_t jsimplon_number_format(double number, char *buffer)
+{
+	char *dst = buffer;
+
+	if (signbit(number)) {
+		*dst++ = '-';
+		number = -number;
+	}
+
+	if (number == 0) {
+		*dst++ = '0';
+
+		return dst - buffer;
+	}
+
+	int32_t length;
+	int32_t decimal_exponent;
+	jsimplon_grisu2(number, dst, &length, &decimal_exponent);
+
+	// The digits are d1 d2 ... dn * 10^decimal_exponent, the point goes after point digits
+	int32_t point = length + decimal_exponent;
+
+	if (decimal_exponent >= 0 && point <= 21) {
+		// 1234e7 -> 12340000000
+		memset(&dst[length], '0', decimal_exponent);
+		dst += point;
+	}
+	else if (point > 0 && point <= 21) {
+		// 1234e-2 -> 12.34
+		memmove(&dst[point + 1], &dst[point], length - point);
+		dst[point] = '.';
+		dst += length + 1;
+	}
+	else if (point > -6 && point <= 0) {
+		// 1234e-6 -> 0.001234
+		int32_t offset = 2 - point;
+		memmove(&dst[offset], dst, length);
+		dst[0] = '0';
+		dst[1] = '.';
+		memset(&dst[2], '0', offset - 2);
+		dst += length + offset;
+	}
+	else {
+		// 1234e30 -> 1.234e33
+		if (length > 1) {
+			memmove(&dst[2], &dst[1], length - 1);
+			dst[1] = '.';
+			++length;
+		}
+
+		dst += length;
+		*dst++ = 'e';
+
+		int32_t exponent = point - 1;
+		if (exponent < 0) {
+			*dst++ = '-';
+			exponent = -exponent;
+		}
+
+		if (exponent >= 100)
+			*dst++ = '0' + exponent / 100;
+		if (exponent >= 10)
+			*dst++ = '0' + exponent / 10 % 10;
+		*dst++ = '0' + exponent % 10;
+	}
+
+	return dst - buffer;
+}
+
+// Two digits at a time out of a table of all pairs
+JSIMPLON_DEF_INTERNAL size_t jsimplon_integer_format(uint64_t magnitude, bool negative, char *buffer)
+{
+	static const char digit_pairs[] =
+		"0001020304050607080910111213141516171819"
+		"2021222324252627282930313233343536373839"
+		"4041424344454647484950515253545556575859"
+		"6061626364656667686970717273747576777879"
+		"8081828384858687888990919293949596979899";
+
+	char digits[20];
+	size_t begin = sizeof digits;
+
+	for (; magnitude >= 100; magnitude /= 100) {
+		begin -= 2;
+		memcpy(&digits[begin], &digit_pairs[magnitude % 100 * 2], 2);
+	}
+
+	if (magnitude >= 10) {
+		begin -= 2;
+		memcpy(&digits[begin], &digit_pairs[magnitude * 2], 2);
+	}
+	else {
+		digits[--begin] = '0' + (char)magnitude;
+	}
+
+	size_t length = negative + sizeof digits - begin;
+
+	buffer[0] = '-';
+	memcpy(&buffer[negative], &digits[begin], sizeof digits - begin);
+
+	return length;
+}
+
+// Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with Integers", after Milo Yip's implementation:
+// every digit string it produces reads back as the same double and is the shortest one for nearly all of them
+JSIMPLON_DEF_INTERNAL void jsimplon_grisu2(double number, char *digits, int32_t *length, int32_t *decimal_exponent)
+{
+	// 10^-348, 10^-340, ..., 10^340 normalised to 64 bits
+	static const uint64_t cached_powers_f[] = {
+	0xFA8FD5A0081C0288ULL, 0xBAAEE17FA23EBF76ULL, 0x8B16FB203055AC76ULL, 0xCF42894A5DCE35EAULL,
+	0x9A6BB0AA55653B2DULL, 0xE61ACF033D1A45DFULL, 0xAB70FE17C79AC6CAULL, 0xFF77B1FCBEBCDC4FULL,
+	0xBE5691EF416BD60CULL, 0x8DD01FAD907FFC3CULL, 0xD3515C2831559A83ULL, 0x9D71AC8FADA6C9B5ULL,
+	0xEA9C227723EE8BCBULL, 0xAECC49914078536DULL, 0x823C12795DB6CE57ULL, 0xC21094364DFB5637ULL,
+	0x9096EA6F3848984FULL, 0xD77485CB25823AC7ULL, 0xA086CFCD97BF97F4ULL, 0xEF340A98172AACE5ULL,
+	0xB23867FB2A35B28EULL, 0x84C8D4DFD2C63F3BULL, 0xC5DD44271AD3CDBAULL, 0x936B9FCEBB25C996ULL,
+	0xDBAC6C247D62A584ULL, 0xA3AB66580D5FDAF6ULL, 0xF3E2F893DEC3F126ULL, 0xB5B5ADA8AAFF80B8ULL,
+	0x87625F056C7C4A8BULL, 0xC9BCFF6034C13053ULL, 0x964E858C91BA2655ULL, 0xDFF9772470297EBDULL,
+	0xA6DFBD9FB8E5B88FULL, 0xF8A95FCF88747D94ULL, 0xB94470938FA89BCFULL, 0x8A08F0F8BF0F156BULL,
+	0xCDB02555653131B6ULL, 0x993FE2C6D07B7FACULL, 0xE45C10C42A2B3B06ULL, 0xAA242499697392D3ULL,
+	0xFD87B5F28300CA0EULL, 0xBCE5086492111AEBULL, 0x8CBCCC096F5088CCULL, 0xD1B71758E219652CULL,
+	0x9C40000000000000ULL, 0xE8D4A51000000000ULL, 0xAD78EBC5AC620000ULL, 0x813F3978F8940984ULL,
+	0xC097CE7BC90715B3ULL, 0x8F7E32CE7BEA5C70ULL, 0xD5D238A4ABE98068ULL, 0x9F4F2726179A2245ULL,
+	0xED63A231D4C4FB27ULL, 0xB0DE65388CC8ADA8ULL, 0x83C7088E1AAB65DBULL, 0xC45D1DF942711D9AULL,
+	0x924D692CA61BE758ULL, 0xDA01EE641A708DEAULL, 0xA26DA3999AEF774AULL, 0xF209787BB47D6B85ULL,
+	0xB454E4A179DD1877ULL, 0x865B86925B9BC5C2ULL, 0xC83553C5C8965D3DULL, 0x952AB45CFA97A0B3ULL,
+	0xDE469FBD99A05FE3ULL, 0xA59BC234DB398C25ULL, 0xF6C69A72A3989F5CULL, 0xB7DCBF5354E9BECEULL,
+	0x88FCF317F22241E2ULL, 0xCC20CE9BD35C78A5ULL, 0x98165AF37B2153DFULL, 0xE2A0B5DC971F303AULL,
+	0xA8D9D1535CE3B396ULL, 0xFB9B7CD9A4A7443CULL, 0xBB764C4CA7A44410ULL, 0x8BAB8EEFB6409C1AULL,
+	0xD01FEF10A657842CULL, 0x9B10A4E5E9913129ULL, 0xE7109BFBA19C0C9DULL, 0xAC2820D9623BF429ULL,
+	0x80444B5E7AA7CF85ULL, 0xBF21E44003ACDD2DULL, 0x8E679C2F5E44FF8FULL, 0xD433179D9C8CB841ULL,
+	0x9E19DB92B4E31BA9ULL, 0xEB96BF6EBADF77D9ULL, 0xAF87023B9BF0EE6BULL
+	};
+	static const int16_t cached_powers_e[] = {
+	-1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927,
+	-901, -874, -847, -821, -794, -768, -741, -715, -688, -661, -635, -608,
+	-582, -555, -529, -502, -475, -449, -422, -396, -369, -343, -316, -289,
+	-263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+	56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+	375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667,
+	694, 720, 747, 774, 800, 827, 853, 880, 907, 933, 960, 986,
+	1013, 1039, 1066
+	};
+
+	uint64_t bits;
+	memcpy(&bits, &number, sizeof bits);
+
+	int32_t biased_exponent = (int32_t)(bits >> 52);
+	Jsimplon_DiyFp v = { bits & ((UINT64_C(1) << 52) - 1), -1074 };
+
+	if (biased_exponent != 0) {
+		v.f += UINT64_C(1) << 52;
+		v.e = biased_exponent - 1075;
+	}
+
+	// The boundaries halfway to the neighbouring doubles, plus is normalised and minus brought to its exponent
+	Jsimplon_DiyFp plus = { (v.f << 1) + 1, v.e - 1 };
+	while ((plus.f & (UINT64_C(1) << 53)) == 0) {
+		plus.f <<= 1;
+		--plus.e;
+	}
+
+	plus.f <<= 10;
+	plus.e -= 10;
+
+	Jsimplon_DiyFp minus = v.f == UINT64_C(1) << 52
+		? (Jsimplon_DiyFp){ (v.f << 2) - 1, v.e - 2 }
+		: (Jsimplon_DiyFp){ (v.f << 1) - 1, v.e - 1 };
+
+	minus.f <<= minus.e - plus.e;
+	minus.e = plus.e;
+
+	// A power of ten that brings plus into [2^-60, 2^-32] once multiplied
+	double k_estimate = (-61 - plus.e) * 0.30102999566398114 + 347;
+	int32_t k = (int32_t)k_estimate;
+	if (k_estimate - k > 0.0)
+		++k;
+
+	uint32_t index = (uint32_t)(k >> 3) + 1;
+	*decimal_exponent = -(-348 + (int32_t)(index << 3));
+
+	Jsimplon_DiyFp cached_power = { cached_powers_f[index], cached_powers_e[index] };
+
+	uint32_t shift = jsimplon_clz64(v.f);
+	v.f <<= shift;
+	v.e -= shift;
+
+	Jsimplon_DiyFp w = jsimplon_diyfp_multiply(v, cached_power);
+	plus = jsimplon_diyfp_multiply(plus, cached_power);
+	minus = jsimplon_diyfp_multiply(minus, cached_power);
+
+	// Stay clear of the boundaries, the products are off by up to one unit
+	++minus.f;
+	--plus.f;
+
+	jsimplon_grisu2_digits(w, plus, plus.f - minus.f, digits, length, decimal_exponent);
+}
+
+JSIMPLON_DEF_INTERNAL void jsimplon_grisu2_digits(Jsimplon_DiyFp w, Jsimplon_DiyFp plus, uint64_t delta, char *digits, int32_t *length, int32_t *decimal_exponent)
+{
+	static const uint64_t powers_of_ten[] = {
+		UINT64_C(1), UINT64_C(10), UINT64_C(100), UINT64_C(1000), UINT64_C(10000),
+		UINT64_C(100000), UINT64_C(1000000), UINT64_C(10000000), UINT64_C(100000000), UINT64_C(1000000000),
+		UINT64_C(10000000000), UINT64_C(100000000000), UINT64_C(1000000000000), UINT64_C(10000000000000), UINT64_C(100000000000000),
+		UINT64_C(1000000000000000), UINT64_C(10000000000000000), UINT64_C(100000000000000000), UINT64_C(1000000000000000000), UINT64_C(10000000000000000000)
+	};
+
+	const uint32_t one_shift = -plus.e;
+	const uint64_t one_mask = (UINT64_C(1) << one_shift) - 1;
+	const uint64_t distance = plus.f - w.f; // How far the digits may be from w
+
+	uint32_t integral = (uint32_t)(plus.f >> one_shift);
+	uint64_t fractional = plus.f & one_mask;
+
+	int32_t kappa = 1;
+	while (kappa < 10 && integral >= powers_of_ten[kappa])
+		++kappa;
+
+	uint64_t rest;
+	uint64_t ten_kappa;
+	uint64_t scaled_distance;
+
+	*length = 0;
+
+	// Digits of the integral part until what is left fits in delta
+	while (true) {
+		if (kappa == 0) {
+			// Then of the fractional part
+			while (true) {
+				fractional *= 10;
+				delta *= 10;
+
+				char digit = (char)(fractional >> one_shift);
+				if (digit != 0 || *length != 0)
+					digits[(*length)++] = '0' + digit;
+
+				fractional &= one_mask;
+				--kappa;
+
+				if (fractional < delta)
+					break;
+			}
+
+			rest = fractional;
+			ten_kappa = UINT64_C(1) << one_shift;
+			scaled_distance = -kappa < 20 ? distance * powers_of_ten[-kappa] : 0;
+
+			break;
+		}
+
+		uint32_t divisor = (uint32_t)powers_of_ten[kappa - 1];
+		uint32_t digit = integral / divisor;
+		integral %= divisor;
+
+		if (digit != 0 || *length != 0)
+			digits[(*length)++] = '0' + (char)digit;
+
+		--kappa;
+		rest = ((uint64_t)integral << one_shift) + fractional;
+
+		if (rest <= delta) {
+			ten_kappa = powers_of_ten[kappa] << one_shift;
+			scaled_distance = distance;
+
+			break;
+		}
+	}
+
+	*decimal_exponent += kappa;
+
+	// Walk the last digit down while that gets closer to w and stays inside the boundaries
+	while (rest < scaled_distance && delta - rest >= ten_kappa &&
+		(rest + ten_kappa < scaled_distance || scaled_distance - rest > rest + ten_kappa - scaled_distance)) {
+		--digits[*length - 1];
+		rest += ten_kappa;
+	}
+}
+
+// Rounded to 64 bits
+JSIMPLON_DEF_INTERNAL Jsimplon_DiyFp jsimplon_diyfp_multiply(Jsimplon_DiyFp a, Jsimplon_DiyFp b)
+{
+	uint64_t high;
+	uint64_t low = jsimplon_mul128(a.f, b.f, &high);
+
+	return (Jsimplon_DiyFp){ high + (low >> 63), a.e + b.e + 64 };
+}
+
+JSIMPLON_DEF_INTERNAL uint64_t jsimplon_mul128(uint64_t a, uint64_t b, uint64_t *high)
+{
+#if defined(__SIZEOF_INT128__)
+	__extension__ unsigned __int128 product = (unsigned __int128)a * b;
+	*high = (uint64_t)(product >> 64);
+
+	return (uint64_t)product;
+#else
+	uint64_t a_low = (uint32_t)a, a_high = a >> 32;
+	uint64_t b_low = (uint32_t)b, b_high = b >> 32;
+
+	uint64_t low_low = a_low * b_low;
+	uint64_t high_low = a_high * b_low;
+	uint64_t low_high = a_low * b_high;
+	uint64_t middle = high_low + (low_low >> 32) + (uint32_t)low_high;
+
+	*high = a_high * b_high + (middle >> 32) + (low_high >> 32);
+
+	return (middle << 32) | (uint32_t)low_low;
+#endif
+}
+
+JSIMPLON_DEF_INTERNAL uint32_t jsimplon_clz64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_clzll(x);
+#else
+	uint32_t n = 0;
+	for (; (x & (UINT64_C(1) << 63)) == 0; x <<= 1)
+		++n;
+
+	return n;
+#endif
+}
+
+// SWAR helpers: the lowest flagged byte is always exact, the ones above it may be false positives
+#define JSIMPLON_SWAR_ONES  0x0101010101010101ULL
+#define JSIMPLON_SWAR_HIGHS 0x8080808080808080ULL
+#define JSIMPLON_SWAR_HAS_ZERO(x)    (((x) - JSIMPLON_SWAR_ONES) & ~(x) & JSIMPLON_SWAR_HIGHS)
+#define JSIMPLON_SWAR_HAS_BYTE(x, b) JSIMPLON_SWAR_HAS_ZERO((x) ^ (JSIMPLON_SWAR_ONES * (uint8_t)(b)))
+#define JSIMPLON_SWAR_HAS_LESS(x, n) (((x) - JSIMPLON_SWAR_ONES * (n)) & ~(x) & JSIMPLON_SWAR_HIGHS)
+
+JSIMPLON_DEF_INTERNAL size_t jsimplon_scan_string(const char *src, size_t index, size_t src_len)
+{
+#if defined(__AVX2__)
+	const __m256i quote_256     = _mm256_set1_epi8('\"');
+	const __m256i backslash_256 = _mm256_set1_epi8('\\');
+	const __m256i control_256   = _mm256_set1_epi8(0x1F);
+
+	for (; index + 32 <= src_len; index += 32) {
+		__m256i chunk = _mm256_loadu_si256((const __m256i *)&src[index]);
+		__m256i special = _mm256_or_si256(
+			_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote_256), _mm256_cmpeq_epi8(chunk, backslash_256)),
+			_mm256_cmpeq_epi8(_mm256_max_epu8(chunk, control_256), control_256)
+		);
+
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8(special);
+		if (mask != 0)
+			return index + jsimplon_ctz32(mask);
+	}
+#endif
+
+#if defined(__SSE2__)
+	const __m128i quote     = _mm_set1_epi8('\"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	const __m128i control   = _mm_set1_epi8(0x1F);
+
+	for (; index + 16 <= src_len; index += 16) {
+		__m128i chunk = _mm_loadu_si128((const __m128i *)&src[index]);
+		__m128i special = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+			_mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control)
+		);
+
+		uint32_t mask = (uint32_t)_mm_movemask_epi8(special);
+		if (mask != 0)
+			return index + jsimplon_ctz32(mask);
+	}
+#endif
+
+	for (; index + 8 <= src_len; index += 8) {
+		uint64_t word;
+		memcpy(&word, &src[index], sizeof word);
+
+		if ((JSIMPLON_SWAR_HAS_BYTE(word, '\"') | JSIMPLON_SWAR_HAS_BYTE(word, '\\') | JSIMPLON_SWAR_HAS_LESS(word, 0x20)) != 0)
+			break;
+	}
+
+	for (; index < src_len; ++index) {
+		unsigned char c = src[index];
+
+		if (c == '\"' || c == '\\' || c < 0x20)
+			break;
+	}
+
+	return index;
+}
+
+// dst may be src itself as long as it isn't ahead of it, every block is loaded before anything is stored over it
+JSIMPLON_DEF_INTERNAL size_t jsimplon_copy_span(char *dst, const char *src, size_t index, size_t end)
+{
+	size_t begin = index;
+
+#if defined(__AVX2__)
+	const __m256i backslash_256 = _mm256_set1_epi8('\\');
+
+	for (; index + 32 <= end; index += 32) {
+		__m256i chunk = _mm256_loadu_si256((const __m256i *)&src[index]);
+
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, backslash_256));
+		if (mask != 0) {
+			memmove(&dst[index - begin], &src[index], jsimplon_ctz32(mask));
+			return index - begin + jsimplon_ctz32(mask);
+		}
+
+		_mm256_storeu_si256((__m256i *)&dst[index - begin], chunk);
+	}
+#endif
+
+#if defined(__SSE2__)
+	const __m128i backslash = _mm_set1_epi8('\\');
+
+	for (; index + 16 <= end; index += 16) {
+		__m128i chunk = _mm_loadu_si128((const __m128i *)&src[index]);
+
+		uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslash));
+		if (mask != 0) {
+			memmove(&dst[index - begin], &src[index], jsimplon_ctz32(mask));
+			return index - begin + jsimplon_ctz32(mask);
+		}
+
+		_mm_storeu_si128((__m128i *)&dst[index - begin], chunk);
+	}
+#endif
+
+	for (; index + 8 <= end; index += 8) {
+		uint64_t word;
+		memcpy(&word, &src[index], sizeof word);
+
+		if (JSIMPLON_SWAR_HAS_BYTE(word, '\\') != 0)
+			break;
+
+		memcpy(&dst[index - begin], &word, sizeof word);
+	}
+
+	for (; index < end && src[index] != '\\'; ++index)
+		dst[index - begin] = src[index];
+
+	return index - begin;
+}
+
+// The escapes have already been checked, runs without any are copied a block at a time
+JSIMPLON_DEF_INTERNAL char *jsimplon_unescape(char *dst, const char *src, size_t index, size_t end)
+{
+	while (true) {
+		// Escapes often come one after the other, \u ones especially
+		if (src[index] != '\\') {
+			size_t span = jsimplon_copy_span(dst, src, index, end);
+			dst += span;
+			index += span;
+		}
+
+		if (index >= end)
+			return dst;
+
+		// Decoded before it's written, in place dst can be right behind it
+		char decoded[4];
+		size_t escape_length;
+		size_t decoded_length = jsimplon_escape_decode(src, index, end, decoded, &escape_length, false);
+
+		memcpy(dst, decoded, decoded_length);
+		dst += decoded_length;
+		index += escape_length;
+	}
+}
+
+// Decodes the escape at src[index] into at most 4 bytes of UTF-8, escape_length is how much of src it was.
+// A \u for half a surrogate pair is joined with the \u for the other half, one without the other is U+FFFD
+// unless is_strict, then it isn't an escape at all
+JSIMPLON_DEF_INTERNAL size_t jsimplon_escape_decode(const char *src, size_t index, size_t src_len, char *decoded, size_t *escape_length, bool is_strict)
+{
+	if (index + 1 >= src_len)
+		return 0;
+
+	*escape_length = 2;
+
+	switch (src[index + 1]) {
+		case '\"':  *decoded = '\"';  return 1;
+		case '\\': *decoded = '\\'; return 1;
+		case '/':  *decoded = '/';  return 1;
+		case 'b':  *decoded = '\b'; return 1;
+		case 'f':  *decoded = '\f'; return 1;
+		case 'n':  *decoded = '\n'; return 1;
+		case 'r':  *decoded = '\r'; return 1;
+		case 't':  *decoded = '\t'; return 1;
+		case 'u':  break;
+		default:   return 0;
+	}
+
+	uint32_t code;
+	if (!jsimplon_hex4(src, index + 2, src_len, &code))
+		return 0;
+
+	*escape_length = 6;
+
+	if (code >= 0xD800 && code <= 0xDBFF) {
+		uint32_t low;
+
+		if (index + 7 < src_len && src[index + 6] == '\\' && src[index + 7] == 'u'
+			&& jsimplon_hex4(src, index + 8, src_len, &low) && low >= 0xDC00 && low <= 0xDFFF) {
+			code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+			*escape_length = 12;
+		}
+		else if (is_strict) {
+			return 0;
+		}
+		else {
+			code = 0xFFFD;
+		}
+	}
+	else if (code >= 0xDC00 && code <= 0xDFFF) {
+		if (is_strict)
+			return 0;
+
+		code = 0xFFFD;
+	}
+
+	return jsimplon_utf8_encode(code, decoded);
+}
+
+JSIMPLON_DEF_INTERNAL bool jsimplon_hex4(const char *src, size_t index, size_t src_len, uint32_t *code)
+{
+	if (index + 4 > src_len)
+		return false;
+
+	*code = 0;
+
+	for (size_t i = index; i < index + 4; ++i) {
+		uint32_t digit = (uint32_t)(uint8_t)src[i] - '0';
+
+		// Setting 0x20 folds 'A'-'F' into 'a'-'f' and nothing else into them
+		if (digit > 9) {
+			digit = ((uint32_t)(uint8_t)src[i] | 0x20) - 'a';
+			if (digit > 5)
+				return false;
+			digit += 10;
+		}
+
+		*code = *code << 4 | digit;
+	}
+
+	return true;
+}
+
+JSIMPLON_DEF_INTERNAL size_t jsimplon_utf8_encode(uint32_t code, char *dst)
+{
+	if (code < 0x80) {
+		dst[0] = (char)code;
+		return 1;
+	}
+
+	if (code < 0x800) {
+		dst[0] = (char)(0xC0 | code >> 6);
+		dst[1] = (char)(0x80 | (code & 0x3F));
+		return 2;
+	}
+
+	if (code < 0x10000) {
+		dst[0] = (char)(0xE0 | code >> 12);
+		dst[1] = (char)(0x80 | (code >> 6 & 0x3F));
+		dst[2] = (char)(0x80 | (code & 0x3F));
+		return 3;
+	}
+
+	dst[0] = (char)(0xF0 | code >> 18);
+	dst[1] = (char)(0x80 | (code >> 12 & 0x3F));
+	dst[2] = (char)(0x80 | (code >> 6 & 0x3F));
+	dst[3] = (char)(0x80 | (code & 0x3F));
+	return 4;
+}
+
+JSIMPLON_DEF_INTERNAL size_t jsimplon_scan_ascii(const char *src, size_t index, size_t src_len)
+{
+#if defined(__AVX2__)
+	for (; index + 32 <= src_len; index += 32) {
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_loadu_si256((const __m256i *)&src[index]));
+		if (mask != 0)
+			return index + jsimplon_ctz32(mask);
+	}
+#endif
+
+#if defined(__SSE2__)
+	for (; index + 16 <= src_len; index += 16) {
+		uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)&src[index]));
+		if (mask != 0)
+			return index + jsimplon_ctz32(mask);
+	}
+#endif
+
+	for (; index + 8 <= src_len; index += 8) {
+		uint64_t word;
+		memcpy(&word, &src[index], sizeof word);
+
+		if ((word & JSIMPLON_SWAR_HIGHS) != 0)
+			break;
+	}
+
+	for (; index < src_len && (uint8_t)src[index] < 0x80; ++index);
+
+	return index;
+}
+
+#if defined(__AVX2__)
+// Keiser and Lemire's lookup tables, the high nibble of the byte before, its low nibble and the high nibble of the
+// byte itself each map to the ways that pair of bytes could be wrong, and the pair is wrong where all three agree:
+// 1 too short, 2 too long, 4 overlong 3 byte, 8 too large, 16 surrogate, 32 overlong 2 byte,
+// 64 overlong 4 byte or too large from F4 90 on, 128 two continuations in a row
+static const uint8_t jsimplon_utf8_byte_1_high[32] = {
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x80, 0x80, 0x80, 0x80, 0x21, 0x01, 0x15, 0x49,
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x80, 0x80, 0x80, 0x80, 0x21, 0x01, 0x15, 0x49
+};
+
+static const uint8_t jsimplon_utf8_byte_1_low[32] = {
+	0xE7, 0xA3, 0x83, 0x83, 0x8B, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xDB, 0xCB, 0xCB,
+	0xE7, 0xA3, 0x83, 0x83, 0x8B, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xDB, 0xCB, 0xCB
+};
+
+static const uint8_t jsimplon_utf8_byte_2_high[32] = {
+	0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xE6, 0xAE, 0xBA, 0xBA, 0x01, 0x01, 0x01, 0x01,
+	0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xE6, 0xAE, 0xBA, 0xBA, 0x01, 0x01, 0x01, 0x01
+};
+
+// Anything above these in the last three bytes of a block starts a character the next block has to finish
+static const uint8_t jsimplon_utf8_max_value[32] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF
+};
+
+// Non-zero wherever a byte is wrong given the three before it, prev_input is the block before
+JSIMPLON_DEF_INTERNAL __m256i jsimplon_utf8_block_errors(__m256i input, __m256i prev_input)
+{
+	const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+
+	// The bytes 1, 2 and 3 before each one, reaching back into the block before
+	__m256i shifted = _mm256_permute2x128_si256(prev_input, input, 0x21);
+	__m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+	__m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+	__m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+
+	__m256i byte_1_high = _mm256_shuffle_epi8(
+		_mm256_loadu_si256((const __m256i *)jsimplon_utf8_byte_1_high),
+		_mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble)
+	);
+	__m256i byte_1_low = _mm256_shuffle_epi8(
+		_mm256_loadu_si256((const __m256i *)jsimplon_utf8_byte_1_low),
+		_mm256_and_si256(prev1, low_nibble)
+	);
+	__m256i byte_2_high = _mm256_shuffle_epi8(
+		_mm256_loadu_si256((const __m256i *)jsimplon_utf8_byte_2_high),
+		_mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble)
+	);
+	__m256i special = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+	// The third and fourth bytes of a character are the only continuations the tables can't see, two continuations
+	// in a row is flagged for them and this takes it back where a 3 or 4 byte lead makes it right
+	__m256i must_be_continuation = _mm256_or_si256(
+		_mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80))),
+		_mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80)))
+	);
+
+	return _mm256_xor_si256(_mm256_and_si256(must_be_continuation, _mm256_set1_epi8((char)0x80)), special);
+}
+#else
+JSIMPLON_DEF_INTERNAL size_t jsimplon_utf8_sequence(const char *src, size_t index, size_t length)
+{
+	uint8_t lead = (uint8_t)src[index];
+	size_t count;
+
+	// What the byte after the lead can be, the bounds rule out overlong forms, surrogates and anything above U+10FFFF
+	uint8_t lower = 0x80, upper = 0xBF;
+
+	if (lead >= 0xC2 && lead <= 0xDF) {
+		count = 2;
+	}
+	else if (lead >= 0xE0 && lead <= 0xEF) {
+		count = 3;
+		lower = lead == 0xE0 ? 0xA0 : lower;
+		upper = lead == 0xED ? 0x9F : upper;
+	}
+	else if (lead >= 0xF0 && lead <= 0xF4) {
+		count = 4;
+		lower = lead == 0xF0 ? 0x90 : lower;
+		upper = lead == 0xF4 ? 0x8F : upper;
+	}
+	else {
+		return 0;
+	}
+
+	if (index + count > length || (uint8_t)src[index + 1] < lower || (uint8_t)src[index + 1] > upper)
+		return 0;
+
+	for (size_t i = 2; i < count; ++i) {
+		if (((uint8_t)src[index + i] & 0xC0) != 0x80)
+			return 0;
+	}
+
+	return count;
+}
+#endif
+
+JSIMPLON_DEF_INTERNAL bool jsimplon_utf8_validate(const char *src, size_t length)
+{
+	// Most strings are all ASCII, and everything before the first byte that isn't is where a character starts
+	size_t index = jsimplon_scan_ascii(src, 0, length);
+
+	if (index == length)
+		return true;
+
+#if defined(__AVX2__)
+	const __m256i max_value = _mm256_loadu_si256((const __m256i *)jsimplon_utf8_max_value);
+	__m256i prev_input = _mm256_setzero_si256();
+	__m256i prev_incomplete = _mm256_setzero_si256();
+	__m256i errors = _mm256_setzero_si256();
+
+	for (; index < length; index += 32) {
+		__m256i input;
+
+		// The last block is padded with NULs, which cut short whatever was left unfinished
+		if (index + 32 <= length) {
+			input = _mm256_loadu_si256((const __m256i *)&src[index]);
+		}
+		else {
+			char block[32] = { 0 };
+			memcpy(block, &src[index], length - index);
+			input = _mm256_loadu_si256((const __m256i *)block);
+		}
+
+		if (_mm256_movemask_epi8(input) == 0) {
+			errors = _mm256_or_si256(errors, prev_incomplete);
+			prev_incomplete = _mm256_setzero_si256();
+		}
+		else {
+			errors = _mm256_or_si256(errors, jsimplon_utf8_block_errors(input, prev_input));
+			prev_incomplete = _mm256_subs_epu8(input, max_value);
+		}
+
+		prev_input = input;
+	}
+
+	errors = _mm256_or_si256(errors, prev_incomplete);
+
+	return _mm256_testz_si256(errors, errors);
+#else
+	while (index < length) {
+		while (index < length && (uint8_t)src[index] >= 0x80) {
+			size_t count = jsimplon_utf8_sequence(src, index, length);
+			if (count == 0)
+				return false;
+
+			index += count;
+		}
+
+		index = jsimplon_scan_ascii(src, index, length);
+	}
+
+	return true;
+#endif
+}
+
+JSIMPLON_DEF_INTERNAL size_t jsimplon_scan_whitespace(const char *src, size_t index, size_t src_len, uint32_t *newline_count, size_t *last_newline)
+{
+	// Most runs are a single space or nothing at all
+	if (index >= src_len || jsimplon_char_classes[(uint8_t)src[index]] != JSIMPLON_CHAR_WHITESPACE)
+		return index;
+
+#if defined(__SSE2__)
+	const __m128i space   = _mm_set1_epi8(' ');
+	const __m128i tab     = _mm_set1_epi8('\t');
+	const __m128i newline = _mm_set1_epi8('\n');
+	const __m128i carriage_return = _mm_set1_epi8('\r');
+
+	for (; index + 16 <= src_len; index += 16) {
+		__m128i chunk = _mm_loadu_si128((const __m128i *)&src[index]);
+		__m128i newlines = _mm_cmpeq_epi8(chunk, newline);
+		__m128i whitespace = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+			_mm_or_si128(newlines, _mm_cmpeq_epi8(chunk, carriage_return))
+		);
+
+		uint32_t newline_mask = (uint32_t)_mm_movemask_epi8(newlines);
+		uint32_t other_mask = ~(uint32_t)_mm_movemask_epi8(whitespace) & 0xFFFF;
+		uint32_t run_length = other_mask != 0 ? jsimplon_ctz32(other_mask) : 16;
+
+		if (run_length < 16)
+			newline_mask &= (1u << run_length) - 1;
+
+		for (; newline_mask != 0; newline_mask &= newline_mask - 1) {
+			++*newline_count;
+			*last_newline = index + jsimplon_ctz32(newline_mask);
+		}
+
+		if (run_length < 16)
+			return index + run_length;
+	}
+#endif
+
+	for (; index < src_len; ++index) {
+		char c = src[index];
+
+		if (c == '\n') {
+			++*newline_count;
+			*last_newline = index;
+		}
+		else if (jsimplon_char_classes[(uint8_t)c] != JSIMPLON_CHAR_WHITESPACE) {
+			break;
+		}
+	}
+
+	return index;
+}
+
+JSIMPLON_DEF_INTERNAL uint32_t jsimplon_load32(const char *src)
+{
+	uint32_t x;
+	memcpy(&x, src, sizeof x);
+
+	return x;
+}
+
+#if defined(__SSE2__) || defined(__AVX2__)
+JSIMPLON_DEF_INTERNAL uint32_t jsimplon_ctz32(uint32_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctz(x);
+#else
+	uint32_t n = 0;
+	for (; (x & 1) == 0; x >>= 1)
+		++n;
+
+	return n;
+#endif
+}
+#endif
+
+JSIMPLON_DEF_INTERNAL uint32_t jsimplon_ctz64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(x);
+#else
+	uint32_t n = 0;
+	for (; (x & 1) == 0; x >>= 1)
+		++n;
+
+	return n;
+#endif
+}
+
+JSIMPLON_DEF_INTERNAL uint32_t jsimplon_popcount64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_popcountll(x);
+#else
+	uint32_t n = 0;
+	for (; x != 0; x &= x - 1)
+		++n;
+
+	return n;
+#endif
+}
+
+// Stage one of the structural engine, modelled after simdjson: every 64 byte block is classified into bitmasks,
+// string contents are masked out and what is left are the offsets of { } [ ] : , and of the first byte of every scalar
+JSIMPLON_DEF_INTERNAL uint32_t *jsimplon_structural_index(const char *src, size_t src_len, size_t *count)
+{
+	size_t index_size = src_len / 8 + 64;
+	size_t index_count = 0;
+	uint32_t *index = malloc(index_size * sizeof *index);
+
+	uint64_t next_is_escaped = 0;
+	uint64_t prev_in_string = 0;
+	uint64_t prev_scalar = 0;
+
+	for (size_t base = 0; base < src_len; base += 64) {
+		char padded[64];
+		const char *block = &src[base];
+
+		// The last block is padded with whitespace, which can't start anything
+		if (src_len - base < 64) {
+			memset(padded, ' ', sizeof padded);
+			memcpy(padded, block, src_len - base);
+			block = padded;
+		}
+
+		Jsimplon_BlockMasks masks = jsimplon_classify_block(block);
+
+		uint64_t quote = masks.quote & ~jsimplon_find_escaped(masks.backslash, &next_is_escaped);
+
+		// Set from an opening quote up to, but not including, its closing quote
+		uint64_t in_string = jsimplon_prefix_xor(quote) ^ prev_in_string;
+		prev_in_string = 0 - (in_string >> 63);
+
+		// A scalar starts wherever a run of anything but whitespace and punctuation does, a string at its opening quote
+		uint64_t scalar = ~(masks.structural | masks.whitespace);
+		uint64_t nonquote_scalar = scalar & ~quote;
+		uint64_t follows_nonquote_scalar = nonquote_scalar << 1 | prev_scalar;
+		prev_scalar = nonquote_scalar >> 63;
+
+		uint64_t string_tail = in_string ^ quote;
+		uint64_t structurals = (masks.structural | (scalar & ~follows_nonquote_scalar)) & ~string_tail;
+
+		if (index_count + 64 > index_size) {
+			index_size *= 2;
+			index = realloc(index, index_size * sizeof *index);
+		}
+
+		for (; structurals != 0; structurals &= structurals - 1)
+			index[index_count++] = (uint32_t)(base + jsimplon_ctz64(structurals));
+	}
+
+	*count = index_count;
+
+	return index;
+}
+
+// Finds the end of a container from just past its '{' or '[' without looking at what's in it. Brackets are followed
+// one by one only in blocks where the depth could get back to zero or past max_depth, anywhere else they're just counted
+JSIMPLON_DEF_INTERNAL size_t jsimplon_skip_container(const char *src, size_t index, size_t src_len, uint64_t max_depth, size_t *too_deep)
+{
+	uint64_t next_is_escaped = 0;
+	uint64_t prev_in_string = 0;
+	uint64_t depth = 1;
+
+	*too_deep = SIZE_MAX;
+
+	if (max_depth == 0) {
+		*too_deep = index - 1;
+		return SIZE_MAX;
+	}
+
+	for (size_t base = index; base < src_len; base += 64) {
+		char padded[64];
+		const char *block = &src[base];
+
+		if (src_len - base < 64) {
+			memset(padded, ' ', sizeof padded);
+			memcpy(padded, block, src_len - base);
+			block = padded;
+		}
+
+		Jsimplon_BlockMasks masks = jsimplon_classify_block(block);
+
+		uint64_t quote = masks.quote & ~jsimplon_find_escaped(masks.backslash, &next_is_escaped);
+		uint64_t in_string = jsimplon_prefix_xor(quote) ^ prev_in_string;
+		prev_in_string = 0 - (in_string >> 63);
+
+		uint64_t open = masks.open & ~in_string;
+		uint64_t close = masks.close & ~in_string;
+		uint32_t open_count = jsimplon_popcount64(open);
+		uint32_t close_count = jsimplon_popcount64(close);
+
+		if (depth > close_count && depth + open_count <= max_depth) {
+			depth = depth + open_count - close_count;
+			continue;
+		}
+
+		for (uint64_t brackets = open | close; brackets != 0; brackets &= brackets - 1) {
+			uint64_t bracket = brackets & (0 - brackets);
+
+			if (open & bracket) {
+				if (++depth > max_depth) {
+					*too_deep = base + jsimplon_ctz64(bracket);
+					return SIZE_MAX;
+				}
+			}
+			else if (--depth == 0) {
+				return base + jsimplon_ctz64(bracket) + 1;
+			}
+		}
+	}
+
+	return SIZE_MAX;
+}
+
+JSIMPLON_DEF_INTERNAL Jsimplon_BlockMasks jsimplon_classify_block(const char *block)
+{
+	Jsimplon_BlockMasks masks = { 0 };
+
+#if defined(__AVX2__)
+	for (uint32_t half = 0; half < 64; half += 32) {
+		__m256i chunk = _mm256_loadu_si256((const __m256i *)&block[half]);
+		// Setting bit 5 turns '[' and ']' into '{' and '}' and nothing else into either
+		__m256i folded = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+		__m256i open = _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('{'));
+		__m256i close = _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('}'));
+		__m256i structural = _mm256_or_si256(
+			_mm256_or_si256(open, close),
+			_mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(',')))
+		);
+		__m256i whitespace = _mm256_or_si256(
+			_mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\t'))),
+			_mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\r')))
+		);
+
+		masks.quote      |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\"'))) << half;
+		masks.backslash  |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\\'))) << half;
+		masks.whitespace |= (uint64_t)(uint32_t)_mm256_movemask_epi8(whitespace) << half;
+		masks.structural |= (uint64_t)(uint32_t)_mm256_movemask_epi8(structural) << half;
+		masks.open       |= (uint64_t)(uint32_t)_mm256_movemask_epi8(open) << half;
+		masks.close      |= (uint64_t)(uint32_t)_mm256_movemask_epi8(close) << half;
+	}
+#elif defined(__SSE2__)
+	for (uint32_t quarter = 0; quarter < 64; quarter += 16) {
+		__m128i chunk = _mm_loadu_si128((const __m128i *)&block[quarter]);
+		__m128i folded = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+		__m128i open = _mm_cmpeq_epi8(folded, _mm_set1_epi8('{'));
+		__m128i close = _mm_cmpeq_epi8(folded, _mm_set1_epi8('}'));
+		__m128i structural = _mm_or_si128(
+			_mm_or_si128(open, close),
+			_mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(':')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8(',')))
+		);
+		__m128i whitespace = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t'))),
+			_mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r')))
+		);
+
+		masks.quote      |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\"'))) << quarter;
+		masks.backslash  |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\'))) << quarter;
+		masks.whitespace |= (uint64_t)(uint32_t)_mm_movemask_epi8(whitespace) << quarter;
+		masks.structural |= (uint64_t)(uint32_t)_mm_movemask_epi8(structural) << quarter;
+		masks.open       |= (uint64_t)(uint32_t)_mm_movemask_epi8(open) << quarter;
+		masks.close      |= (uint64_t)(uint32_t)_mm_movemask_epi8(close) << quarter;
+	}
+#else
+	for (uint32_t i = 0; i < 64; ++i) {
+		uint64_t bit = (uint64_t)1 << i;
+
+		switch (jsimplon_char_classes[(uint8_t)block[i]]) {
+			case JSIMPLON_CHAR_WHITESPACE:
+				masks.whitespace |= bit;
+				break;
+			case JSIMPLON_CHAR_STRUCTURAL:
+				masks.structural |= bit;
+				if (block[i] == '{' || block[i] == '[')
+					masks.open |= bit;
+				else if (block[i] == '}' || block[i] == ']')
+					masks.close |= bit;
+				break;
+			case JSIMPLON_CHAR_QUOTE:
+				masks.quote |= bit;
+				break;
+			default:
+				if (block[i] == '\\')
+					masks.backslash |= bit;
+				break;
+		}
+	}
+#endif
+
+	return masks;
+}
+
+// Marks every byte escaped by an odd run of backslashes without looking at the runs one by one,
+// next_is_escaped carries a run that ends on the last byte of the block over to the next one
+JSIMPLON_DEF_INTERNAL uint64_t jsimplon_find_escaped(uint64_t backslash, uint64_t *next_is_escaped)
+{
+	const uint64_t odd_bits = 0xAAAAAAAAAAAAAAAAULL;
+
+	if (backslash == 0) {
+		uint64_t escaped = *next_is_escaped;
+		*next_is_escaped = 0;
+
+		return escaped;
+	}
+
+	// Subtracting the backslashes from the odd bits leaves runs that start on an even byte alternating, flipping
+	// the odd bits back does the same for the ones starting on an odd byte and lights up the byte after each run
+	uint64_t potential_escape = backslash & ~*next_is_escaped;
+	uint64_t escape_and_terminal = (((potential_escape << 1) | odd_bits) - potential_escape) ^ odd_bits;
+	uint64_t escaped = escape_and_terminal ^ (backslash | *next_is_escaped);
+
+	*next_is_escaped = (escape_and_terminal & backslash) >> 63;
+
+	return escaped;
+}
+
+// Bit i of the result is the parity of bits 0 to i
+JSIMPLON_DEF_INTERNAL uint64_t jsimplon_prefix_xor(uint64_t x)
+{
+	x ^= x << 1;
+	x ^= x << 2;
+	x ^= x << 4;
+	x ^= x << 8;
+	x ^= x << 16;
+	x ^= x << 32;
+
+	return x;
+}
+
+JSIMPLON_DEF_INTERNAL const char *jsimplon_token_to_str(Jsimplon_Token token)
+{
+	switch (token.type) {
+		case JSIMPLON_TOKEN_END:
+			return "TOKEN_END";
+		case JSIMPLON_TOKEN_STRING_LITERAL:
+			return token.value;
+		case JSIMPLON_TOKEN_NUMBER_LITERAL:
+		case JSIMPLON_TOKEN_INTEGER_LITERAL:
+			return "number literal";
+		case JSIMPLON_TOKEN_TRUE:
+			return "true";
+		case JSIMPLON_TOKEN_FALSE:
+			return "false";
+		case JSIMPLON_TOKEN_NULL:
+			return "null";
+		case JSIMPLON_TOKEN_LBRACE:
+			return "{";
+		case JSIMPLON_TOKEN_RBRACE:
+			return "}";
+		case JSIMPLON_TOKEN_LBRACKET:
+			return "[";
+		case JSIMPLON_TOKEN_RBRACKET:
+			return "]";
+		case JSIMPLON_TOKEN_COMMA:
+			return ",";
+		case JSIMPLON_TOKEN_COLON:
+			return ":";
+	}
+}
+
+JSIMPLON_DEF_INTERNAL void jsimplon_value_to_str(Jsimplon_Serialiser *s, const Jsimplon_Value *value)
+{
+	if (value == NULL) {
+		jsimplon_append_str(
+			s->error, s->error_size,
+			"serialisation error: null value\n" // TODO: Make this more helpful?
+		);
+		++s->error_count;
+
+		return;
+	}
+
+	switch (jsimplon_tag_type(value->tag)) {
+		case JSIMPLON_VALUE_UNINITIALISED:
+			jsimplon_append_str(
+				s->error, s->error_size,
+				"serialisation error: uninitialised value\n"
+			);
+			++s->error_count;
+
+			break;
+		case JSIMPLON_VALUE_OBJECT:
+		case JSIMPLON_VALUE_ARRAY:
+			// Parsing a lazy container only fills in what the tree already says, so it's fine on a const one
+			if (jsimplon_value_load((Jsimplon_Value *)value) != JSIMPLON_SUCCESS) {
+				jsimplon_append_str(
+					s->error, s->error_size,
+					"serialisation error: a lazily parsed %s is malformed\n",
+					jsimplon_tag_type(value->tag) == JSIMPLON_VALUE_OBJECT ? "object" : "array"
 				);
-				++lexer->error_count;
+				++s->error_count;
 
 				break;
 			}
 
-			if (lexeme_index == JSIMPLON_STRING_LITERAL_MAX_LENGTH) {
+			if (jsimplon_tag_type(value->tag) == JSIMPLON_VALUE_OBJECT)
+				jsimplon_object_to_str(s, value->object_value);
+			else
+				jsimplon_array_to_str(s, value->array_value);
+			break;
+		case JSIMPLON_VALUE_STRING:
+			jsimplon_serialiser_str(s, jsimplon_value_str(value), jsimplon_value_str_length(value));
+			break;
+		case JSIMPLON_VALUE_NUMBER: {
+			if (!isfinite(value->number_value)) {
 				jsimplon_append_str(
-					lexer->error, lexer->error_size,
-					"lexer error: %u:%u: string literal \"%s...\" exceeded maximum length of %d\n",
-					token.line, token.column,
-					lexer->lexeme, JSIMPLON_STRING_LITERAL_MAX_LENGTH
+					s->error, s->error_size,
+					"serialisation error: %f can't be represented in JSON\n",
+					value->number_value
 				);
-				++lexer->error_count;
+				++s->error_count;
+
+				break;
+			}
+
+			char *dst = jsimplon_serialiser_reserve(s, JSIMPLON_NUMBER_FORMAT_MAX_LENGTH);
+			s->str_count += jsimplon_number_format(value->number_value, dst);
+			break;
+		}
+		case JSIMPLON_VALUE_INTEGER: {
+			bool negative = !(jsimplon_tag_flags(value->tag) & JSIMPLON_FLAG_UNSIGNED) && value->integer_value < 0;
+			uint64_t magnitude = negative ? 0 - (uint64_t)value->integer_value : value->unsigned_value;
+
+			char *dst = jsimplon_serialiser_reserve(s, JSIMPLON_NUMBER_FORMAT_MAX_LENGTH);
+			s->str_count += jsimplon_integer_format(magnitude, negative, dst);
+			break;
+		}
+		case JSIMPLON_VALUE_BOOL:
+			if (value->bool_value == true)
+				jsimplon_serialiser_append(s, "true", 4);
+			else
+				jsimplon_serialiser_append(s, "false", 5);
+			break;
+		case JSIMPLON_VALUE_NULL:
+			jsimplon_serialiser_append(s, "null", 4);
+			break;
+	}
+}
+
+JSIMPLON_DEF_INTERNAL void jsimplon_object_to_str(Jsimplon_Serialiser *s, const Jsimplon_Object *object)
+{
+	jsimplon_serialiser_append(s, "{", 1);
+
+	for (uint32_t i = 0; i < object->members_count; ++i) {
+		if (i > 0)
+			jsimplon_serialiser_append(s, ",", 1);
+
+		const Jsimplon_Member *member = &object->members[i];
+
+		jsimplon_serialiser_str(s, jsimplon_member_key(member), jsimplon_member_key_length(member));
+		jsimplon_serialiser_append(s, ":", 1);
+		jsimplon_value_to_str(s, &member->value);
+	}
+
+	jsimplon_serialiser_append(s, "}", 1);
+}
+
+JSIMPLON_DEF_INTERNAL void jsimplon_array_to_str(Jsimplon_Serialiser *s, const Jsimplon_Array *array)
+{
+	jsimplon_serialiser_append(s, "[", 1);
+
+	for (uint32_t i = 0; i < array->values_count; ++i) {
+		if (i > 0)
+			jsimplon_serialiser_append(s, ",", 1);
+
+		jsimplon_value_to_str(s, &array->values[i]);
+	}
+
+	jsimplon_serialiser_append(s, "]", 1);
+}
+
+// Doubling keeps the whole output linear, nothing is written that isn't counted so nothing has to be measured
+JSIMPLON_DEF_INTERNAL char *jsimplon_serialiser_reserve(Jsimplon_Serialiser *s, size_t length)
+{
+	if (s->str_count + length >= s->str_size) {
+		s->str_size *= 2;
+		s->str_size += length;
+
+		s->str = realloc(s->str, s->str_size * (sizeof *s->str));
+	}
+
+	return &s->str[s->str_count];
+}
+
+JSIMPLON_DEF_INTERNAL void jsimplon_serialiser_append(Jsimplon_Serialiser *s, const char *src, size_t length)
+{
+	memcpy(jsimplon_serialiser_reserve(s, length), src, length);
+	s->str_count += length;
+}
+
+// Everything RFC 8259 requires is escaped and nothing else, the rest of the string is copied a span at a time
+JSIMPLON_DEF_INTERNAL void jsimplon_serialiser_str(Jsimplon_Serialiser *s, const char *str, size_t length)
+{
+	// \u00XX is the longest an escape gets
+	char *dst = jsimplon_serialiser_reserve(s, 6 * length + 2);
+
+	*dst++ = '\"';
+
+	for (size_t i = 0; i < length;) {
+		size_t span = jsimplon_scan_string(str, i, length) - i;
+		memcpy(dst, &str[i], span);
+		dst += span;
+		i += span;
+
+		if (i >= length)
+			break;
+
+		unsigned char c = (unsigned char)str[i++];
+		*dst++ = '\\';
+
+		switch (c) {
+			case '\"':  *dst++ = '\"';  break;
+			case '\\': *dst++ = '\\'; break;
+			case '\b': *dst++ = 'b';  break;
+			case '\f': *dst++ = 'f';  break;
+			case '\n': *dst++ = 'n';  break;
+			case '\r': *dst++ = 'r';  break;
+			case '\t': *dst++ = 't';  break;
+			default:
+				*dst++ = 'u';
+				*dst++ = '0';
+				*dst++ = '0';
+				*dst++ = "0123456789abcdef"[c >> 4];
+				*dst++ = "0123456789abcdef"[c & 0xF];
+				break;
+		}
+	}
+
+	*dst++ = '\"';
+	s->str_count = (size_t)(dst - s->str);
+}
+
+JSIMPLON_DEF_INTERNAL void jsimplon_value_destroy(Jsimplon_Value *value)
+{
+	Jsimplon_Document *document = jsimplon_tag_document(value->tag);
+
+	// Nothing in an arena is freed on its own, the arena takes it all when the document goes
+	if (document == NULL || !document->use_arena) {
+		switch (jsimplon_tag_type(value->tag)) {
+			case JSIMPLON_VALUE_STRING:
+				if (!(jsimplon_tag_flags(value->tag) & (JSIMPLON_FLAG_BORROWED | JSIMPLON_FLAG_INLINE)))
+					free(jsimplon_string(value->string_value));
+				break;
+			case JSIMPLON_VALUE_OBJECT:
+				jsimplon_object_destroy(value->object_value);
+				free(value->object_value);
+				break;
+			case JSIMPLON_VALUE_ARRAY:
+				jsimplon_array_destroy(value->array_value);
+				free(value->array_value);
+				break;
+			default:
+				break;
+		}
+	}
+
+	*value = (Jsimplon_Value){ .tag = (uintptr_t)document };
+}
+
+// Nothing has been allocated for a lazy container's members or elements yet
+JSIMPLON_DEF_INTERNAL void jsimplon_object_destroy(Jsimplon_Object *object)
+{
+	if (jsimplon_tag_flags(object->tag) & JSIMPLON_FLAG_LAZY || object->members == NULL)
+		return;
+
+	for (uint32_t i = 0; i < object->members_count; ++i)
+		jsimplon_member_destroy(&object->members[i]);
+	free(object->members);
+	object->members = NULL;
+	object->members_count = object->members_size = 0;
+}
+
+JSIMPLON_DEF_INTERNAL void jsimplon_member_destroy(Jsimplon_Member *member)
+{
+	if (jsimplon_member_key(member) == NULL)
+		return;
+
+	if (!(member->key_flags & (JSIMPLON_FLAG_BORROWED | JSIMPLON_FLAG_INLINE)))
+		jsimplon_document_free(jsimplon_tag_document(member->value.tag), jsimplon_string(member->key));
+	jsimplon_value_destroy(&member->value);
+	memset(member, 0, sizeof *member);
+}
+
+JSIMPLON_DEF_INTERNAL void jsimplon_array_destroy(Jsimplon_Array *array)
+{
+	if (jsimplon_tag_flags(array->tag) & JSIMPLON_FLAG_LAZY || array->values == NULL)
+		return;
+
+	for (uint32_t i = 0; i < array->values_count; ++i)
+		jsimplon_value_destroy(&array->values[i]);
+	free(array->values);
+	array->values = NULL;
+	array->values_count = array->values_size = 0;
+}
+
+JSIMPLON_DEF_INTERNAL void *jsimplon_document_alloc(Jsimplon_Document *document, size_t size)
+{
+	if (document == NULL || !document->use_arena)
+		return malloc(size);
+
+	return jsimplon_arena_alloc(&document->arena, size);
+}
+
+JSIMPLON_DEF_INTERNAL void *jsimplon_document_realloc(Jsimplon_Document *document, void *ptr, size_t old_size, size_t new_size)
+{
+	if (document == NULL || !document->use_arena)
+		return realloc(ptr, new_size);
+
+	Jsimplon_ArenaBlock *block = document->arena;
+
+	old_size = (old_size + 7) & ~(size_t)7;
+	new_size = (new_size + 7) & ~(size_t)7;
+
+	// The latest allocation of the current block can grow in place, everything else moves
+	if (ptr != NULL && block != NULL && (char *)ptr + old_size == (char *)block->data + block->used && block->used - old_size + new_size <= block->size) {
+		block->used = block->used - old_size + new_size;
+		return ptr;
+	}
+
+	void *new_ptr = jsimplon_arena_alloc(&document->arena, new_size);
+	if (ptr != NULL)
+		memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+
+	return new_ptr;
+}
+
+JSIMPLON_DEF_INTERNAL void jsimplon_document_free(Jsimplon_Document *document, void *ptr)
+{
+	if (document == NULL || !document->use_arena)
+		free(ptr);
+}
+
+JSIMPLON_DEF_INTERNAL char *jsimplon_document_strdup(Jsimplon_Document *document, const char *str)
+{
+	size_t size = strlen(str) + 1;
+	char *copy = jsimplon_document_alloc(document, size);
+	memcpy(copy, str, size);
+
+	return copy;
+}
+
+// A NUL-terminated copy of str, the table's if it's short enough and the document interns
+JSIMPLON_DEF_INTERNAL char *jsimplon_document_intern(Jsimplon_Document *document, const char *str, size_t length, uint32_t *flags)
+{
+	if (document != NULL && document->intern_strings && length <= JSIMPLON_INTERN_MAX_LENGTH) {
+		*flags |= JSIMPLON_FLAG_BORROWED;
+		return jsimplon_intern(&document->interns, str, length);
+	}
+
+	char *copy = jsimplon_document_string(document, length);
+	memcpy(copy, str, length);
+
+	return copy;
+}
+
+JSIMPLON_DEF_INTERNAL char *jsimplon_document_string(Jsimplon_Document *document, size_t length)
+{
+	Jsimplon_String *string = jsimplon_document_alloc(document, sizeof *string + length + 1);
+	string->length = length;
+	string->str[length] = '\0';
+
+	return string->str;
+}
+
+JSIMPLON_DEF_INTERNAL Jsimplon_String *jsimplon_string(char *str)
+{
+	return (Jsimplon_String *)(str - offsetof(Jsimplon_String, str));
+}
+
+JSIMPLON_DEF_INTERNAL uintptr_t jsimplon_tag(Jsimplon_Document *document, Jsimplon_ValueType type, uint32_t flags)
+{
+	return (uintptr_t)document | (uintptr_t)type | (uintptr_t)flags << JSIMPLON_TAG_TYPE_BITS;
+}
+
+JSIMPLON_DEF_INTERNAL Jsimplon_Document *jsimplon_tag_document(uintptr_t tag)
+{
+	return (Jsimplon_Document *)(tag & ~(uintptr_t)(JSIMPLON_DOCUMENT_ALIGNMENT - 1));
+}
+
+JSIMPLON_DEF_INTERNAL Jsimplon_ValueType jsimplon_tag_type(uintptr_t tag)
+{
+	return (Jsimplon_ValueType)(tag & ((1 << JSIMPLON_TAG_TYPE_BITS) - 1));
+}
+
+JSIMPLON_DEF_INTERNAL uint32_t jsimplon_tag_flags(uintptr_t tag)
+{
+	return (uint32_t)(tag & (JSIMPLON_DOCUMENT_ALIGNMENT - 1)) >> JSIMPLON_TAG_TYPE_BITS;
+}
+
+JSIMPLON_DEF_INTERNAL void jsimplon_value_retag(Jsimplon_Value *value, Jsimplon_ValueType type, uint32_t flags)
+{
+	value->tag = jsimplon_tag(jsimplon_tag_document(value->tag), type, flags);
+}
+
+// The header comes from allocator, which is the value's document unless a worker is filling in part of it
+JSIMPLON_DEF_INTERNAL void jsimplon_value_open(Jsimplon_Value *value, Jsimplon_Document *allocator, Jsimplon_ValueType type)
+{
+	uintptr_t tag = jsimplon_tag(jsimplon_tag_document(value->tag), type, 0);
+
+	if (type == JSIMPLON_VALUE_OBJECT) {
+		value->object_value = jsimplon_document_alloc(allocator, sizeof *value->object_value);
+		*value->object_value = (Jsimplon_Object){ .tag = tag };
+	}
+	else {
+		value->array_value = jsimplon_document_alloc(allocator, sizeof *value->array_value);
+		*value->array_value = (Jsimplon_Array){ .tag = tag };
+	}
+
+	value->tag = tag;
+}
+
+JSIMPLON_DEF_INTERNAL const char *jsimplon_value_str(const Jsimplon_Value *value)
+{
+	return jsimplon_tag_flags(value->tag) & JSIMPLON_FLAG_INLINE ? value->inline_str : value->string_value;
+}
+
+JSIMPLON_DEF_INTERNAL size_t jsimplon_value_str_length(const Jsimplon_Value *value)
+{
+	uint32_t flags = jsimplon_tag_flags(value->tag);
+
+	if (flags & JSIMPLON_FLAG_INLINE)
+		return JSIMPLON_INLINE_STR_SIZE - 1 - (uint8_t)value->inline_str[JSIMPLON_INLINE_STR_SIZE - 1];
+
+	// The lexer copies the ones that decode to a NUL out of the source
+	if (flags & JSIMPLON_FLAG_INSITU)
+		return strlen(value->string_value);
+
+	return jsimplon_string(value->string_value)->length;
+}
+
+JSIMPLON_DEF_INTERNAL const char *jsimplon_member_key(const Jsimplon_Member *member)
+{
+	return member->key_flags & JSIMPLON_FLAG_INLINE ? member->inline_key : member->key;
+}
+
+JSIMPLON_DEF_INTERNAL size_t jsimplon_member_key_length(const Jsimplon_Member *member)
+{
+	if (member->key_flags & JSIMPLON_FLAG_INLINE)
+		return JSIMPLON_INLINE_KEY_SIZE - 1 - (uint8_t)member->inline_key[JSIMPLON_INLINE_KEY_SIZE - 1];
+
+	return member->key_length;
+}
+
+JSIMPLON_DEF_INTERNAL bool jsimplon_member_key_equals(const Jsimplon_Member *member, const char *key, size_t length)
+{
+	const char *member_key = jsimplon_member_key(member);
+
+	return member_key != NULL && jsimplon_key_equals(member_key, jsimplon_member_key_length(member), key, length);
+}
+
+JSIMPLON_DEF_INTERNAL void jsimplon_value_store_str(Jsimplon_Value *value, Jsimplon_Document *document, const char *str, size_t length)
+{
+	if (length < JSIMPLON_INLINE_STR_SIZE) {
+		memcpy(value->inline_str, str, length);
+		value->inline_str[length] = '\0';
+		value->inline_str[JSIMPLON_INLINE_STR_SIZE - 1] = (char)(JSIMPLON_INLINE_STR_SIZE - 1 - length);
+		jsimplon_value_retag(value, JSIMPLON_VALUE_STRING, JSIMPLON_FLAG_INLINE);
+	}
+	else {
+		uint32_t flags = 0;
+		value->string_value = jsimplon_document_intern(document, str, length, &flags);
+		jsimplon_value_retag(value, JSIMPLON_VALUE_STRING, flags);
+	}
+}
+
+// Keys have less room inline than strings, the ones that don't fit are interned or copied
+JSIMPLON_DEF_INTERNAL void jsimplon_member_store_key(Jsimplon_Member *member, Jsimplon_Document *document, const char *key, size_t length)
+{
+	if (length < JSIMPLON_INLINE_KEY_SIZE) {
+		memcpy(member->inline_key, key, length);
+		member->inline_key[length] = '\0';
+		member->inline_key[JSIMPLON_INLINE_KEY_SIZE - 1] = (char)(JSIMPLON_INLINE_KEY_SIZE - 1 - length);
+		member->key_flags = JSIMPLON_FLAG_INLINE;
+	}
+	else {
+		member->key_flags = 0;
+		member->key = jsimplon_document_intern(document, key, length, &member->key_flags);
+		member->key_length = (uint32_t)length;
+	}
+}
+
+// Strings are owned by the value they're moved into, short ones are copied out of the lexer
+JSIMPLON_DEF_INTERNAL void jsimplon_value_take_str(Jsimplon_Value *value, const Jsimplon_Lexer *lexer, const Jsimplon_Token *token)
+{
+	if (token->is_short) {
+		jsimplon_value_store_str(value, lexer->allocator, token->value, token->length);
+		return;
+	}
+
+	value->string_value = token->value;
+
+	if (lexer->insitu_src != NULL && !token->is_copied)
+		jsimplon_value_retag(value, JSIMPLON_VALUE_STRING, JSIMPLON_FLAG_BORROWED | JSIMPLON_FLAG_INSITU);
+	else
+		jsimplon_value_retag(value, JSIMPLON_VALUE_STRING, token->is_interned ? JSIMPLON_FLAG_BORROWED : 0);
+}
+
+JSIMPLON_DEF_INTERNAL void jsimplon_member_take_key(Jsimplon_Member *member, const Jsimplon_Lexer *lexer, const Jsimplon_Token *token)
+{
+	if (token->is_short) {
+		jsimplon_member_store_key(member, lexer->allocator, token->value, token->length);
+		return;
+	}
+
+	member->key = token->value;
+	member->key_length = (uint32_t)token->length;
+	member->key_flags = (lexer->insitu_src != NULL && !token->is_copied) || token->is_interned ? JSIMPLON_FLAG_BORROWED : 0;
+}
+
+// Returns the table's copy of str, which is made the first time it's asked for
+JSIMPLON_DEF_INTERNAL char *jsimplon_intern(Jsimplon_InternTable *table, const char *str, size_t length)
+{
+	// At most half full, so probes stay short
+	if (2 * (table->strings_count + 1) > table->slots_count) {
+		uint32_t old_slots_count = table->slots_count;
+		Jsimplon_String **old_slots = table->slots;
 
-				break;
-			}
+		table->slots_count = old_slots_count < 64 ? 64 : old_slots_count * 2;
+		table->slots = calloc(table->slots_count, sizeof *table->slots);
+
+		for (uint32_t i = 0; i < old_slots_count; ++i) {
+			if (old_slots[i] == NULL)
+				continue;
 
-			lexer->lexeme[lexeme_index++] = c;
-			escape_in_effect = false;
+			uint32_t slot = (uint32_t)jsimplon_hash(old_slots[i]->str, old_slots[i]->length) & (table->slots_count - 1);
+			while (table->slots[slot] != NULL)
+				slot = (slot + 1) & (table->slots_count - 1);
 
-			continue;
+			table->slots[slot] = old_slots[i];
 		}
-		else if (c == '\"') {
-			looking_for_string = true;
 
-			lexeme_index = 0;
-			memset(lexer->lexeme, 0, JSIMPLON_STRING_LITERAL_MAX_LENGTH + 1);
+		free(old_slots);
+	}
 
-			continue;
-		}
+	uint32_t mask = table->slots_count - 1;
+	uint32_t slot = (uint32_t)jsimplon_hash(str, length) & mask;
 
-		if (isdigit(c)) {
-			if (looking_for_number) {
-				if (lexeme_index == JSIMPLON_NUMBER_LITERAL_MAX_LENGTH) {
-					jsimplon_append_str(
-						lexer->error, lexer->error_size,
-						"lexer error: %u:%u: number literal '%s...' exceeded maximum length of %d\n",
-						token.line, token.column,
-						lexer->lexeme,
-						JSIMPLON_NUMBER_LITERAL_MAX_LENGTH
-					);
-					++lexer->error_count;
+	for (; table->slots[slot] != NULL; slot = (slot + 1) & mask) {
+		if (jsimplon_key_equals(table->slots[slot]->str, table->slots[slot]->length, str, length))
+			return table->slots[slot]->str;
+	}
 
-					break;
-				}
-			}
-			else {
-				looking_for_number = true;
+	Jsimplon_String *string = jsimplon_arena_alloc(&table->arena, sizeof *string + length + 1);
+	string->length = length;
+	memcpy(string->str, str, length);
+	string->str[length] = '\0';
 
-				lexeme_index = 0;
-				memset(lexer->lexeme, 0, JSIMPLON_NUMBER_LITERAL_MAX_LENGTH + 1);
-			}
+	table->slots[slot] = string;
+	++table->strings_count;
 
-			lexer->lexeme[lexeme_index++] = c;
+	return string->str;
+}
 
-			continue;
-		}
-		else if (looking_for_number) {
-			if (c == '.') {
-				if (dot_in_effect) {
-					jsimplon_append_str(
-						lexer->error, lexer->error_size,
-						"lexer error: %u:%u: number literal '%s.' has more than one decimal place\n",
-						token.line, token.column,
-						lexer->lexeme
-					);
+JSIMPLON_DEF_INTERNAL void *jsimplon_arena_alloc(Jsimplon_ArenaBlock **arena, size_t size)
+{
+	Jsimplon_ArenaBlock *block = *arena;
 
-					break;
-				}
+	size = (size + 7) & ~(size_t)7;
 
-				if (exponent_in_effect) {
-					jsimplon_append_str(
-						lexer->error, lexer->error_size,
-						"lexer error: %u:%u: floating point exponent in number literal '%s.'\n",
-						token.line, token.column,
-						lexer->lexeme
-					);
+	if (block == NULL || block->size - block->used < size) {
+		// Big allocations get a block of their own and go behind the current one, so its free space isn't wasted
+		bool is_oversized = size > JSIMPLON_ARENA_BLOCK_SIZE / 4;
+		size_t block_size = is_oversized ? size : JSIMPLON_ARENA_BLOCK_SIZE;
 
-					break;
-				}
+		Jsimplon_ArenaBlock *new_block = malloc(sizeof *new_block + block_size);
+		new_block->size = block_size;
+		new_block->used = 0;
 
-				dot_in_effect = true;
-				lexer->lexeme[lexeme_index++] = c;
+		if (is_oversized && block != NULL) {
+			new_block->next = block->next;
+			block->next = new_block;
+			new_block->used = size;
 
-				continue;
-			}
-			else if (c == 'e') {
-				if (exponent_in_effect) {
-					jsimplon_append_str(
-						lexer->error, lexer->error_size,
-						"lexer error: %u:%u: number literal '%se' has more than one exponent marker\n",
-						token.line, token.column,
-						lexer->lexeme
-					);
+			return new_block->data;
+		}
 
-					break;
-				}
+		new_block->next = block;
+		*arena = block = new_block;
+	}
 
-				if (lexer->lexeme[lexeme_index - 1] == '.') {
-					jsimplon_append_str(
-						lexer->error, lexer->error_size,
-						"lexer error: %u:%u: number literal '%se' has exponent marker right after '.'\n",
-						token.line, token.column,
-						lexer->lexeme
-					);
+	void *ptr = (char *)block->data + block->used;
+	block->used += size;
 
-					break;
-				}
+	return ptr;
+}
 
-				exponent_in_effect = true;
-				lexer->lexeme[lexeme_index++] = c;
+#ifdef JSIMPLON_THREADS
+// The blocks go behind the arena's current one, like oversized allocations do
+JSIMPLON_DEF_INTERNAL void jsimplon_arena_splice(Jsimplon_ArenaBlock **arena, Jsimplon_ArenaBlock *blocks)
+{
+	if (blocks == NULL)
+		return;
 
-				continue;
-			}
+	Jsimplon_ArenaBlock *last = blocks;
+	while (last->next != NULL)
+		last = last->next;
 
-			if (exponent_in_effect && c == '-') {
-				if (exponent_neg_in_effect) {
-					jsimplon_append_str(
-						lexer->error, lexer->error_size,
-						"lexer error: %u:%u: number literal '%s-' has more than one negation sign in the exponent\n",
-						token.line, token.column,
-						lexer->lexeme
-					);
+	if (*arena == NULL) {
+		*arena = blocks;
+	}
+	else {
+		last->next = (*arena)->next;
+		(*arena)->next = blocks;
+	}
+}
+#endif
 
-					break;
-				}
+JSIMPLON_DEF_INTERNAL void jsimplon_arena_destroy(Jsimplon_ArenaBlock *arena)
+{
+	while (arena != NULL) {
+		Jsimplon_ArenaBlock *next = arena->next;
+		free(arena);
+		arena = next;
+	}
+}
 
-				exponent_neg_in_effect = true;
-				lexer->lexeme[lexeme_index++] = c;
+// Doubling keeps appending amortised O(1), n pushes cost about log2(n) reallocs
+JSIMPLON_DEF_INTERNAL void jsimplon_object_grow(Jsimplon_Document *document, Jsimplon_Object *object)
+{
+	jsimplon_object_resize(document, object, object->members_size < 4 ? 4 : object->members_size * 2);
+}
 
-				continue;
-			}
+JSIMPLON_DEF_INTERNAL void jsimplon_object_resize(Jsimplon_Document *document, Jsimplon_Object *object, uint32_t new_size)
+{
+	if (new_size == 0) {
+		jsimplon_document_free(document, object->members);
+		object->members = NULL;
+	}
+	else {
+		object->members = jsimplon_document_realloc(
+			document, object->members,
+			object->members_size * (sizeof *object->members) + jsimplon_object_index_size(object->members_size),
+			new_size * (sizeof *object->members) + jsimplon_object_index_size(new_size)
+		);
+	}
 
-			looking_for_number = false;
+	object->members_size = new_size;
 
-			token.type = JSIMPLON_TOKEN_NUMBER_LITERAL;
-			token.value = malloc(strlen(lexer->lexeme) + 1);
-			strcpy(token.value, lexer->lexeme);
+	// The index moved along with the end of the members, it's rebuilt the next time it's needed
+	if (jsimplon_object_index_size(new_size) > 0) {
+		Jsimplon_ObjectIndex *index = (Jsimplon_ObjectIndex *)&object->members[new_size];
+		Jsimplon_Document *owner = jsimplon_object_document(object);
 
-			--lexer->index;
+		index->keys_version = owner != NULL ? owner->keys_version : 0;
+		index->slots_count = 1;
+		while (index->slots_count < 2 * (uint64_t)new_size)
+			index->slots_count *= 2;
 
-			break;
-		}
-		else if (c == '-') {
-			looking_for_number = true;
+		jsimplon_object_index_reset(index);
+	}
+}
+
+JSIMPLON_DEF_INTERNAL size_t jsimplon_object_index_size(uint32_t members_size)
+{
+	if (members_size < JSIMPLON_OBJECT_INDEX_THRESHOLD)
+		return 0;
 
-			lexeme_index = 0;
-			memset(lexer->lexeme, 0, JSIMPLON_NUMBER_LITERAL_MAX_LENGTH + 1);
+	size_t slots_count = 1;
+	while (slots_count < 2 * (uint64_t)members_size)
+		slots_count *= 2;
 
-			lexer->lexeme[lexeme_index++] = c;
+	return sizeof(Jsimplon_ObjectIndex) + slots_count * sizeof(uint32_t);
+}
 
-			continue;
-		}
+// Re-slots the members of its own that were renamed since the last time and indexes whatever members were added
+JSIMPLON_DEF_INTERNAL Jsimplon_ObjectIndex *jsimplon_object_index_update(Jsimplon_Object *object)
+{
+	if (jsimplon_object_index_size(object->members_size) == 0)
+		return NULL;
 
-		if (isalpha(c)) {
-			if (!looking_for_tfl) {
-				looking_for_tfl = true;
+	Jsimplon_ObjectIndex *index = (Jsimplon_ObjectIndex *)&object->members[object->members_size];
+	Jsimplon_Document *document = jsimplon_object_document(object);
+	uint64_t keys_version = document != NULL ? document->keys_version : 0;
 
-				lexeme_index = 0;
-				memset(lexer->lexeme, 0, JSIMPLON_STRING_LITERAL_MAX_LENGTH + 1);
-			}
+	if (keys_version - index->keys_version > JSIMPLON_RENAMED_KEYS_COUNT)
+		jsimplon_object_index_reset(index);
 
-			lexer->lexeme[lexeme_index++] = c;
+	// The members array hasn't moved since the index last caught up, it's reset whenever it does
+	for (uint64_t version = index->keys_version; version < keys_version && index->indexed_count > 0; ++version) {
+		Jsimplon_Member *member = document->renamed_keys[version % JSIMPLON_RENAMED_KEYS_COUNT];
 
+		if (member < object->members || member >= &object->members[index->indexed_count])
 			continue;
-		}
-		else if (looking_for_tfl) {
-			if (strcmp(lexer->lexeme, "true") == 0) {
-				token.type = JSIMPLON_TOKEN_TRUE;
-			}
-			else if (strcmp(lexer->lexeme, "false") == 0) {
-				token.type = JSIMPLON_TOKEN_NULL;
-			}
-			else if (strcmp(lexer->lexeme, "null") == 0) {
-				token.type = JSIMPLON_TOKEN_NULL;
-			}
-			else {
-				jsimplon_append_str(
-					lexer->error, lexer->error_size,
-					"lexer error: %u:%u: unknown character sequence '%s'\n",
-					token.line, token.column,
-					lexer->lexeme,
-					JSIMPLON_NUMBER_LITERAL_MAX_LENGTH
-				);
-				++lexer->error_count;
-			}
 
-			--lexer->index;
+		if (!jsimplon_object_index_reslot(object, index, (uint32_t)(member - object->members)))
+			jsimplon_object_index_reset(index);
+	}
 
-			break;
-		}
+	index->keys_version = keys_version;
 
+	uint32_t mask = index->slots_count - 1;
 
-		if (isspace(c)) {
-			if (c == '\n') {
-				lexer->begin_of_line = lexer->index;
-				++lexer->line;
-			}
+	for (; index->indexed_count < object->members_count; ++index->indexed_count) {
+		const Jsimplon_Member *member = &object->members[index->indexed_count];
+		const char *key = jsimplon_member_key(member);
 
-			continue;
-		}
+		// Members added with jsimplon_object_add_member get their key later, until then they're searched for linearly
+		if (key == NULL)
+			break;
 
-		switch (c) {
-			case '{':
-				token.type = JSIMPLON_TOKEN_LBRACE;
-				break;
-			case '}':
-				token.type = JSIMPLON_TOKEN_RBRACE;
-				break;
-			case '[':
-				token.type = JSIMPLON_TOKEN_LBRACKET;
-				break;
-			case ']':
-				token.type = JSIMPLON_TOKEN_RBRACKET;
-				break;
-			case ':':
-				token.type = JSIMPLON_TOKEN_COLON;
-				break;
-			case ',':
-				token.type = JSIMPLON_TOKEN_COMMA;
-				break;
-			default:
-				jsimplon_append_str(
-					lexer->error, lexer->error_size,
-					"lexer error: %u:%u: stray '%c'\n",
-					token.line, token.column,
-					c
-				);
-				++lexer->error_count;
+		size_t length = jsimplon_member_key_length(member);
+		uint32_t slot = (uint32_t)jsimplon_hash(key, length) & mask;
 
-				break;
-		}
-	} while (token.type == 0);
+		// Duplicate keys keep the first member's slot, the one a linear search would find
+		while (index->slots[slot] != 0 && !jsimplon_member_key_equals(&object->members[index->slots[slot] - 1], key, length))
+			slot = (slot + 1) & mask;
 
-	return token;
+		if (index->slots[slot] == 0)
+			index->slots[slot] = index->indexed_count + 1;
+		else
+			index->has_duplicates = true;
+	}
+
+	return index;
 }
 
-JSIMPLON_DEF_INTERNAL const char *jsimplon_token_to_str(Jsimplon_Token token)
+JSIMPLON_DEF_INTERNAL void jsimplon_object_index_reset(Jsimplon_ObjectIndex *index)
 {
-	switch (token.type) {
-		case JSIMPLON_TOKEN_END:
-			return "TOKEN_END";
-		case JSIMPLON_TOKEN_STRING_LITERAL:
-		case JSIMPLON_TOKEN_NUMBER_LITERAL:
-			return token.value;
-		case JSIMPLON_TOKEN_TRUE:
-			return "true";
-		case JSIMPLON_TOKEN_FALSE:
-			return "false";
-		case JSIMPLON_TOKEN_NULL:
-			return "null";
-		case JSIMPLON_TOKEN_LBRACE:
-			return "{";
-		case JSIMPLON_TOKEN_RBRACE:
-			return "}";
-		case JSIMPLON_TOKEN_LBRACKET:
-			return "[";
-		case JSIMPLON_TOKEN_RBRACKET:
-			return "]";
-		case JSIMPLON_TOKEN_COMMA:
-			return ",";
-		case JSIMPLON_TOKEN_COLON:
-			return ":";
-	}
+	memset(index->slots, 0, index->slots_count * sizeof *index->slots);
+	index->indexed_count = 0;
+	index->stale_count = 0;
+	index->has_duplicates = false;
 }
 
-JSIMPLON_DEF_INTERNAL void jsimplon_value_to_str(Jsimplon_Serialiser *s, const Jsimplon_Value *value)
+// The slot of the member's old key stays behind, it can't be emptied without breaking the probe runs through it
+JSIMPLON_DEF_INTERNAL bool jsimplon_object_index_reslot(Jsimplon_Object *object, Jsimplon_ObjectIndex *index, uint32_t member_index)
 {
-	if (value == NULL) {
-		jsimplon_append_str(
-			s->error, s->error_size,
-			"serialisation error: null value\n" // TODO: Make this more helpful?
-		);
-		++s->error_count;
+	// A later member with the old key may have been left out for it, and the slots are kept at most half full
+	if (index->has_duplicates || index->indexed_count + index->stale_count >= object->members_size)
+		return false;
+
+	const Jsimplon_Member *member = &object->members[member_index];
+	const char *key = jsimplon_member_key(member);
+	size_t length = jsimplon_member_key_length(member);
+	uint32_t mask = index->slots_count - 1;
+	uint32_t slot = (uint32_t)jsimplon_hash(key, length) & mask;
+	bool is_slotted = false;
+
+	// The whole probe run, any other member with the new key might come first and only a rebuild sorts that out
+	for (; index->slots[slot] != 0; slot = (slot + 1) & mask) {
+		if (!jsimplon_member_key_equals(&object->members[index->slots[slot] - 1], key, length))
+			continue;
 
-		return;
-	}
+		if (index->slots[slot] - 1 != member_index)
+			return false;
 
-	switch (value->type) {
-		case JSIMPLON_VALUE_UNINITIALISED:
-			jsimplon_append_str(
-				s->error, s->error_size,
-				"serialisation error: uninitialised value\n"
-			);
-			++s->error_count;
+		is_slotted = true;
+	}
 
-			break;
-		case JSIMPLON_VALUE_OBJECT:
-			jsimplon_object_to_str(s, &value->object_value);
-			break;
-		case JSIMPLON_VALUE_ARRAY:
-			jsimplon_array_to_str(s, &value->array_value);
-			break;
-		case JSIMPLON_VALUE_STRING:
-			jsimplon_append_str(
-				&s->str, &s->str_size,
-				"\"%s\"", value->string_value
-			);
-			break;
-		case JSIMPLON_VALUE_NUMBER:
-			jsimplon_append_str(
-				&s->str, &s->str_size,
-				"%lf", value->number_value
-			);
-			break;
-		case JSIMPLON_VALUE_BOOL:
-			if (value->bool_value == true)
-				jsimplon_append_str(&s->str, &s->str_size, "true");
-			else
-				jsimplon_append_str(&s->str, &s->str_size, "false");
-			break;
-		case JSIMPLON_VALUE_NULL:
-			jsimplon_append_str(&s->str, &s->str_size, "null");
-			break;
+	if (!is_slotted) {
+		index->slots[slot] = member_index + 1;
+		++index->stale_count;
 	}
+
+	return true;
 }
 
-JSIMPLON_DEF_INTERNAL void jsimplon_object_to_str(Jsimplon_Serialiser *s, const Jsimplon_Object *object)
+JSIMPLON_DEF_INTERNAL Jsimplon_Member *jsimplon_object_index_find(Jsimplon_Object *object, Jsimplon_ObjectIndex *index, const char *key, size_t length, uint64_t hash)
 {
-	jsimplon_append_str(&s->str, &s->str_size, "{");
+	uint32_t mask = index->slots_count - 1;
 
-	for (uint32_t i = 0; i < object->members_count; ++i) {
-		if (i > 0)
-			jsimplon_append_str(&s->str, &s->str_size, ",");
+	for (uint32_t slot = (uint32_t)hash & mask; index->slots[slot] != 0; slot = (slot + 1) & mask) {
+		Jsimplon_Member *member = &object->members[index->slots[slot] - 1];
 
-		const Jsimplon_Member *member = &object->members[i];
+		if (jsimplon_member_key_equals(member, key, length))
+			return member;
+	}
 
-		jsimplon_append_str(
-			&s->str, &s->str_size,
-			"\"%s\"", member->key
-		);
-		jsimplon_append_str(&s->str, &s->str_size, ":");
-		jsimplon_value_to_str(s, &member->value);
+	for (uint32_t i = index->indexed_count; i < object->members_count; ++i) {
+		if (jsimplon_member_key_equals(&object->members[i], key, length))
+			return &object->members[i];
 	}
 
-	jsimplon_append_str(&s->str, &s->str_size, "}");
+	return NULL;
 }
 
-JSIMPLON_DEF_INTERNAL void jsimplon_array_to_str(Jsimplon_Serialiser *s, const Jsimplon_Array *array)
+// Lengths first, keys that share a long prefix rarely share a length as well
+JSIMPLON_DEF_INTERNAL bool jsimplon_key_equals(const char *a, size_t a_length, const char *b, size_t b_length)
 {
-	jsimplon_append_str(&s->str, &s->str_size, "[");
-
-	for (uint32_t i = 0; i < array->values_count; ++i) {
-		if (i > 0)
-			jsimplon_append_str(&s->str, &s->str_size, ",");
-
-		jsimplon_value_to_str(s, &array->values[i]);
-	}
+	if (a_length != b_length)
+		return false;
 
-	jsimplon_append_str(&s->str, &s->str_size, "]");
+	// Interned keys are often the very same string
+	return a == b || memcmp(a, b, a_length) == 0;
 }
 
-JSIMPLON_DEF_INTERNAL void jsimplon_value_destroy(Jsimplon_Value *value)
+JSIMPLON_DEF_INTERNAL void jsimplon_array_grow(Jsimplon_Document *document, Jsimplon_Array *array)
 {
-	switch (value->type) {
-		case JSIMPLON_VALUE_STRING:
-			free(value->string_value);
-			break;
-		case JSIMPLON_VALUE_OBJECT:
-			jsimplon_object_destroy(&value->object_value);
-			break;
-		case JSIMPLON_VALUE_ARRAY:
-			jsimplon_array_destroy(&value->array_value);
-			break;
-		default:
-			break;
-	}
-
-	memset(value, 0, sizeof *value);
+	jsimplon_array_resize(document, array, array->values_size < 4 ? 4 : array->values_size * 2);
 }
 
-JSIMPLON_DEF_INTERNAL void jsimplon_object_destroy(Jsimplon_Object *object)
+JSIMPLON_DEF_INTERNAL void jsimplon_array_resize(Jsimplon_Document *document, Jsimplon_Array *array, uint32_t new_size)
 {
-	if (object->members == NULL)
-		return;
+	if (new_size == 0) {
+		jsimplon_document_free(document, array->values);
+		array->values = NULL;
+	}
+	else {
+		array->values = jsimplon_document_realloc(
+			document, array->values,
+			array->values_size * (sizeof *array->values),
+			new_size * (sizeof *array->values)
+		);
+	}
 
-	for (uint32_t i = 0; i < object->members_count; ++i)
-		jsimplon_member_destroy(&object->members[i]);
-	free(object->members);
-	memset(object, 0, sizeof *object);
+	array->values_size = new_size;
 }
 
-JSIMPLON_DEF_INTERNAL void jsimplon_member_destroy(Jsimplon_Member *member)
+JSIMPLON_DEF_INTERNAL Jsimplon_Document *jsimplon_object_document(Jsimplon_Object *object)
 {
-	if (member->key == NULL)
-		return;
-
-	free(member->key);
-	jsimplon_value_destroy(&member->value);
-	memset(member, 0, sizeof *member);
+	return jsimplon_tag_document(object->tag);
 }
 
-JSIMPLON_DEF_INTERNAL void jsimplon_array_destroy(Jsimplon_Array *array)
+JSIMPLON_DEF_INTERNAL Jsimplon_Document *jsimplon_array_document(Jsimplon_Array *array)
 {
-	if (array->values == NULL)
-		return;
-
-	for (uint32_t i = 0; i < array->values_count; ++i)
-		jsimplon_value_destroy(&array->values[i]);
-	free(array->values);
-	memset(array, 0, sizeof *array);
+	return jsimplon_tag_document(array->tag);
 }
 
 JSIMPLON_DEF_INTERNAL void jsimplon_append_str(char **str, size_t *str_size, const char *fmt, ...)
@@ -1647,6 +6853,18 @@ JSIMPLON_DEF_INTERNAL void jsimplon_append_str(char **str, size_t *str_size, con
 	va_end(args);
 }
 
+JSIMPLON_DEF_INTERNAL uint64_t jsimplon_hash(const char *key, size_t length)
+{
+	uint64_t hash = 0xcbf29ce484222325;
+
+	for (size_t i = 0; i < length; ++i) {
+		hash ^= (uint8_t)key[i];
+		hash *= 0x100000001b3;
+	}
+
+	return hash;
+}
+
 JSIMPLON_DEF_INTERNAL char *jsimplon_file_read(char **error, size_t *error_size, const char *file_name)
 {
 	char *buffer = NULL;
@@ -1687,6 +6905,66 @@ jsimplon_file_read_defer:
 	return buffer;
 }
 
+// Falls back on reading the file into the heap where there's no mmap, for empty files, which can't be mapped, and for
+// anything that isn't a regular file. is_mapped says which one it was for jsimplon_file_unmap
+JSIMPLON_DEF_INTERNAL char *jsimplon_file_map(char **error, size_t *error_size, const char *file_name, bool is_writable, size_t *length, bool *is_mapped)
+{
+	*is_mapped = false;
+
+#ifdef JSIMPLON_MMAP
+	int fd = open(file_name, O_RDONLY);
+	struct stat st;
+
+	if (fd >= 0 && fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && (uint64_t)st.st_size <= SIZE_MAX) {
+		// Private mappings never write back to the file, in place parsing only ever copies the pages it touches
+		void *src = mmap(NULL, (size_t)st.st_size, is_writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fd, 0);
+
+		if (src != MAP_FAILED) {
+			close(fd);
+
+			// Only declared with the POSIX or default feature macros
+#if defined(MADV_SEQUENTIAL)
+			madvise(src, (size_t)st.st_size, MADV_SEQUENTIAL);
+#elif defined(POSIX_MADV_SEQUENTIAL)
+			posix_madvise(src, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+#endif
+
+			*length = (size_t)st.st_size;
+			*is_mapped = true;
+
+			return src;
+		}
+	}
+
+	if (fd >= 0)
+		close(fd);
+#else
+	(void)is_writable;
+#endif
+
+	char *src = jsimplon_file_read(error, error_size, file_name);
+
+	if (src != NULL)
+		*length = strlen(src);
+
+	return src;
+}
+
+JSIMPLON_DEF_INTERNAL void jsimplon_file_unmap(char *src, size_t length, bool is_mapped)
+{
+#ifdef JSIMPLON_MMAP
+	if (is_mapped) {
+		munmap(src, length);
+		return;
+	}
+#else
+	(void)is_mapped;
+#endif
+	(void)length;
+
+	free(src);
+}
+
 JSIMPLON_DEF_INTERNAL int jsimplon_file_write(char **error, size_t *error_size, const char *file_name, const char *src)
 {
 	int status = JSIMPLON_SUCCESS;
@@ -1720,5 +6998,3 @@ jsimplon_file_write_defer:
 #endif // JSIMPLON_IMPLEMENTATION
 
 #endif // JSIMPLON_H_
-
-// TODO: Add support for escape sequences in strings
@@ -0,0 +1,105 @@
+#define JSIMPLON_IMPLEMENTATION
+#include "jsimplon.h"
+#include "test.h"
+
+// depth opening brackets, inner in the middle, then the closing ones
+static char *nested(size_t depth, char open, const char *inner, char close)
+{
+	size_t inner_len = strlen(inner);
+	char *src = malloc(2 * depth + inner_len + 1);
+
+	memset(src, open, depth);
+	memcpy(&src[depth], inner, inner_len);
+	memset(&src[depth + inner_len], close, depth);
+	src[2 * depth + inner_len] = '\0';
+
+	return src;
+}
+
+// Fails with the depth error at where it says, or parses and prints back the same
+static void check_parse(const char *src, const Jsimplon_Options *options, const char *where)
+{
+	char *error;
+	Jsimplon_Value *root = jsimplon_tree_from_str_ex(&error, src, strlen(src), options);
+
+	if (where != NULL) {
+		CHECK(root == NULL);
+		CHECK(error != NULL && strstr(error, "nesting is deeper than") != NULL && strstr(error, where) != NULL);
+	}
+	else {
+		char *str = jsimplon_tree_to_str(NULL, root);
+		CHECK(root != NULL && str != NULL && strcmp(str, src) == 0);
+		free(str);
+	}
+
+	free(error);
+	jsimplon_tree_destroy(root);
+}
+
+static void check_sax(const char *src, const Jsimplon_Options *options, int status)
+{
+	Jsimplon_SaxHandler handler = { 0 };
+	CHECK(jsimplon_sax_parse(NULL, src, strlen(src), &handler, NULL, options) == status);
+}
+
+int main(void)
+{
+	char *deep = nested(100000, '[', "", ']');
+	char *deep_objects = nested(100000, '[', "{\"a\":1}", ']');
+	char *empty_past = nested(1025, '[', "", ']');
+	char *empty_at = nested(1024, '[', "", ']');
+	char *object_at = nested(1023, '[', "{}", ']');
+	char *object_past = nested(1024, '[', "{}", ']');
+
+	for (int lazy = 0; lazy <= 1; ++lazy) {
+		for (int engine = JSIMPLON_ENGINE_TOKENS; engine <= JSIMPLON_ENGINE_STRUCTURAL; ++engine) {
+			Jsimplon_Options options = { .engine = engine, .lazy = lazy };
+
+			// Far too deep, rejected where the limit is crossed rather than overflowing anything
+			check_parse(deep, &options, "1:1025:");
+			check_parse(deep_objects, &options, "1:1025:");
+
+			// The default limit, with an empty container as the level past it
+			check_parse(empty_at, &options, NULL);
+			check_parse(empty_past, &options, "1:1025:");
+			check_parse(object_at, &options, NULL);
+			check_parse(object_past, &options, "1:1025:");
+
+			// A limit of its own, the innermost empty object being the level past it
+			options.max_depth = 3;
+			check_parse("{\"a\":{\"b\":{\"c\":1}}}", &options, NULL);
+			check_parse("{\"a\":{\"b\":{\"c\":{}}}}", &options, "1:16:");
+			check_parse("{\"a\":{\"b\":{\"c\":[]}}}", &options, "1:16:");
+			check_parse("[1,\n[[[]]]]", &options, "2:3:");
+		}
+	}
+
+	// The SAX driver keeps to the same limit
+	check_sax(deep, NULL, JSIMPLON_FAILURE);
+	check_sax(empty_past, NULL, JSIMPLON_FAILURE);
+	check_sax(empty_at, NULL, JSIMPLON_SUCCESS);
+
+	Jsimplon_Options options = { .max_depth = 3 };
+	check_sax("{\"a\":{\"b\":{\"c\":{}}}}", &options, JSIMPLON_FAILURE);
+	check_sax("{\"a\":{\"b\":{\"c\":1}}}", &options, JSIMPLON_SUCCESS);
+
+	// And so does the stream parser, fed a byte at a time
+	Jsimplon_StreamParser *stream = jsimplon_stream_parser_create(NULL);
+	char *error = NULL;
+
+	for (size_t i = 0; i < strlen(empty_past); ++i)
+		jsimplon_stream_parser_feed(NULL, stream, &empty_past[i], 1);
+
+	CHECK(jsimplon_stream_parser_finish(&error, stream) == NULL);
+	CHECK(error != NULL && strstr(error, "nesting is deeper than") != NULL);
+	free(error);
+
+	free(deep);
+	free(deep_objects);
+	free(empty_past);
+	free(empty_at);
+	free(object_at);
+	free(object_past);
+
+	return TEST_RESULT();
+}
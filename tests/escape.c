@@ -0,0 +1,127 @@
+#define JSIMPLON_IMPLEMENTATION
+#include "jsimplon.h"
+#include "test.h"
+
+// The one string in a document like ["..."], or NULL if it doesn't parse
+static Jsimplon_Value *parse(const char *src, const Jsimplon_Options *options, bool is_insitu, char *buf)
+{
+	if (is_insitu) {
+		memcpy(buf, src, strlen(src) + 1);
+		return jsimplon_tree_from_buffer_insitu_ex(NULL, buf, strlen(buf), options);
+	}
+
+	return jsimplon_tree_from_str_ex(NULL, src, strlen(src), options);
+}
+
+static void check_decoded(const char *src, const char *expected, size_t expected_length, const Jsimplon_Options *options)
+{
+	char buf[256];
+
+	for (int is_insitu = 0; is_insitu <= 1; ++is_insitu) {
+		Jsimplon_Value *root = parse(src, options, is_insitu, buf);
+		CHECK(root != NULL);
+
+		Jsimplon_Value *value = jsimplon_array_get_value_at_index(jsimplon_value_get_array(root), 0);
+		CHECK(jsimplon_value_get_str_len(value) == expected_length);
+		CHECK(jsimplon_value_get_str(value) != NULL && memcmp(jsimplon_value_get_str(value), expected, expected_length + 1) == 0);
+
+		jsimplon_tree_destroy(root);
+	}
+}
+
+static void check_fails(const char *src, const Jsimplon_Options *options, const char *message)
+{
+	char *error;
+	CHECK(jsimplon_tree_from_str_ex(&error, src, strlen(src), options) == NULL);
+	CHECK(error != NULL && strstr(error, message) != NULL);
+	free(error);
+}
+
+int main(void)
+{
+	Jsimplon_Options options[] = {
+		{ 0 },
+		{ .use_arena = true, .intern_strings = true },
+		{ .engine = JSIMPLON_ENGINE_STRUCTURAL }
+	};
+
+	for (size_t i = 0; i < sizeof options / sizeof *options; ++i) {
+		// A surrogate pair is one code point, four bytes of UTF-8
+		check_decoded("[\"\\uD83D\\uDE00\"]", "\xF0\x9F\x98\x80", 4, &options[i]);
+		check_decoded("[\"x\\ud83d\\ude00y\"]", "x\xF0\x9F\x98\x80y", 6, &options[i]);
+		check_decoded("[\"\\u00e9\\u20AC\\u0041\"]", "\xC3\xA9\xE2\x82\xAC" "A", 6, &options[i]);
+
+		// Lone halves become U+FFFD, and so does a high one followed by anything but a low one
+		check_decoded("[\"\\uD83D\"]", "\xEF\xBF\xBD", 3, &options[i]);
+		check_decoded("[\"\\uDE00\"]", "\xEF\xBF\xBD", 3, &options[i]);
+		check_decoded("[\"a\\uD83Db\"]", "a\xEF\xBF\xBD" "b", 5, &options[i]);
+		check_decoded("[\"\\uD83D\\u0041\"]", "\xEF\xBF\xBD" "A", 4, &options[i]);
+		check_decoded("[\"\\uDE00\\uD83D\"]", "\xEF\xBF\xBD\xEF\xBF\xBD", 6, &options[i]);
+
+		// A NUL is kept whether the string is short, long, in place or not
+		check_decoded("[\"\\u0000\"]", "\0", 1, &options[i]);
+		check_decoded("[\"a\\u0000b\"]", "a\0b", 3, &options[i]);
+		check_decoded(
+			"[\"a string long enough to be out of line \\u0000 with a NUL\"]",
+			"a string long enough to be out of line \0 with a NUL", 51, &options[i]
+		);
+
+		// The short escapes
+		check_decoded("[\"\\\"\\\\\\/\\b\\f\\n\\r\\t\"]", "\"\\/\b\f\n\r\t", 8, &options[i]);
+
+		// Unescaped control characters and broken escapes
+		check_fails("[\"a\tb\"]", &options[i], "unescaped control character 0x09");
+		check_fails("[\"a\x01\"]", &options[i], "unescaped control character 0x01");
+		check_fails("[\"a\x1F\"]", &options[i], "unescaped control character 0x1F");
+		check_fails("[\"a\nb\"]", &options[i], "newline character");
+		check_fails("[\"\\x\"]", &options[i], "invalid escape sequence");
+		check_fails("[\"\\u12G4\"]", &options[i], "invalid escape sequence");
+		check_fails("[\"\\u12\"]", &options[i], "invalid escape sequence");
+	}
+
+	// Strict decoding turns lone halves down instead
+	Jsimplon_Options strict = { .validate_utf8 = true };
+	check_decoded("[\"\\uD83D\\uDE00\"]", "\xF0\x9F\x98\x80", 4, &strict);
+	check_fails("[\"\\uD83D\"]", &strict, "unpaired surrogate \\uD83D");
+	check_fails("[\"\\uDE00\"]", &strict, "unpaired surrogate \\uDE00");
+	check_fails("[\"\\uD83D\\u0041\"]", &strict, "unpaired surrogate \\uD83D");
+
+	// Everything that has to be escaped is on the way out, and reads back the same
+	Jsimplon_Value *root = jsimplon_tree_root_create();
+	Jsimplon_Array *array = jsimplon_value_set_array(root);
+
+	char all[64];
+	size_t all_length = 0;
+	for (int c = 0; c < 0x20; ++c)
+		all[all_length++] = (char)c;
+	memcpy(&all[all_length], "\"\\/\x7F\xC3\xA9", 6);
+	all_length += 6;
+
+	jsimplon_value_set_str_len(jsimplon_array_push_value(array), all, all_length);
+	jsimplon_array_push_str(array, "quote \" backslash \\ tab \t");
+
+	char *str = jsimplon_tree_to_str(NULL, root);
+	CHECK(str != NULL);
+	CHECK(strstr(str, "\\u0000\\u0001") != NULL && strstr(str, "\\b\\t\\n\\u000b\\f\\r") != NULL && strstr(str, "\\u001f\\\"\\\\/") != NULL);
+	CHECK(strstr(str, "\"quote \\\" backslash \\\\ tab \\t\"") != NULL);
+
+	for (const char *c = str; *c != '\0'; ++c)
+		CHECK((unsigned char)*c >= 0x20);
+
+	Jsimplon_Value *again = jsimplon_tree_from_str(NULL, str);
+	CHECK(again != NULL);
+
+	Jsimplon_Value *value = jsimplon_array_get_value_at_index(jsimplon_value_get_array(again), 0);
+	CHECK(jsimplon_value_get_str_len(value) == all_length && memcmp(jsimplon_value_get_str(value), all, all_length) == 0);
+	CHECK(strcmp(jsimplon_value_get_str(jsimplon_array_get_value_at_index(jsimplon_value_get_array(again), 1)), "quote \" backslash \\ tab \t") == 0);
+
+	char *str_again = jsimplon_tree_to_str(NULL, again);
+	CHECK(str_again != NULL && strcmp(str, str_again) == 0);
+
+	free(str_again);
+	free(str);
+	jsimplon_tree_destroy(again);
+	jsimplon_tree_destroy(root);
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,157 @@
+#define JSIMPLON_IMPLEMENTATION
+#include "jsimplon.h"
+#include "test.h"
+
+// What a lookup has to agree with, the first member with the key
+static Jsimplon_Member *linear_find(Jsimplon_Object *object, const char *key)
+{
+	for (size_t i = 0; i < jsimplon_object_get_member_count(object); ++i) {
+		Jsimplon_Member *member = jsimplon_object_get_member_at_index(object, i);
+
+		if (jsimplon_member_get_key(member) != NULL && strcmp(jsimplon_member_get_key(member), key) == 0)
+			return member;
+	}
+
+	return NULL;
+}
+
+static void check_lookups(Jsimplon_Object *object, int keys_count)
+{
+	char key[16];
+
+	for (int i = 0; i < keys_count; ++i) {
+		snprintf(key, sizeof key, "key_%d", i);
+		CHECK(jsimplon_object_get_member(object, key) == linear_find(object, key));
+	}
+}
+
+static void add_members(Jsimplon_Object *object, int from, int to)
+{
+	char key[16];
+
+	for (int i = from; i < to; ++i) {
+		snprintf(key, sizeof key, "key_%d", i);
+		jsimplon_object_add_member_int64(object, key, i);
+	}
+}
+
+static void check_index(const Jsimplon_Options *options)
+{
+	Jsimplon_Value *root = jsimplon_tree_root_create_ex(options);
+	Jsimplon_Object *object = jsimplon_value_set_object(root);
+	Jsimplon_Object *other = jsimplon_object_add_member_object(object, "other");
+
+	add_members(object, 1, 100);
+	add_members(other, 0, 100);
+	CHECK(jsimplon_object_get_member_count(object) > JSIMPLON_OBJECT_INDEX_THRESHOLD);
+	check_lookups(object, 100);
+
+	// Renamed keys are found under their new name and not under the old one
+	Jsimplon_Member *member = jsimplon_object_get_member(object, "key_10");
+	CHECK(jsimplon_member_set_key(member, "renamed") == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_object_get_member(object, "renamed") == member);
+	CHECK(jsimplon_object_get_member(object, "key_10") == NULL);
+	CHECK(jsimplon_member_set_key(member, "key_10") == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_object_get_member(object, "key_10") == member);
+	CHECK(jsimplon_object_get_member(object, "renamed") == NULL);
+
+	// Renaming in one object leaves the other object's index as it is
+	CHECK(jsimplon_object_member_get_int64(other, "key_50") == 50);
+	Jsimplon_ObjectIndex *index = jsimplon_object_index_update(other);
+	uint32_t indexed_count = index->indexed_count;
+	CHECK(jsimplon_member_set_key(jsimplon_object_get_member(object, "key_20"), "key_twenty") == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_object_member_get_int64(other, "key_50") == 50);
+	CHECK(index->indexed_count == indexed_count);
+	CHECK(jsimplon_object_member_get_int64(object, "key_twenty") == 20);
+
+	// Duplicate keys, the first member wins, also when a rename makes or unmakes one
+	jsimplon_object_add_member_int64(object, "key_30", -30);
+	CHECK(jsimplon_object_member_get_int64(object, "key_30") == 30);
+	CHECK(jsimplon_member_set_key(jsimplon_object_get_member(object, "key_30"), "key_thirty") == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_object_member_get_int64(object, "key_30") == -30);
+	CHECK(jsimplon_member_set_key(jsimplon_object_get_member(object, "key_40"), "key_41") == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_object_member_get_int64(object, "key_41") == 40);
+	CHECK(jsimplon_object_get_member(object, "key_40") == NULL);
+	check_lookups(object, 100);
+
+	// A member added without a key is searched for linearly until it gets one
+	jsimplon_object_add_member(object);
+	size_t late = jsimplon_object_get_member_count(object) - 1;
+	CHECK(jsimplon_object_member_get_int64(object, "key_99") == 99);
+	add_members(object, 100, 110);
+	member = jsimplon_object_get_member_at_index(object, late);
+	CHECK(jsimplon_member_set_key(member, "late") == JSIMPLON_SUCCESS);
+	jsimplon_value_set_int64(jsimplon_member_get_value(member), -1);
+	CHECK(jsimplon_object_member_get_int64(object, "late") == -1);
+	CHECK(jsimplon_object_member_get_int64(object, "key_105") == 105);
+	check_lookups(object, 110);
+
+	// Removing and shrinking move the members under the index
+	CHECK(jsimplon_object_remove_member(object, "key_1") == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_object_remove_member(object, "key_thirty") == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_object_get_member(object, "key_1") == NULL);
+	CHECK(jsimplon_object_member_get_int64(object, "key_30") == -30);
+	CHECK(jsimplon_object_shrink_to_fit(object) == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_object_member_get_int64(object, "late") == -1);
+	check_lookups(object, 110);
+
+	// Many renames, more than the document remembers, against a linear search
+	char key[16];
+	uint32_t state = 1;
+
+	for (int round = 0; round < 2000; ++round) {
+		state = state * 1103515245 + 12345;
+		member = jsimplon_object_get_member_at_index(object, (state >> 8) % jsimplon_object_get_member_count(object));
+		snprintf(key, sizeof key, "key_%u", (state >> 16) % 120);
+
+		CHECK(jsimplon_member_set_key(member, key) == JSIMPLON_SUCCESS);
+
+		if (round % 7 == 0)
+			check_lookups(object, 120);
+	}
+
+	check_lookups(object, 120);
+	check_lookups(other, 100);
+
+	jsimplon_tree_destroy(root);
+}
+
+int main(void)
+{
+	Jsimplon_Options options[] = {
+		{ 0 },
+		{ .use_arena = true },
+		{ .use_arena = true, .intern_strings = true }
+	};
+
+	for (size_t i = 0; i < sizeof options / sizeof *options; ++i)
+		check_index(&options[i]);
+
+	// A parsed object with duplicate keys
+	Jsimplon_Value *root = jsimplon_tree_root_create();
+	Jsimplon_Object *object = jsimplon_value_set_object(root);
+	add_members(object, 0, 40);
+	add_members(object, 0, 40);
+	char *str = jsimplon_tree_to_str(NULL, root);
+	jsimplon_tree_destroy(root);
+
+	for (int engine = JSIMPLON_ENGINE_TOKENS; engine <= JSIMPLON_ENGINE_STRUCTURAL; ++engine) {
+		Jsimplon_Options parse_options = { .engine = engine };
+		root = jsimplon_tree_from_str_ex(NULL, str, strlen(str), &parse_options);
+		object = jsimplon_value_get_object(root);
+
+		CHECK(jsimplon_object_get_member_count(object) == 80);
+		CHECK(jsimplon_object_member_get_int64(object, "key_39") == 39);
+		CHECK(jsimplon_object_get_member(object, "key_39") == jsimplon_object_get_member_at_index(object, 39));
+
+		CHECK(jsimplon_member_set_key(jsimplon_object_get_member_at_index(object, 39), "first") == JSIMPLON_SUCCESS);
+		CHECK(jsimplon_object_get_member(object, "key_39") == jsimplon_object_get_member_at_index(object, 79));
+		check_lookups(object, 40);
+
+		jsimplon_tree_destroy(root);
+	}
+
+	free(str);
+
+	return TEST_RESULT();
+}
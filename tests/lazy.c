@@ -0,0 +1,177 @@
+#define JSIMPLON_IMPLEMENTATION
+#include "jsimplon.h"
+#include "test.h"
+
+static const char *document =
+	"{"
+		"\"name\": \"jsimplon\", \"count\": 3, \"empty\": {}, \"nothing\": [],"
+		"\"nested\": {\"list\": [1, [2, [3, {\"deep\": \"\\u00e9\\\"\"}]], -4.5e1], \"flags\": [true, false, null]},"
+		"\"brackets\": [\"]\", \"}\", \"\\\"]\", {\"[\": \"{\"}],"
+		"\"long\": \"a string long enough to be stored out of line, with a \\\\ in it\""
+	"}";
+
+// Looks into every container, a level at a time
+static void walk(Jsimplon_Value *value)
+{
+	if (jsimplon_value_get_type(value) == JSIMPLON_VALUE_OBJECT) {
+		Jsimplon_Object *object = jsimplon_value_get_object(value);
+
+		for (size_t i = 0; i < jsimplon_object_get_member_count(object); ++i)
+			walk(jsimplon_member_get_value(jsimplon_object_get_member_at_index(object, i)));
+	}
+	else if (jsimplon_value_get_type(value) == JSIMPLON_VALUE_ARRAY) {
+		Jsimplon_Array *array = jsimplon_value_get_array(value);
+
+		for (size_t i = 0; i < jsimplon_array_get_count(array); ++i)
+			walk(jsimplon_array_get_value_at_index(array, i));
+	}
+}
+
+// A lazy tree prints the same as an eager one, whether it's looked into first or not
+static void check_equivalence(const Jsimplon_Options *options, bool is_insitu, bool is_walked)
+{
+	Jsimplon_Options lazy = *options;
+	lazy.lazy = true;
+
+	Jsimplon_Value *eager = jsimplon_tree_from_str_ex(NULL, document, strlen(document), options);
+	char *expected = jsimplon_tree_to_str(NULL, eager);
+	jsimplon_tree_destroy(eager);
+
+	// In place the tree points into the buffer, the skipped containers too
+	char *buf = malloc(strlen(document) + 1);
+	memcpy(buf, document, strlen(document) + 1);
+	Jsimplon_Value *root = is_insitu
+		? jsimplon_tree_from_buffer_insitu_ex(NULL, buf, strlen(buf), &lazy)
+		: jsimplon_tree_from_str_ex(NULL, buf, strlen(buf), &lazy);
+	CHECK(root != NULL);
+
+	if (is_walked)
+		walk(root);
+
+	Jsimplon_Object *object = jsimplon_value_get_object(root);
+	Jsimplon_Array *list = jsimplon_object_member_get_array(jsimplon_object_member_get_object(object, "nested"), "list");
+	list = jsimplon_value_get_array(jsimplon_array_get_value_at_index(list, 1));
+	list = jsimplon_value_get_array(jsimplon_array_get_value_at_index(list, 1));
+	Jsimplon_Object *deep = jsimplon_value_get_object(jsimplon_array_get_value_at_index(list, 1));
+	CHECK(strcmp(jsimplon_object_member_get_str(deep, "deep"), "\xC3\xA9\"") == 0);
+	CHECK(jsimplon_array_get_count(jsimplon_object_member_get_array(object, "brackets")) == 4);
+	CHECK(jsimplon_object_get_member_count(jsimplon_object_member_get_object(object, "empty")) == 0);
+
+	char *str = jsimplon_tree_to_str(NULL, root);
+	CHECK(expected != NULL && str != NULL && strcmp(str, expected) == 0);
+
+	free(str);
+	free(expected);
+	jsimplon_tree_destroy(root);
+	free(buf);
+}
+
+// Errors inside a skipped container only come up when it's looked into
+static void check_malformed(const Jsimplon_Options *options, const char *src, const char *kind)
+{
+	Jsimplon_Options lazy = *options;
+	lazy.lazy = true;
+
+	Jsimplon_Value *eager = jsimplon_tree_from_str_ex(NULL, src, strlen(src), options);
+	CHECK(eager == NULL);
+
+	char *error;
+	Jsimplon_Value *root = jsimplon_tree_from_str_ex(&error, src, strlen(src), &lazy);
+	CHECK(root != NULL);
+	free(error);
+
+	Jsimplon_Object *object = jsimplon_value_get_object(root);
+	CHECK(jsimplon_object_member_get_int64(object, "fine") == 1);
+	CHECK(jsimplon_object_member_get_int64(jsimplon_object_member_get_object(object, "good"), "a") == 2);
+
+	// Again and again, the container is left as it was
+	Jsimplon_Value *bad = jsimplon_object_member_get_value(object, "bad");
+	for (int i = 0; i < 2; ++i) {
+		CHECK(jsimplon_object_get_member_at_index(jsimplon_value_get_object(bad), 0) == NULL);
+		CHECK(jsimplon_array_get_value_at_index(jsimplon_value_get_array(bad), 0) == NULL);
+		CHECK(jsimplon_object_get_member_count(jsimplon_value_get_object(bad)) == 0);
+		CHECK(jsimplon_array_get_count(jsimplon_value_get_array(bad)) == 0);
+	}
+
+	CHECK(jsimplon_tree_to_str(&error, root) == NULL);
+	CHECK(error != NULL && strstr(error, "a lazily parsed") != NULL && strstr(error, kind) != NULL);
+	free(error);
+
+	jsimplon_tree_destroy(root);
+}
+
+int main(void)
+{
+	Jsimplon_Options options[] = {
+		{ 0 },
+		{ .use_arena = true },
+		{ .intern_strings = true },
+		{ .use_arena = true, .intern_strings = true, .validate_utf8 = true }
+	};
+
+	for (size_t i = 0; i < sizeof options / sizeof *options; ++i) {
+		for (int is_insitu = 0; is_insitu <= 1; ++is_insitu) {
+			check_equivalence(&options[i], is_insitu, false);
+			check_equivalence(&options[i], is_insitu, true);
+		}
+
+		check_malformed(&options[i], "{\"fine\": 1, \"good\": {\"a\": 2}, \"bad\": {\"a\" 1}}", "object");
+		check_malformed(&options[i], "{\"fine\": 1, \"good\": {\"a\": 2}, \"bad\": [1,, 2]}", "array");
+		check_malformed(&options[i], "{\"fine\": 1, \"good\": {\"a\": 2}, \"bad\": [\"a\tb\"]}", "array");
+		check_malformed(&options[i], "{\"fine\": 1, \"good\": {\"a\": 2}, \"bad\": {\"a\": [1, 2}]}", "object");
+	}
+
+	// A malformed container deeper down is only found once everything above it is looked into
+	const char *src = "[[[1, tru]]]";
+	Jsimplon_Options lazy = { .lazy = true };
+	char *error;
+	Jsimplon_Value *root = jsimplon_tree_from_str_ex(NULL, src, strlen(src), &lazy);
+	Jsimplon_Array *inner = jsimplon_value_get_array(jsimplon_array_get_value_at_index(jsimplon_value_get_array(root), 0));
+	CHECK(jsimplon_array_get_count(inner) == 1);
+	CHECK(jsimplon_array_get_value_at_index(jsimplon_value_get_array(jsimplon_array_get_value_at_index(inner, 0)), 0) == NULL);
+	CHECK(jsimplon_tree_to_str(&error, root) == NULL);
+	CHECK(error != NULL && strstr(error, "a lazily parsed array is malformed") != NULL);
+	free(error);
+	jsimplon_tree_destroy(root);
+
+	// As deep as max_depth allows, every level looked into on the way down
+	size_t depth = 1024;
+	char *deep = malloc(2 * depth + 2);
+	memset(deep, '[', depth);
+	deep[depth] = '7';
+	memset(&deep[depth + 1], ']', depth);
+	deep[2 * depth + 1] = '\0';
+
+	root = jsimplon_tree_from_str_ex(NULL, deep, strlen(deep), &lazy);
+	CHECK(root != NULL);
+
+	Jsimplon_Value *value = root;
+	for (size_t i = 1; i < depth; ++i)
+		value = jsimplon_array_get_value_at_index(jsimplon_value_get_array(value), 0);
+
+	CHECK(jsimplon_value_get_int64(jsimplon_array_get_value_at_index(jsimplon_value_get_array(value), 0)) == 7);
+
+	char *str = jsimplon_tree_to_str(NULL, root);
+	CHECK(str != NULL && strcmp(str, deep) == 0);
+	free(str);
+	jsimplon_tree_destroy(root);
+	free(deep);
+
+	// And past it, however deep, the parse fails up front instead of when the tree is printed
+	depth = 100000;
+	deep = malloc(2 * depth + 1);
+	memset(deep, '[', depth);
+	memset(&deep[depth], ']', depth);
+	deep[2 * depth] = '\0';
+
+	CHECK(jsimplon_tree_from_str_ex(&error, deep, strlen(deep), &lazy) == NULL);
+	CHECK(error != NULL && strstr(error, "nesting is deeper than 1024 levels") != NULL);
+	free(error);
+
+	CHECK(jsimplon_tree_from_buffer_insitu_ex(&error, deep, strlen(deep), &lazy) == NULL);
+	CHECK(error != NULL && strstr(error, "nesting is deeper than 1024 levels") != NULL);
+	free(error);
+	free(deep);
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,120 @@
+#define JSIMPLON_IMPLEMENTATION
+#include "jsimplon.h"
+#include "test.h"
+
+// Short enough to be stored in the value itself, and too long for that
+static const char short_str[] = "a\0b";
+static const char long_str[] = "a string with a \0 in the middle, too long to be stored inline";
+
+static void check_str(Jsimplon_Value *value, const char *str, size_t length)
+{
+	CHECK(jsimplon_value_get_str_len(value) == length);
+	CHECK(jsimplon_value_get_str(value) != NULL && memcmp(jsimplon_value_get_str(value), str, length + 1) == 0);
+}
+
+static void check_builders(const Jsimplon_Options *options)
+{
+	Jsimplon_Value *root = jsimplon_tree_root_create_ex(options);
+	Jsimplon_Object *object = jsimplon_value_set_object(root);
+
+	// Values and keys with NULs in them, the whole length is kept
+	Jsimplon_Value *value = jsimplon_object_add_member_value_len(object, short_str, sizeof short_str - 1);
+	CHECK(jsimplon_value_set_str_len(value, long_str, sizeof long_str - 1) == JSIMPLON_SUCCESS);
+	check_str(value, long_str, sizeof long_str - 1);
+
+	value = jsimplon_object_add_member_value_len(object, long_str, sizeof long_str - 1);
+	CHECK(jsimplon_value_set_str_len(value, short_str, sizeof short_str - 1) == JSIMPLON_SUCCESS);
+	check_str(value, short_str, sizeof short_str - 1);
+
+	// Keys that only differ after their NUL are different keys
+	CHECK(jsimplon_object_get_member_len(object, short_str, sizeof short_str - 1) == jsimplon_object_get_member_at_index(object, 0));
+	CHECK(jsimplon_object_get_member_len(object, long_str, sizeof long_str - 1) == jsimplon_object_get_member_at_index(object, 1));
+	CHECK(jsimplon_object_get_member_len(object, "a\0c", 3) == NULL);
+	CHECK(jsimplon_object_get_member_len(object, "a", 1) == NULL);
+
+	// The NUL-terminated API sees up to the first NUL
+	CHECK(jsimplon_object_get_member(object, "a") == NULL);
+	jsimplon_object_add_member_str(object, "plain", "text");
+	CHECK(jsimplon_object_get_member_len(object, "plain", 5) != NULL);
+	CHECK(jsimplon_value_get_str_len(jsimplon_object_member_get_value(object, "plain")) == 4);
+
+	// Renaming keeps a key's whole length too
+	Jsimplon_Member *member = jsimplon_object_get_member_at_index(object, 2);
+	CHECK(jsimplon_member_set_key_len(member, "x\0y", 3) == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_member_get_key_len(member) == 3);
+	CHECK(memcmp(jsimplon_member_get_key(member), "x\0y", 4) == 0);
+	CHECK(jsimplon_object_get_member_len(object, "x\0y", 3) == member);
+	CHECK(jsimplon_object_get_member(object, "plain") == NULL);
+
+	// Getters on the wrong thing
+	CHECK(jsimplon_value_get_str_len(root) == 0);
+	CHECK(jsimplon_value_get_str_len(NULL) == 0);
+	CHECK(jsimplon_member_get_key_len(NULL) == 0);
+	CHECK(jsimplon_value_set_str_len(NULL, "a", 1) == JSIMPLON_FAILURE);
+	CHECK(jsimplon_value_set_str_len(value, NULL, 1) == JSIMPLON_FAILURE);
+
+	// NULs go out as \u0000
+	char *str = jsimplon_tree_to_str(NULL, root);
+	CHECK(str != NULL && strstr(str, "\"a\\u0000b\"") != NULL && strstr(str, "\"x\\u0000y\":\"text\"") != NULL);
+	free(str);
+
+	jsimplon_tree_destroy(root);
+}
+
+// Parsed strings carry the length they decode to, whichever way they're stored
+static void check_parsed(const Jsimplon_Options *options)
+{
+	char src[] = "{\"k\\u0000ey\": \"a\\u0000b\", \"\\u00e9\": \"escaped \\\" and long enough to be out of line\", \"\": \"\"}";
+	Jsimplon_Value *root = jsimplon_tree_from_str_ex(NULL, src, strlen(src), options);
+	CHECK(root != NULL);
+
+	Jsimplon_Object *object = jsimplon_value_get_object(root);
+
+	Jsimplon_Member *member = jsimplon_object_get_member_len(object, "k\0ey", 4);
+	CHECK(member != NULL && jsimplon_member_get_key_len(member) == 4);
+	check_str(jsimplon_member_get_value(member), "a\0b", 3);
+
+	member = jsimplon_object_get_member_len(object, "\xC3\xA9", 2);
+	CHECK(member != NULL);
+	check_str(jsimplon_member_get_value(member), "escaped \" and long enough to be out of line", 43);
+
+	member = jsimplon_object_get_member_len(object, "", 0);
+	CHECK(member != NULL && jsimplon_member_get_key_len(member) == 0);
+	check_str(jsimplon_member_get_value(member), "", 0);
+
+	// Round trip
+	char *str = jsimplon_tree_to_str(NULL, root);
+	Jsimplon_Value *again = jsimplon_tree_from_str(NULL, str);
+	CHECK(again != NULL);
+	CHECK(jsimplon_object_get_member(jsimplon_value_get_object(again), "k") == NULL);
+	check_str(jsimplon_member_get_value(jsimplon_object_get_member_len(jsimplon_value_get_object(again), "k\0ey", 4)), "a\0b", 3);
+	free(str);
+
+	jsimplon_tree_destroy(again);
+	jsimplon_tree_destroy(root);
+
+	// In place, the strings with a NUL in them are copied out
+	root = jsimplon_tree_from_buffer_insitu_ex(NULL, src, strlen(src), options);
+	CHECK(root != NULL);
+	object = jsimplon_value_get_object(root);
+	check_str(jsimplon_member_get_value(jsimplon_object_get_member_len(object, "k\0ey", 4)), "a\0b", 3);
+	check_str(jsimplon_object_member_get_value(object, "\xC3\xA9"), "escaped \" and long enough to be out of line", 43);
+	jsimplon_tree_destroy(root);
+}
+
+int main(void)
+{
+	Jsimplon_Options options[] = {
+		{ 0 },
+		{ .use_arena = true },
+		{ .intern_strings = true },
+		{ .engine = JSIMPLON_ENGINE_STRUCTURAL, .use_arena = true, .intern_strings = true }
+	};
+
+	for (size_t i = 0; i < sizeof options / sizeof *options; ++i) {
+		check_builders(&options[i]);
+		check_parsed(&options[i]);
+	}
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,117 @@
+// Small blocks so that even a short input goes through many of them and the workers' ring wraps around
+#define JSIMPLON_NDJSON_BLOCK_SIZE 256
+#define JSIMPLON_IMPLEMENTATION
+#include "jsimplon.h"
+#include "test.h"
+
+typedef struct {
+	size_t records_count;
+	size_t failed_count;
+	size_t next_line;
+	bool is_in_order;
+	size_t stop_at;
+	char last[64];
+} Collector;
+
+static int collect(void *context, size_t line, Jsimplon_Value *tree, const char *error)
+{
+	Collector *collector = context;
+
+	collector->is_in_order &= line >= collector->next_line;
+	collector->next_line = line + 1;
+	++collector->records_count;
+
+	if (tree == NULL) {
+		++collector->failed_count;
+		collector->is_in_order &= error != NULL && error[0] != '\0';
+		snprintf(collector->last, sizeof collector->last, "%zu: error", line);
+	}
+	else {
+		char *str = jsimplon_tree_to_str(NULL, tree);
+		snprintf(collector->last, sizeof collector->last, "%zu: %s", line, str);
+		free(str);
+		jsimplon_tree_destroy(tree);
+	}
+
+	if (collector->records_count == collector->stop_at)
+		return 7;
+
+	return JSIMPLON_SUCCESS;
+}
+
+static Collector ndjson_parse(int *status, const char *src, size_t src_len, uint32_t thread_count, Jsimplon_Engine engine, size_t stop_at)
+{
+	Collector collector = { .is_in_order = true, .stop_at = stop_at };
+	Jsimplon_Options options = { .thread_count = thread_count, .engine = engine };
+	char *error;
+
+	*status = jsimplon_ndjson_parse(&error, src, src_len, collect, &collector, &options);
+
+	// Only failed records make a message, a stop is the callback's own doing
+	CHECK((*status == JSIMPLON_FAILURE) == (error != NULL));
+	free(error);
+
+	return collector;
+}
+
+int main(void)
+{
+	// Scalars are records as well, blank lines are skipped, the last line has no newline
+	const char *small = "3\n\"x\"\n\n  true \r\nnull\n-1.5e2\n{\"a\":[1]}\n[1,2]\n\n{\"last\":\"\\u00e9\"}";
+	int status;
+
+	for (uint32_t thread_count = 1; thread_count <= 4; thread_count *= 2) {
+		for (int engine = JSIMPLON_ENGINE_TOKENS; engine <= JSIMPLON_ENGINE_STRUCTURAL; ++engine) {
+			Collector collector = ndjson_parse(&status, small, strlen(small), thread_count, engine, 0);
+
+			CHECK(status == JSIMPLON_SUCCESS);
+			CHECK(collector.records_count == 8 && collector.failed_count == 0 && collector.is_in_order);
+			CHECK(strcmp(collector.last, "10: {\"last\":\"\xC3\xA9\"}") == 0);
+		}
+	}
+
+	// Broken records come back as errors in their place and the whole parse fails
+	const char *broken = "[1]\n3 4\n\"unterminated\n{\"a\" 1}\n@\n[2]\n";
+	Collector collector = ndjson_parse(&status, broken, strlen(broken), 2, JSIMPLON_ENGINE_TOKENS, 0);
+	CHECK(status == JSIMPLON_FAILURE);
+	CHECK(collector.records_count == 6 && collector.failed_count == 4 && collector.is_in_order);
+	CHECK(strcmp(collector.last, "6: [2]") == 0);
+
+	// Thousands of records over many blocks, one broken in every hundred
+	size_t records_count = 5000;
+	char *src = malloc(records_count * 32);
+	size_t src_len = 0;
+
+	for (size_t i = 0; i < records_count; ++i) {
+		if (i % 100 == 99)
+			src_len += (size_t)sprintf(&src[src_len], "{\"id\": %zu,}\n", i);
+		else if (i % 2 == 0)
+			src_len += (size_t)sprintf(&src[src_len], "{\"id\": %zu}\n", i);
+		else
+			src_len += (size_t)sprintf(&src[src_len], "%zu\n", i);
+	}
+
+	for (uint32_t thread_count = 1; thread_count <= 8; thread_count *= 2) {
+		collector = ndjson_parse(&status, src, src_len, thread_count, JSIMPLON_ENGINE_TOKENS, 0);
+
+		CHECK(status == JSIMPLON_FAILURE);
+		CHECK(collector.records_count == records_count && collector.failed_count == records_count / 100);
+		CHECK(collector.is_in_order);
+		CHECK(strcmp(collector.last, "5000: error") == 0);
+
+		// Stopping hands out nothing more and returns the callback's status
+		collector = ndjson_parse(&status, src, src_len, thread_count, JSIMPLON_ENGINE_TOKENS, 1234);
+
+		CHECK(status == 7);
+		CHECK(collector.records_count == 1234 && collector.is_in_order);
+		CHECK(strcmp(collector.last, "1234: 1233") == 0);
+	}
+
+	free(src);
+
+	// Nothing but blank lines
+	collector = ndjson_parse(&status, "\n\n  \n", 5, 2, JSIMPLON_ENGINE_TOKENS, 0);
+	CHECK(status == JSIMPLON_SUCCESS && collector.records_count == 0);
+
+	return TEST_RESULT();
+}
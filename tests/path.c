@@ -0,0 +1,151 @@
+#define JSIMPLON_IMPLEMENTATION
+#include "jsimplon.h"
+#include "test.h"
+
+static const char *document =
+	"{"
+		"\"meta\": {\"region\": [{\"id\": 7}, {\"id\": 8, \"tags\": [\"a\", \"b\"]}], \"name\": \"jsimplon\"},"
+		"\"a/b\": 1, \"m~n\": 2, \"~01\": 3, \"\": 4, \"0\": 5, \"01\": 6, \"-\": 7,"
+		"\"list\": [10, 11, 12]"
+	"}";
+
+// What a path resolves to, as JSON, or "" if nothing is there
+static char resolved[256];
+
+static const char *resolve(Jsimplon_Value *root, const char *pointer)
+{
+	Jsimplon_Path *path = jsimplon_path_compile(NULL, pointer);
+	CHECK(path != NULL);
+
+	Jsimplon_Value *value = jsimplon_path_get(root, path);
+	jsimplon_path_destroy(path);
+
+	resolved[0] = '\0';
+
+	if (value != NULL) {
+		char *str = jsimplon_tree_to_str(NULL, value);
+		snprintf(resolved, sizeof resolved, "%s", str);
+		free(str);
+	}
+
+	return resolved;
+}
+
+static void check_paths(Jsimplon_Value *root)
+{
+	CHECK(strcmp(resolve(root, "/meta/region/0/id"), "7") == 0);
+	CHECK(strcmp(resolve(root, "/meta/region/1/tags/1"), "\"b\"") == 0);
+	CHECK(strcmp(resolve(root, "/meta/name"), "\"jsimplon\"") == 0);
+	CHECK(strcmp(resolve(root, "/list/2"), "12") == 0);
+
+	// RFC 6901 escapes and the odd keys
+	CHECK(strcmp(resolve(root, "/a~1b"), "1") == 0);
+	CHECK(strcmp(resolve(root, "/m~0n"), "2") == 0);
+	CHECK(strcmp(resolve(root, "/~001"), "3") == 0);
+	CHECK(strcmp(resolve(root, "/"), "4") == 0);
+	CHECK(strcmp(resolve(root, "/0"), "5") == 0);
+	CHECK(strcmp(resolve(root, "/01"), "6") == 0);
+	CHECK(strcmp(resolve(root, "/-"), "7") == 0);
+
+	// Nothing there
+	CHECK(strcmp(resolve(root, "/list/3"), "") == 0);
+	CHECK(strcmp(resolve(root, "/list/-"), "") == 0);
+	CHECK(strcmp(resolve(root, "/list/01"), "") == 0);
+	CHECK(strcmp(resolve(root, "/list/x"), "") == 0);
+	CHECK(strcmp(resolve(root, "/list/18446744073709551616"), "") == 0);
+	CHECK(strcmp(resolve(root, "/meta/name/0"), "") == 0);
+	CHECK(strcmp(resolve(root, "/missing"), "") == 0);
+	CHECK(strcmp(resolve(root, "/meta/region/1/tags/1/deeper"), "") == 0);
+
+	// "" is the root itself
+	Jsimplon_Path *path = jsimplon_path_compile(NULL, "");
+	CHECK(jsimplon_path_get(root, path) == root);
+	jsimplon_path_destroy(path);
+
+	// One walk for all of them, the same answers as one at a time
+	const char *pointers[] = {
+		"/meta/region/1/tags/0", "/list/0", "/meta/region/0/id", "/meta/missing", "",
+		"/meta/region/1/tags/1", "/meta/region/1/id", "/list/9", "/meta/region/1/tags/0", "/a~1b"
+	};
+	size_t paths_count = sizeof pointers / sizeof *pointers;
+
+	Jsimplon_Path *paths[sizeof pointers / sizeof *pointers];
+	Jsimplon_Value *values[sizeof pointers / sizeof *pointers];
+	size_t found_count = 0;
+
+	for (size_t i = 0; i < paths_count; ++i)
+		paths[i] = jsimplon_path_compile(NULL, pointers[i]);
+
+	CHECK(jsimplon_path_get_many(root, (const Jsimplon_Path *const *)paths, paths_count, values) == 8);
+
+	for (size_t i = 0; i < paths_count; ++i) {
+		CHECK(values[i] == jsimplon_path_get(root, paths[i]));
+		found_count += values[i] != NULL;
+		jsimplon_path_destroy(paths[i]);
+	}
+
+	CHECK(found_count == 8);
+}
+
+int main(void)
+{
+	Jsimplon_Options options[] = {
+		{ 0 },
+		{ .engine = JSIMPLON_ENGINE_STRUCTURAL },
+		{ .use_arena = true, .intern_strings = true },
+		{ .lazy = true }
+	};
+
+	for (size_t i = 0; i < sizeof options / sizeof *options; ++i) {
+		Jsimplon_Value *root = jsimplon_tree_from_str_ex(NULL, document, strlen(document), &options[i]);
+		CHECK(root != NULL);
+		check_paths(root);
+		jsimplon_tree_destroy(root);
+	}
+
+	// Big enough for the object's hash index, a compiled path is reused on every tree
+	Jsimplon_Path *path = jsimplon_path_compile(NULL, "/key_777/1");
+
+	for (int round = 0; round < 3; ++round) {
+		Jsimplon_Value *root = jsimplon_tree_root_create();
+		Jsimplon_Object *object = jsimplon_value_set_object(root);
+
+		for (int i = 0; i < 1000; ++i) {
+			char key[16];
+			snprintf(key, sizeof key, "key_%d", i);
+
+			Jsimplon_Array *array = jsimplon_object_add_member_array(object, key);
+			jsimplon_array_push_int64(array, i);
+			jsimplon_array_push_int64(array, i * round);
+		}
+
+		CHECK(jsimplon_value_get_int64(jsimplon_path_get(root, path)) == 777 * round);
+		jsimplon_tree_destroy(root);
+	}
+
+	jsimplon_path_destroy(path);
+
+	// Malformed pointers
+	char *error;
+	CHECK(jsimplon_path_compile(&error, "meta") == NULL);
+	CHECK(error != NULL && strstr(error, "expected '/'") != NULL);
+	free(error);
+	CHECK(jsimplon_path_compile(&error, "/a~2") == NULL);
+	CHECK(error != NULL && strstr(error, "got '2'") != NULL);
+	free(error);
+	CHECK(jsimplon_path_compile(&error, "/a~") == NULL);
+	CHECK(error != NULL && strstr(error, "the end of the path") != NULL);
+	free(error);
+
+	CHECK(jsimplon_path_compile(&error, NULL) == NULL);
+	CHECK(error != NULL && strstr(error, "path error") != NULL);
+	free(error);
+	CHECK(jsimplon_path_compile(NULL, NULL) == NULL);
+
+	path = jsimplon_path_compile(&error, "/ok");
+	CHECK(path != NULL);
+	free(error);
+	jsimplon_path_destroy(path);
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,136 @@
+#define JSIMPLON_IMPLEMENTATION
+#include "jsimplon.h"
+#include "test.h"
+
+static void check_array(const Jsimplon_Options *options)
+{
+	Jsimplon_Value *root = jsimplon_tree_root_create_ex(options);
+	Jsimplon_Array *array = jsimplon_value_set_array(root);
+
+	// Nothing moves while the reserved room lasts
+	CHECK(jsimplon_array_reserve(array, 1000) == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_array_push_int64(array, 0) == JSIMPLON_SUCCESS);
+	Jsimplon_Value *first = jsimplon_array_get_value_at_index(array, 0);
+
+	for (int64_t i = 1; i < 1000; ++i)
+		jsimplon_array_push_int64(array, i);
+
+	CHECK(jsimplon_array_get_value_at_index(array, 0) == first);
+
+	// Reserving less than there's room for changes nothing
+	CHECK(jsimplon_array_reserve(array, 10) == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_array_get_value_at_index(array, 0) == first);
+	CHECK(jsimplon_array_get_count(array) == 1000);
+
+	// Removing the last one, one in the middle, and strings, which ASan checks are freed
+	CHECK(jsimplon_array_remove_value_at_index(array, 999) == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_array_remove_value_at_index(array, 500) == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_array_remove_value_at_index(array, 998) == JSIMPLON_FAILURE);
+	CHECK(jsimplon_array_get_count(array) == 998);
+	CHECK(jsimplon_value_get_int64(jsimplon_array_get_value_at_index(array, 500)) == 501);
+	CHECK(jsimplon_value_get_int64(jsimplon_array_get_value_at_index(array, 997)) == 998);
+
+	jsimplon_array_push_str(array, "a string long enough to be stored out of line");
+	CHECK(jsimplon_array_remove_value_at_index(array, 998) == JSIMPLON_SUCCESS);
+
+	// Shrinking keeps every value
+	CHECK(jsimplon_array_shrink_to_fit(array) == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_array_get_count(array) == 998);
+	CHECK(jsimplon_value_get_int64(jsimplon_array_get_value_at_index(array, 997)) == 998);
+	CHECK(jsimplon_array_push_int64(array, 1000) == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_value_get_int64(jsimplon_array_get_value_at_index(array, 998)) == 1000);
+
+	// Down to nothing and past it
+	while (jsimplon_array_get_count(array) > 0)
+		CHECK(jsimplon_array_remove_value_at_index(array, 0) == JSIMPLON_SUCCESS);
+
+	CHECK(jsimplon_array_remove_value_at_index(array, 0) == JSIMPLON_FAILURE);
+	CHECK(jsimplon_array_shrink_to_fit(array) == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_array_push_null(array) == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_array_get_count(array) == 1);
+
+	jsimplon_tree_destroy(root);
+}
+
+static void check_object(const Jsimplon_Options *options)
+{
+	Jsimplon_Value *root = jsimplon_tree_root_create_ex(options);
+	Jsimplon_Object *object = jsimplon_value_set_object(root);
+	char key[16];
+
+	CHECK(jsimplon_object_reserve(object, 500) == JSIMPLON_SUCCESS);
+	jsimplon_object_add_member_int64(object, "key_0", 0);
+	Jsimplon_Member *first = jsimplon_object_get_member_at_index(object, 0);
+
+	// Enough members for the object to get a hash index
+	for (int i = 1; i < 500; ++i) {
+		snprintf(key, sizeof key, "key_%d", i);
+		jsimplon_object_add_member_int64(object, key, i);
+	}
+
+	CHECK(jsimplon_object_get_member_at_index(object, 0) == first);
+	CHECK(jsimplon_object_member_get_int64(object, "key_321") == 321);
+
+	// Lookups keep working as members are removed and the members array shrinks under the index
+	for (int i = 0; i < 500; i += 2) {
+		snprintf(key, sizeof key, "key_%d", i);
+		CHECK(jsimplon_object_remove_member(object, key) == JSIMPLON_SUCCESS);
+	}
+
+	CHECK(jsimplon_object_remove_member(object, "key_0") == JSIMPLON_FAILURE);
+	CHECK(jsimplon_object_shrink_to_fit(object) == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_object_get_member_count(object) == 250);
+	CHECK(jsimplon_object_get_member(object, "key_320") == NULL);
+	CHECK(jsimplon_object_member_get_int64(object, "key_321") == 321);
+	CHECK(jsimplon_object_member_get_int64(object, "key_499") == 499);
+
+	CHECK(jsimplon_object_add_member_int64(object, "key_320", -320) == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_object_member_get_int64(object, "key_320") == -320);
+
+	jsimplon_tree_destroy(root);
+}
+
+int main(void)
+{
+	Jsimplon_Options options[] = {
+		{ 0 },
+		{ .use_arena = true },
+		{ .use_arena = true, .intern_strings = true }
+	};
+
+	for (size_t i = 0; i < sizeof options / sizeof *options; ++i) {
+		check_array(&options[i]);
+		check_object(&options[i]);
+	}
+
+	// Containers a lazy tree hasn't looked into yet are parsed first
+	const char *src = "{\"list\": [1, 2, 3], \"object\": {\"a\": 1}}";
+	Jsimplon_Options lazy = { .lazy = true };
+	Jsimplon_Value *root = jsimplon_tree_from_str_ex(NULL, src, strlen(src), &lazy);
+	Jsimplon_Object *object = jsimplon_value_get_object(root);
+
+	Jsimplon_Array *list = jsimplon_object_member_get_array(object, "list");
+	CHECK(jsimplon_array_reserve(list, 64) == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_array_get_count(list) == 3);
+	CHECK(jsimplon_array_shrink_to_fit(list) == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_value_get_int64(jsimplon_array_get_value_at_index(list, 2)) == 3);
+
+	Jsimplon_Object *inner = jsimplon_object_member_get_object(object, "object");
+	CHECK(jsimplon_object_reserve(inner, 64) == JSIMPLON_SUCCESS);
+	CHECK(jsimplon_object_member_get_int64(inner, "a") == 1);
+
+	jsimplon_tree_destroy(root);
+
+	// Bad arguments
+	CHECK(jsimplon_array_reserve(NULL, 1) == JSIMPLON_FAILURE);
+	CHECK(jsimplon_array_shrink_to_fit(NULL) == JSIMPLON_FAILURE);
+	CHECK(jsimplon_object_reserve(NULL, 1) == JSIMPLON_FAILURE);
+	CHECK(jsimplon_object_shrink_to_fit(NULL) == JSIMPLON_FAILURE);
+	CHECK(jsimplon_array_remove_value_at_index(NULL, 0) == JSIMPLON_FAILURE);
+
+	root = jsimplon_tree_root_create();
+	CHECK(jsimplon_array_reserve(jsimplon_value_set_array(root), (size_t)UINT32_MAX + 1) == JSIMPLON_FAILURE);
+	jsimplon_tree_destroy(root);
+
+	return TEST_RESULT();
+}
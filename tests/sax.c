@@ -0,0 +1,172 @@
+#define JSIMPLON_IMPLEMENTATION
+#include "jsimplon.h"
+#include "test.h"
+
+// Writes every event into a string so whole runs can be compared at once
+typedef struct {
+	char events[1024];
+	size_t events_count;
+	size_t stop_after;
+} Recorder;
+
+static int record(Recorder *recorder, const char *fmt, const char *str, size_t length)
+{
+	recorder->events_count += (size_t)snprintf(
+		&recorder->events[recorder->events_count], sizeof recorder->events - recorder->events_count,
+		fmt, (int)length, str
+	);
+
+	if (recorder->stop_after > 0 && --recorder->stop_after == 0)
+		return 42;
+
+	return JSIMPLON_SUCCESS;
+}
+
+static int on_object_begin(void *context) { return record(context, "{%.*s", "", 0); }
+static int on_object_end(void *context)   { return record(context, "}%.*s", "", 0); }
+static int on_array_begin(void *context)  { return record(context, "[%.*s", "", 0); }
+static int on_array_end(void *context)    { return record(context, "]%.*s", "", 0); }
+static int on_null(void *context)         { return record(context, "null%.*s ", "", 0); }
+
+static int on_key(void *context, const char *key, size_t length)
+{
+	return record(context, "key(%.*s) ", key, length);
+}
+
+static int on_string(void *context, const char *str, size_t length)
+{
+	return record(context, "str(%.*s) ", str, length);
+}
+
+static int on_number(void *context, const char *literal, size_t length)
+{
+	return record(context, "num(%.*s) ", literal, length);
+}
+
+static int on_bool(void *context, bool bool_value)
+{
+	return record(context, bool_value ? "true%.*s " : "false%.*s ", "", 0);
+}
+
+static const Jsimplon_SaxHandler handler = {
+	.object_begin = on_object_begin,
+	.object_end   = on_object_end,
+	.array_begin  = on_array_begin,
+	.array_end    = on_array_end,
+	.key          = on_key,
+	.string       = on_string,
+	.number       = on_number,
+	.bool_value   = on_bool,
+	.null_value   = on_null
+};
+
+static int sax_parse(char **error, const char *src, Recorder *recorder, const Jsimplon_Options *options)
+{
+	return jsimplon_sax_parse(error, src, strlen(src), &handler, recorder, options);
+}
+
+// Decodes strings and sums numbers, for the slice helpers
+typedef struct {
+	char decoded[64];
+	double sum;
+} Decoder;
+
+static int decode_string(void *context, const char *str, size_t length)
+{
+	Decoder *decoder = context;
+	size_t decoded_length;
+
+	if (length >= sizeof decoder->decoded
+		|| jsimplon_string_from_slice(str, length, decoder->decoded, &decoded_length) != JSIMPLON_SUCCESS)
+		return JSIMPLON_FAILURE;
+
+	return decoded_length == strlen(decoder->decoded) ? JSIMPLON_SUCCESS : JSIMPLON_FAILURE;
+}
+
+static int sum_number(void *context, const char *literal, size_t length)
+{
+	((Decoder *)context)->sum += jsimplon_number_from_slice(literal, length);
+
+	return JSIMPLON_SUCCESS;
+}
+
+int main(void)
+{
+	Recorder recorder = { 0 };
+	char *error;
+
+	// Every event in order, strings still escaped and numbers as written
+	CHECK(sax_parse(&error, "{\"a\\\"b\": [1.50, -2e3, true, false, null, \"x\\u0041\"], \"c\": {}}", &recorder, NULL) == JSIMPLON_SUCCESS);
+	CHECK(error == NULL || error[0] == '\0');
+	CHECK(strcmp(recorder.events, "{key(a\\\"b) [num(1.50) num(-2e3) true false null str(x\\u0041) ]key(c) {}}") == 0);
+	free(error);
+
+	// A callback's own status stops the parse and comes back as it is
+	recorder = (Recorder){ .stop_after = 3 };
+	CHECK(sax_parse(NULL, "[1, 2, 3, 4]", &recorder, NULL) == 42);
+	CHECK(strcmp(recorder.events, "[num(1) num(2) ") == 0);
+
+	// NULL callbacks are skipped
+	Jsimplon_SaxHandler numbers_only = { .number = on_number };
+	recorder = (Recorder){ 0 };
+	CHECK(jsimplon_sax_parse(NULL, "{\"a\": [1, \"b\", 2]}", 18, &numbers_only, &recorder, NULL) == JSIMPLON_SUCCESS);
+	CHECK(strcmp(recorder.events, "num(1) num(2) ") == 0);
+
+	// Broken documents fail with the tree parser's errors
+	const char *broken[] = { "[1, 2", "{\"a\" 1}", "[1,]", "[tru]", "3", "[1] 2", "[\"a\nb\"]", "[\"\\x\"]" };
+
+	for (size_t i = 0; i < sizeof broken / sizeof *broken; ++i) {
+		char *tree_error;
+		Jsimplon_Value *tree = jsimplon_tree_from_str(&tree_error, broken[i]);
+		CHECK(tree == NULL);
+
+		recorder = (Recorder){ 0 };
+		CHECK(sax_parse(&error, broken[i], &recorder, NULL) == JSIMPLON_FAILURE);
+		CHECK(error != NULL && tree_error != NULL && strcmp(error, tree_error) == 0);
+
+		free(error);
+		free(tree_error);
+	}
+
+	// max_depth holds without anything growing
+	Jsimplon_Options options = { .max_depth = 3 };
+	recorder = (Recorder){ 0 };
+	CHECK(sax_parse(NULL, "[[[1]]]", &recorder, &options) == JSIMPLON_SUCCESS);
+	recorder = (Recorder){ 0 };
+	CHECK(sax_parse(NULL, "[[[[1]]]]", &recorder, &options) == JSIMPLON_FAILURE);
+
+	options = (Jsimplon_Options){ .validate_utf8 = true };
+	recorder = (Recorder){ 0 };
+	CHECK(sax_parse(NULL, "[\"\xC3\x28\"]", &recorder, &options) == JSIMPLON_FAILURE);
+
+	// The slice helpers decode what the events hand out
+	Jsimplon_SaxHandler decoding = { .key = decode_string, .string = decode_string, .number = sum_number };
+	Decoder decoder = { 0 };
+	const char *src = "{\"k\\u00e9y\": [\"\\uD83D\\uDE00\", \"tab\\tbed\", 0.5, -1.25e1, 18446744073709551616]}";
+	CHECK(jsimplon_sax_parse(NULL, src, strlen(src), &decoding, &decoder, NULL) == JSIMPLON_SUCCESS);
+	CHECK(decoder.sum == 0.5 - 12.5 + 18446744073709551616.0);
+
+	char decoded[32];
+	size_t decoded_length;
+	CHECK(jsimplon_string_from_slice("a\\\"b\\\\c\\/\\n", 11, decoded, &decoded_length) == JSIMPLON_SUCCESS);
+	CHECK(decoded_length == 7 && strcmp(decoded, "a\"b\\c/\n") == 0);
+	CHECK(jsimplon_string_from_slice("\\u00e9\\uD83D\\uDE00", 18, decoded, &decoded_length) == JSIMPLON_SUCCESS);
+	CHECK(decoded_length == 6 && strcmp(decoded, "\xC3\xA9\xF0\x9F\x98\x80") == 0);
+	CHECK(jsimplon_string_from_slice("nul\\u0000in", 11, decoded, &decoded_length) == JSIMPLON_SUCCESS);
+	CHECK(decoded_length == 6 && memcmp(decoded, "nul\0in", 7) == 0);
+	CHECK(jsimplon_string_from_slice("", 0, decoded, &decoded_length) == JSIMPLON_SUCCESS && decoded_length == 0);
+	CHECK(jsimplon_string_from_slice("bad\\q", 5, decoded, NULL) == JSIMPLON_FAILURE);
+	CHECK(jsimplon_string_from_slice("cut\\", 4, decoded, NULL) == JSIMPLON_FAILURE);
+	CHECK(jsimplon_string_from_slice("\\u12", 4, decoded, NULL) == JSIMPLON_FAILURE);
+
+	// In place over the slice itself
+	char in_place[] = "x\\u0041y\\\\z";
+	CHECK(jsimplon_string_from_slice(in_place, strlen(in_place), in_place, &decoded_length) == JSIMPLON_SUCCESS);
+	CHECK(decoded_length == 5 && strcmp(in_place, "xAy\\z") == 0);
+
+	CHECK(jsimplon_number_from_slice("-0.0625", 7) == -0.0625);
+	CHECK(jsimplon_number_from_slice("1e400", 5) == INFINITY);
+	CHECK(jsimplon_number_from_slice("", 0) == INFINITY);
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,125 @@
+// Small chunks so that a few kilobytes are cut into many of them, at every kind of element
+#define JSIMPLON_SPLIT_CHUNK_SIZE 64
+#define JSIMPLON_IMPLEMENTATION
+#include "jsimplon.h"
+#include "test.h"
+
+static const char *elements[] = {
+	"1", "-2.5e-3", "18446744073709551615", "true", "null",
+	"\"plain\"", "\"a ] and a , and a [ in a string\"", "\"\\\"],[\\\"\"", "\"\\\\\\\\\"", "\"\\\\\\\"\"",
+	"\"\\u00e9\\uD83D\\uDE00\"", "\"a string long enough to be stored out of line\"",
+	"{\"a\": [1, {\"b\": \"]\"}], \"c,\": {}}", "[[], [[]], {}]", "{ }", "[\n\t1 ,\r\n 2 ]"
+};
+
+// An array of count elements, the same ones over and over, one of them swapped for broken when it's not NULL
+static char *make_array(size_t count, size_t broken_at, const char *broken)
+{
+	size_t elements_count = sizeof elements / sizeof *elements;
+	size_t src_size = 2;
+
+	for (size_t i = 0; i < count; ++i)
+		src_size += strlen(i == broken_at && broken != NULL ? broken : elements[i % elements_count]) + 3;
+
+	char *src = malloc(src_size + 1);
+	size_t src_len = 0;
+
+	src[src_len++] = '[';
+	for (size_t i = 0; i < count; ++i) {
+		src_len += (size_t)sprintf(
+			&src[src_len], "%s%s", i > 0 ? (i % 5 == 0 ? ",\n " : ", ") : "",
+			i == broken_at && broken != NULL ? broken : elements[i % elements_count]
+		);
+	}
+	src[src_len++] = ']';
+	src[src_len] = '\0';
+
+	return src;
+}
+
+static char *to_str(Jsimplon_Value *root)
+{
+	char *str = jsimplon_tree_to_str(NULL, root);
+	jsimplon_tree_destroy(root);
+
+	return str;
+}
+
+static void check_split(const char *src, const Jsimplon_Options *options)
+{
+	Jsimplon_Options split = *options;
+	split.split_root_array = true;
+
+	char *expected = to_str(jsimplon_tree_from_str_ex(NULL, src, strlen(src), options));
+	CHECK(expected != NULL);
+
+	for (split.thread_count = 2; split.thread_count <= 8; split.thread_count *= 2) {
+		// Called directly so that it can't quietly fall back to the single threaded parse
+		Jsimplon_Value *root = jsimplon_tree_parse_split(src, strlen(src), &split);
+		CHECK(root != NULL);
+
+		char *str = to_str(root);
+		CHECK(str != NULL && expected != NULL && strcmp(str, expected) == 0);
+		free(str);
+
+		str = to_str(jsimplon_tree_from_str_ex(NULL, src, strlen(src), &split));
+		CHECK(str != NULL && expected != NULL && strcmp(str, expected) == 0);
+		free(str);
+	}
+
+	free(expected);
+}
+
+// A broken document fails with the same error as when it's parsed on one thread
+static void check_broken(const char *src)
+{
+	char *expected;
+	CHECK(jsimplon_tree_from_str(&expected, src) == NULL);
+
+	for (uint32_t thread_count = 2; thread_count <= 8; thread_count *= 2) {
+		Jsimplon_Options options = { .split_root_array = true, .thread_count = thread_count };
+		char *error;
+
+		CHECK(jsimplon_tree_parse_split(src, strlen(src), &options) == NULL);
+		CHECK(jsimplon_tree_from_str_ex(&error, src, strlen(src), &options) == NULL);
+		CHECK(error != NULL && expected != NULL && error[0] != '\0' && strcmp(error, expected) == 0);
+		free(error);
+	}
+
+	free(expected);
+}
+
+int main(void)
+{
+	Jsimplon_Options options[] = {
+		{ 0 },
+		{ .use_arena = true },
+		{ .intern_strings = true },
+		{ .use_arena = true, .intern_strings = true }
+	};
+
+	for (size_t i = 0; i < sizeof options / sizeof *options; ++i) {
+		for (size_t count = 16; count <= 1000; count *= 4) {
+			char *src = make_array(count, 0, NULL);
+			check_split(src, &options[i]);
+			free(src);
+		}
+	}
+
+	// Errors in a chunk well after the first, and after the array
+	const char *broken[] = { "[1,]", "{\"a\" 1}", "\"unterminated", "tru", "\"\\x\"", "[1 2]", "{\"a\": [}", "\"a\tb\"" };
+
+	for (size_t i = 0; i < sizeof broken / sizeof *broken; ++i) {
+		char *src = make_array(400, 350, broken[i]);
+		check_broken(src);
+		free(src);
+	}
+
+	char *src = make_array(400, 0, NULL);
+	size_t src_len = strlen(src);
+	src = realloc(src, src_len + 3);
+	memcpy(&src[src_len], " 2", 3);
+	check_broken(src);
+	free(src);
+
+	return TEST_RESULT();
+}
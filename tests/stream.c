@@ -0,0 +1,123 @@
+#define JSIMPLON_IMPLEMENTATION
+#include "jsimplon.h"
+#include "test.h"
+
+static Jsimplon_Value *parse_in_chunks(char **error, const char *src, size_t src_len, size_t chunk_len)
+{
+	Jsimplon_StreamParser *stream = jsimplon_stream_parser_create(NULL);
+
+	for (size_t i = 0; i < src_len; i += chunk_len) {
+		size_t length = src_len - i < chunk_len ? src_len - i : chunk_len;
+
+		if (jsimplon_stream_parser_feed(NULL, stream, &src[i], length) != JSIMPLON_SUCCESS)
+			break;
+	}
+
+	return jsimplon_stream_parser_finish(error, stream);
+}
+
+// Every chunk size has to give what the one-shot parser gives, the tree or the error
+static void check_against_tree(const char *src)
+{
+	size_t src_len = strlen(src);
+
+	char *expected_error;
+	Jsimplon_Value *expected_tree = jsimplon_tree_from_str_ex(&expected_error, src, src_len, NULL);
+	char *expected = expected_tree != NULL ? jsimplon_tree_to_str(NULL, expected_tree) : NULL;
+
+	for (size_t chunk_len = 1; chunk_len <= src_len; ++chunk_len) {
+		char *error;
+		Jsimplon_Value *tree = parse_in_chunks(&error, src, src_len, chunk_len);
+
+		CHECK((tree != NULL) == (expected_tree != NULL));
+
+		if (tree != NULL && expected_tree != NULL) {
+			char *str = jsimplon_tree_to_str(NULL, tree);
+			CHECK(strcmp(str, expected) == 0);
+			free(str);
+		}
+
+		// The stream sums the errors up, the first one still has to say what went wrong and where
+		if (tree == NULL && expected_tree == NULL) {
+			size_t line_len = strcspn(expected_error, "\n");
+			CHECK(strncmp(error, expected_error, line_len) == 0);
+		}
+
+		jsimplon_tree_destroy(tree);
+		free(error);
+	}
+
+	jsimplon_tree_destroy(expected_tree);
+	free(expected);
+	free(expected_error);
+}
+
+int main(void)
+{
+	const char *documents[] = {
+		"{\"name\": \"jsimplon\", \"tags\": [\"c\", \"json\"], \"stars\": 1024, \"ratio\": -0.125e+2}",
+		"[true, false, null, 0, -0, 1.5, 18446744073709551615, -9223372036854775808]",
+		"[\"esc\\\\aped \\\" quote\", \"\\u00e9\\uD83D\\uDE00\", \"\\n\\t\\/\", \"\\\\\"]",
+		"\n\n  [ 1 ,\n\t{ \"a\" : [ ] , \"b\" : { } } ]  \n",
+		"[1, 2",
+		"[1, @\"abcdefghijklmnopqrstuvwxyz\"]",
+		"{\"a\": tru}",
+		"{\"a\" 1}",
+		"[\"unterminated]",
+		"[1] [2]",
+		"[\"bad \\q escape\"]",
+		"[01]",
+		"3"
+	};
+
+	for (size_t i = 0; i < sizeof documents / sizeof *documents; ++i)
+		check_against_tree(documents[i]);
+
+	// Nothing fed at all
+	char *error;
+	CHECK(jsimplon_stream_parser_finish(&error, jsimplon_stream_parser_create(NULL)) == NULL);
+	CHECK(error != NULL);
+	free(error);
+
+	// A failed stream keeps failing with the same message
+	Jsimplon_StreamParser *stream = jsimplon_stream_parser_create(NULL);
+	char *first_error;
+	CHECK(jsimplon_stream_parser_feed(&first_error, stream, "[1,,", 4) == JSIMPLON_FAILURE);
+	CHECK(jsimplon_stream_parser_feed(&error, stream, "2]", 2) == JSIMPLON_FAILURE);
+	CHECK(first_error != NULL && error != NULL && strcmp(first_error, error) == 0);
+	free(first_error);
+	free(error);
+	jsimplon_stream_parser_destroy(stream);
+
+	// Long tokens cut into many chunks, a backslash ends every other chunk
+	size_t long_len = 64 * 1024;
+	char *long_src = malloc(long_len + 1);
+	long_src[0] = '[';
+	long_src[1] = '\"';
+	for (size_t i = 2; i < long_len - 2; i += 2) {
+		long_src[i] = '\\';
+		long_src[i + 1] = 'n';
+	}
+	long_src[long_len - 2] = '\"';
+	long_src[long_len - 1] = ']';
+	long_src[long_len] = '\0';
+
+	Jsimplon_Value *tree = parse_in_chunks(NULL, long_src, long_len, 3);
+	CHECK(tree != NULL);
+	CHECK(jsimplon_value_get_str_len(jsimplon_array_get_value_at_index(jsimplon_value_get_array(tree), 0)) == (long_len - 4) / 2);
+	jsimplon_tree_destroy(tree);
+
+	long_src[1] = '1';
+	for (size_t i = 2; i < long_len - 1; ++i)
+		long_src[i] = '0';
+	long_src[long_len - 1] = ']';
+
+	tree = parse_in_chunks(NULL, long_src, long_len, 7);
+	CHECK(tree != NULL);
+	CHECK(jsimplon_value_get_type(jsimplon_array_get_value_at_index(jsimplon_value_get_array(tree), 0)) == JSIMPLON_VALUE_NUMBER);
+	jsimplon_tree_destroy(tree);
+
+	free(long_src);
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,127 @@
+#define JSIMPLON_IMPLEMENTATION
+#include "jsimplon.h"
+#include "test.h"
+
+// Parses with one engine and prints the tree back, or the error if there's none
+static char *parse(const char *src, Jsimplon_Engine engine, bool is_insitu)
+{
+	Jsimplon_Options options = { .engine = engine };
+	char *error;
+	Jsimplon_Value *root;
+
+	if (is_insitu) {
+		char *buf = malloc(strlen(src) + 1);
+		memcpy(buf, src, strlen(src) + 1);
+		root = jsimplon_tree_from_buffer_insitu_ex(&error, buf, strlen(buf), &options);
+
+		char *str = root != NULL ? jsimplon_tree_to_str(NULL, root) : error;
+		if (root != NULL)
+			free(error);
+
+		jsimplon_tree_destroy(root);
+		free(buf);
+
+		return str;
+	}
+
+	root = jsimplon_tree_from_str_ex(&error, src, strlen(src), &options);
+	if (root == NULL)
+		return error;
+
+	free(error);
+	char *str = jsimplon_tree_to_str(NULL, root);
+	jsimplon_tree_destroy(root);
+
+	return str;
+}
+
+// The engines word their errors differently, but the first one is at the same place
+static const char *first_error(char *str)
+{
+	const char *error = strstr(str, " error: ");
+	if (error == NULL)
+		return str;
+
+	error += strlen(" error: ");
+	*strchr(error, ' ') = '\0';
+
+	return error;
+}
+
+// Both engines agree, whether the document is fine or not
+static void check_same(const char *src)
+{
+	for (int is_insitu = 0; is_insitu <= 1; ++is_insitu) {
+		char *tokens = parse(src, JSIMPLON_ENGINE_TOKENS, is_insitu);
+		char *structural = parse(src, JSIMPLON_ENGINE_STRUCTURAL, is_insitu);
+
+		CHECK(tokens != NULL && structural != NULL && strcmp(first_error(tokens), first_error(structural)) == 0);
+
+		free(tokens);
+		free(structural);
+	}
+}
+
+// What's put at every offset around the block boundaries, each as a whole string or as a key
+static const char *pieces[] = {
+	"\"\"", "\"a\"", "\"\\\"\"", "\"\\\\\"", "\"\\\\\\\"\"", "\"\\\\\\\\\"", "\"\\\\\\\\\\\"x\"",
+	"\"\\u00e9\"", "\"\\uD83D\\uDE00\"", "\"\\/\\b\\f\\n\\r\\t\"", "\"[{,:}]\"", "\"\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\"",
+	"\"a long one with \\\"quotes\\\" and \\\\ backslashes that is well over a block long, all of it one string\"",
+	// Broken ones, the error has to come out the same
+	"\"\\\"", "\"\\x\"", "\"\\u12\"", "\"a", "\"\\\\\\\"", "\"a\tb\""
+};
+
+int main(void)
+{
+	char src[512];
+
+	// Every piece at every offset over two block boundaries, as an element and as a key, padded by whitespace or digits
+	for (size_t i = 0; i < sizeof pieces / sizeof *pieces; ++i) {
+		for (size_t offset = 0; offset < 140; ++offset) {
+			int pad = (int)offset;
+
+			snprintf(src, sizeof src, "[%*s%s, 1]", pad, "", pieces[i]);
+			check_same(src);
+
+			snprintf(src, sizeof src, "{%*s%s: %s}", pad, "", pieces[i], pieces[i]);
+			check_same(src);
+
+			snprintf(src, sizeof src, "[\"%.*s\", %s]", pad, "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx", pieces[i]);
+			check_same(src);
+		}
+	}
+
+	// Runs of backslashes of every length, ending on every side of a boundary
+	for (size_t run = 1; run < 140; ++run) {
+		for (size_t offset = 50; offset < 70; ++offset) {
+			size_t length = 0;
+
+			src[length++] = '[';
+			memset(&src[length], ' ', offset);
+			length += offset;
+			src[length++] = '\"';
+			memset(&src[length], '\\', run);
+			length += run;
+			memcpy(&src[length], "\", 1]", 6);
+
+			check_same(src);
+		}
+	}
+
+	// Many strings back to back, so that blocks start inside them as well as between them
+	char *many = malloc(64 * 1024);
+	size_t length = 0;
+
+	many[length++] = '[';
+	for (size_t i = 0; length < 60 * 1024; ++i) {
+		const char *piece = pieces[i % 13];
+		length += (size_t)sprintf(&many[length], "%s%s", i > 0 ? "," : "", piece);
+	}
+	many[length++] = ']';
+	many[length] = '\0';
+
+	check_same(many);
+	free(many);
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,19 @@
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdio.h>
+
+// Every test is its own program, it checks as much as it can and exits with 1 if anything failed
+static int test_failure_count = 0;
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			++test_failure_count; \
+		} \
+	} while (0)
+
+#define TEST_RESULT() (test_failure_count == 0 ? 0 : 1)
+
+#endif // TEST_H
@@ -0,0 +1,123 @@
+#define JSIMPLON_IMPLEMENTATION
+#include "jsimplon.h"
+#include "test.h"
+
+// Well-formed or not, each one character
+static const char *valid[] = {
+	"\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF", "\xEE\x80\x80", "\xEF\xBF\xBF",
+	"\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80"
+};
+
+static const char *invalid[] = {
+	// Overlong forms
+	"\xC0\x80", "\xC1\xBF", "\xE0\x80\x80", "\xE0\x9F\xBF", "\xF0\x80\x80\x80", "\xF0\x8F\xBF\xBF",
+	// Surrogates
+	"\xED\xA0\x80", "\xED\xBF\xBF",
+	// Above U+10FFFF, and leads that can't start anything
+	"\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xF8\x88\x80\x80\x80", "\xFF", "\xFE",
+	// Continuations on their own, or one too many
+	"\x80", "\xBF", "\xC3\xA9\xA9",
+	// Cut short, by the end of the string or by ASCII
+	"\xC3", "\xE2\x82", "\xF0\x9F\x98", "\xE2" "a" "\xAC", "\xF0\x9F" "aa"
+};
+
+// The string as a document's only one, parsed with validation on
+static bool parses(const char *str, Jsimplon_Engine engine)
+{
+	char src[256];
+	snprintf(src, sizeof src, "[\"%s\"]", str);
+
+	Jsimplon_Options options = { .validate_utf8 = true, .engine = engine };
+	char *error;
+	Jsimplon_Value *root = jsimplon_tree_from_str_ex(&error, src, strlen(src), &options);
+
+	bool has_parsed = root != NULL;
+	if (!has_parsed)
+		CHECK(error != NULL && strstr(error, "not valid UTF-8") != NULL);
+
+	free(error);
+	jsimplon_tree_destroy(root);
+
+	return has_parsed;
+}
+
+// The character at every offset over two 32 byte blocks, counted from a character that isn't ASCII at the start
+static void check_everywhere(const char *character, bool is_valid)
+{
+	char str[160];
+
+	for (size_t offset = 0; offset < 80; ++offset) {
+		for (int has_lead = 0; has_lead <= 1; ++has_lead) {
+			size_t length = 0;
+
+			if (has_lead) {
+				memcpy(str, "\xC3\xA9", 2);
+				length = 2;
+			}
+
+			memset(&str[length], 'a', offset);
+			length += offset;
+			length += (size_t)sprintf(&str[length], "%s", character);
+
+			// At the very end, and with more after it
+			CHECK(jsimplon_utf8_validate(str, length) == is_valid);
+
+			memcpy(&str[length], "bb\xE2\x82\xAC", 6);
+			CHECK(jsimplon_utf8_validate(str, length + 5) == is_valid);
+		}
+	}
+}
+
+int main(void)
+{
+	for (size_t i = 0; i < sizeof valid / sizeof *valid; ++i) {
+		check_everywhere(valid[i], true);
+
+		for (int engine = JSIMPLON_ENGINE_TOKENS; engine <= JSIMPLON_ENGINE_STRUCTURAL; ++engine)
+			CHECK(parses(valid[i], engine));
+	}
+
+	for (size_t i = 0; i < sizeof invalid / sizeof *invalid; ++i) {
+		check_everywhere(invalid[i], false);
+
+		for (int engine = JSIMPLON_ENGINE_TOKENS; engine <= JSIMPLON_ENGINE_STRUCTURAL; ++engine)
+			CHECK(!parses(invalid[i], engine));
+	}
+
+	// Every valid character back to back, so that blocks start and end in the middle of them
+	char str[1024];
+	size_t length = 0;
+
+	while (length < sizeof str - 8) {
+		for (size_t i = 0; i < sizeof valid / sizeof *valid && length < sizeof str - 8; ++i) {
+			memcpy(&str[length], valid[i], strlen(valid[i]));
+			length += strlen(valid[i]);
+		}
+	}
+
+	CHECK(jsimplon_utf8_validate(str, length));
+
+	// And each one cut short wherever it ends up, the rest of the string is fine
+	for (size_t end = 1; end < 200; ++end) {
+		bool is_whole = ((uint8_t)str[end] & 0xC0) != 0x80;
+		CHECK(jsimplon_utf8_validate(str, end) == is_whole);
+	}
+
+	// Without validation the bytes are taken as they are
+	const char *src = "[\"\xC0\x80\xED\xA0\x80\xFF\"]";
+	Jsimplon_Value *root = jsimplon_tree_from_str(NULL, src);
+	CHECK(root != NULL);
+	CHECK(jsimplon_value_get_str_len(jsimplon_array_get_value_at_index(jsimplon_value_get_array(root), 0)) == 6);
+	jsimplon_tree_destroy(root);
+
+	// Keys are checked as well as strings
+	Jsimplon_Options options = { .validate_utf8 = true };
+	src = "{\"\xED\xA0\x80\": 1}";
+	CHECK(jsimplon_tree_from_str_ex(NULL, src, strlen(src), &options) == NULL);
+	src = "{\"\xC3\xA9\": 1}";
+	root = jsimplon_tree_from_str_ex(NULL, src, strlen(src), &options);
+	CHECK(jsimplon_object_member_get_int64(jsimplon_value_get_object(root), "\xC3\xA9") == 1);
+	jsimplon_tree_destroy(root);
+
+	return TEST_RESULT();
+}